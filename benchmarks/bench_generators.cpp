@@ -0,0 +1,64 @@
+#include <benchmark/benchmark.h>
+#include "serial_bus_generator/protocols/arinc429/arinc429_generator.hpp"
+#include "serial_bus_generator/protocols/canj1939/canj1939_generator.hpp"
+#include <chrono>
+
+using namespace serial_bus_generator;
+using namespace std::chrono_literals;
+
+namespace {
+
+constexpr uint64_t SEED = 1;  // Same simulation on every run
+
+// One 10 ms tick per iteration, through the IMessage path
+template <typename Generator>
+void BM_GenerateMessages(benchmark::State& state) {
+    Generator generator;
+    generator.setSeed(SEED);
+    size_t messages = 0;
+    for (auto _ : state) {
+        auto batch = generator.generateMessages(10ms);
+        messages += batch.size();
+        benchmark::DoNotOptimize(batch.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(messages));
+}
+BENCHMARK_TEMPLATE(BM_GenerateMessages, ARINC429Generator);
+BENCHMARK_TEMPLATE(BM_GenerateMessages, CANJ1939Generator);
+
+// The same ticks through the allocation-free frame path
+template <typename Generator>
+void BM_GenerateFrames(benchmark::State& state) {
+    Generator generator;
+    generator.setSeed(SEED);
+    FrameBatch batch;
+    size_t frames = 0;
+    for (auto _ : state) {
+        batch.clear();
+        generator.generateFrames(10ms, batch);
+        frames += batch.size();
+        benchmark::DoNotOptimize(batch.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(frames));
+}
+BENCHMARK_TEMPLATE(BM_GenerateFrames, ARINC429Generator);
+BENCHMARK_TEMPLATE(BM_GenerateFrames, CANJ1939Generator);
+
+// 50 ms fleet ticks; the argument is the number of aircraft
+void BM_ARINC429FleetGenerateFrames(benchmark::State& state) {
+    ARINC429Generator generator;
+    generator.setSeed(SEED);
+    generator.setFleetSize(static_cast<size_t>(state.range(0)));
+    FrameBatch batch;
+    size_t frames = 0;
+    for (auto _ : state) {
+        batch.clear();
+        generator.generateFrames(50ms, batch);
+        frames += batch.size();
+        benchmark::DoNotOptimize(batch.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(frames));
+}
+BENCHMARK(BM_ARINC429FleetGenerateFrames)->Arg(100)->Arg(1000)->Arg(10000)->ArgName("aircraft");
+
+} // namespace
@@ -0,0 +1,232 @@
+#include <benchmark/benchmark.h>
+#include "serial_bus_generator/protocols/arinc429/arinc429_codec.hpp"
+#include "serial_bus_generator/protocols/arinc429/arinc429_message.hpp"
+#include "serial_bus_generator/protocols/canj1939/canj1939_message.hpp"
+#include <vector>
+
+using namespace serial_bus_generator;
+
+namespace {
+
+constexpr size_t BATCH_WORDS = 1024;
+
+// Alternating labels and changing values so no result can be hoisted out of the loop
+const ARINC429Label LABELS[] = {ARINC429Label::LATITUDE, ARINC429Label::ALTITUDE,
+                                ARINC429Label::GROUND_SPEED, ARINC429Label::EQUIPMENT_STATUS};
+
+float nextValue(size_t i) {
+    return static_cast<float>(i % 4096) * 0.5f;
+}
+
+void BM_ARINC429Construct(benchmark::State& state) {
+    size_t i = 0;
+    for (auto _ : state) {
+        ARINC429Message message(LABELS[i & 3], nextValue(i), ARINC429SSM::NORMAL_OPERATION);
+        benchmark::DoNotOptimize(message);
+        ++i;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ARINC429Construct);
+
+void BM_ARINC429Serialize(benchmark::State& state) {
+    const ARINC429Message message(ARINC429Label::ALTITUDE, 35000.0f, ARINC429SSM::NORMAL_OPERATION);
+    for (auto _ : state) {
+        std::vector<uint8_t> bytes = message.serialize();
+        benchmark::DoNotOptimize(bytes.data());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ARINC429Serialize);
+
+void BM_ARINC429SerializeInto(benchmark::State& state) {
+    const ARINC429Message message(ARINC429Label::ALTITUDE, 35000.0f, ARINC429SSM::NORMAL_OPERATION);
+    uint8_t bytes[64];
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(message.serializeInto(bytes, sizeof(bytes)));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ARINC429SerializeInto);
+
+void BM_ARINC429ToString(benchmark::State& state) {
+    const ARINC429Message message(ARINC429Label::LATITUDE, 47.6062f, ARINC429SSM::NORMAL_OPERATION);
+    for (auto _ : state) {
+        std::string text = message.toString();
+        benchmark::DoNotOptimize(text.data());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ARINC429ToString);
+
+void BM_ARINC429Decode(benchmark::State& state) {
+    std::vector<Frame> frames;
+    for (size_t i = 0; i < BATCH_WORDS; ++i) {
+        frames.push_back(ARINC429Message::encodeFrame(LABELS[i & 3], nextValue(i),
+                                                      ARINC429SSM::NORMAL_OPERATION, 0));
+    }
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(ARINC429Message(frames[i++ % BATCH_WORDS]).getDecodedValue());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ARINC429Decode);
+
+void BM_ARINC429Parity(benchmark::State& state) {
+    std::vector<ARINC429Message> messages;
+    for (size_t i = 0; i < BATCH_WORDS; ++i) {
+        messages.emplace_back(LABELS[i & 3], nextValue(i), ARINC429SSM::NORMAL_OPERATION);
+    }
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(messages[i++ % BATCH_WORDS].verifyParity());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ARINC429Parity);
+
+// Batch codec kernels; the argument is an ARINC429BatchCodec::Kernel
+class BatchCodecFixture : public benchmark::Fixture {
+public:
+    void SetUp(const benchmark::State& state) override {
+        kernel = static_cast<ARINC429BatchCodec::Kernel>(state.range(0));
+        labels.resize(BATCH_WORDS);
+        values.resize(BATCH_WORDS);
+        ssms.assign(BATCH_WORDS, ARINC429SSM::NORMAL_OPERATION);
+        words.resize(BATCH_WORDS);
+        valid.resize(BATCH_WORDS);
+        for (size_t i = 0; i < BATCH_WORDS; ++i) {
+            labels[i] = LABELS[i & 3];
+            values[i] = nextValue(i);
+            words[i] = ARINC429Message::encodeWord(labels[i], values[i], ssms[i]);
+        }
+    }
+
+    ARINC429BatchCodec::Kernel kernel{ARINC429BatchCodec::Kernel::SCALAR};
+    std::vector<ARINC429Label> labels;
+    std::vector<float> values;
+    std::vector<ARINC429SSM> ssms;
+    std::vector<uint32_t> words;
+    std::vector<uint8_t> valid;
+};
+
+BENCHMARK_DEFINE_F(BatchCodecFixture, Encode)(benchmark::State& state) {
+    if (!ARINC429BatchCodec::isSupported(kernel)) {
+        state.SkipWithError("Kernel not supported on this CPU");
+        return;
+    }
+    const ARINC429BatchCodec codec(kernel);
+    for (auto _ : state) {
+        codec.encode(labels.data(), values.data(), ssms.data(), words.data(), BATCH_WORDS);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * BATCH_WORDS);
+}
+BENCHMARK_REGISTER_F(BatchCodecFixture, Encode)->DenseRange(0, 2)->ArgName("kernel");
+
+BENCHMARK_DEFINE_F(BatchCodecFixture, Decode)(benchmark::State& state) {
+    if (!ARINC429BatchCodec::isSupported(kernel)) {
+        state.SkipWithError("Kernel not supported on this CPU");
+        return;
+    }
+    const ARINC429BatchCodec codec(kernel);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(codec.decode(words.data(), values.data(), BATCH_WORDS));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * BATCH_WORDS);
+}
+BENCHMARK_REGISTER_F(BatchCodecFixture, Decode)->DenseRange(0, 2)->ArgName("kernel");
+
+BENCHMARK_DEFINE_F(BatchCodecFixture, Parity)(benchmark::State& state) {
+    if (!ARINC429BatchCodec::isSupported(kernel)) {
+        state.SkipWithError("Kernel not supported on this CPU");
+        return;
+    }
+    const ARINC429BatchCodec codec(kernel);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(codec.verifyParity(words.data(), valid.data(), BATCH_WORDS));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * BATCH_WORDS);
+}
+BENCHMARK_REGISTER_F(BatchCodecFixture, Parity)->DenseRange(0, 2)->ArgName("kernel");
+
+const CANJ1939PGN PGNS[] = {CANJ1939PGN::ENGINE_SPEED, CANJ1939PGN::ENGINE_TEMPERATURE,
+                            CANJ1939PGN::ENGINE_HOURS, CANJ1939PGN::ENGINE_SPEED};
+
+void BM_CANJ1939Construct(benchmark::State& state) {
+    size_t i = 0;
+    for (auto _ : state) {
+        CANJ1939Message message(PGNS[i & 3], nextValue(i), CANJ1939Priority::PRIORITY_3);
+        benchmark::DoNotOptimize(message);
+        ++i;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CANJ1939Construct);
+
+void BM_CANJ1939Serialize(benchmark::State& state) {
+    const CANJ1939Message message(CANJ1939PGN::ENGINE_SPEED, 1800.0f, CANJ1939Priority::PRIORITY_3);
+    for (auto _ : state) {
+        std::vector<uint8_t> bytes = message.serialize();
+        benchmark::DoNotOptimize(bytes.data());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CANJ1939Serialize);
+
+void BM_CANJ1939SerializeInto(benchmark::State& state) {
+    const CANJ1939Message message(CANJ1939PGN::ENGINE_SPEED, 1800.0f, CANJ1939Priority::PRIORITY_3);
+    uint8_t bytes[64];
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(message.serializeInto(bytes, sizeof(bytes)));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CANJ1939SerializeInto);
+
+void BM_CANJ1939ToString(benchmark::State& state) {
+    const CANJ1939Message message(CANJ1939PGN::ENGINE_TEMPERATURE, 90.0f, CANJ1939Priority::PRIORITY_3);
+    for (auto _ : state) {
+        std::string text = message.toString();
+        benchmark::DoNotOptimize(text.data());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CANJ1939ToString);
+
+void BM_CANJ1939Decode(benchmark::State& state) {
+    std::vector<Frame> frames;
+    for (size_t i = 0; i < BATCH_WORDS; ++i) {
+        frames.push_back(CANJ1939Message::encodeFrame(PGNS[i & 3], nextValue(i),
+                                                      CANJ1939Priority::PRIORITY_3, 0));
+    }
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(CANJ1939Message(frames[i++ % BATCH_WORDS]).getDecodedValue());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CANJ1939Decode);
+
+void BM_CANJ1939DecodeValue(benchmark::State& state) {
+    std::vector<Frame> frames;
+    for (size_t i = 0; i < BATCH_WORDS; ++i) {
+        frames.push_back(CANJ1939Message::encodeFrame(PGNS[i & 3], nextValue(i),
+                                                      CANJ1939Priority::PRIORITY_3, 0));
+    }
+    size_t i = 0;
+    for (auto _ : state) {
+        const Frame& frame = frames[i & (BATCH_WORDS - 1)];
+        benchmark::DoNotOptimize(CANJ1939Message::decodeValue(PGNS[i & 3], frame.data));
+        ++i;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CANJ1939DecodeValue);
+
+} // namespace
@@ -0,0 +1,56 @@
+#include <benchmark/benchmark.h>
+#include "serial_bus_generator/protocols/arinc429/arinc429_generator.hpp"
+#include "serial_bus_generator/protocols/canj1939/canj1939_generator.hpp"
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace serial_bus_generator;
+using namespace std::chrono_literals;
+
+namespace {
+
+/**
+ * @brief Messages per second through a whole DataGenerator
+ *
+ * A virtual-clock run covers ten simulated seconds as fast as possible: the
+ * generation thread ticks, publishes to the frame ring and the sinks, and
+ * this thread drains the ring as a consumer would. Wall time is measured,
+ * so items_per_second is the end-to-end rate. The argument is the tick rate.
+ */
+template <typename Generator>
+void BM_EndToEnd(benchmark::State& state) {
+    std::vector<Frame> frames(4096);
+    size_t total = 0;
+    for (auto _ : state) {
+        Generator generator;
+        generator.setSeed(1);
+        generator.setRate(static_cast<uint32_t>(state.range(0)));
+        generator.setClockMode(ClockMode::VIRTUAL);
+        generator.setVirtualDuration(10s);
+        generator.start();
+        for (;;) {
+            const size_t count = generator.drainFrames(frames.data(), frames.size());
+            total += count;
+            if (count == 0) {
+                if (generator.getState() != GeneratorState::RUNNING) {
+                    total += generator.drainFrames(frames.data(), frames.size());
+                    if (generator.getQueuedFrames() == 0) {
+                        break;
+                    }
+                }
+                std::this_thread::yield();
+            }
+        }
+        generator.stop();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(total));
+    state.counters["frames_per_run"] = benchmark::Counter(
+        static_cast<double>(total), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK_TEMPLATE(BM_EndToEnd, ARINC429Generator)->Arg(100)->Arg(1000)->ArgName("rate")
+    ->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_EndToEnd, CANJ1939Generator)->Arg(100)->Arg(1000)->ArgName("rate")
+    ->Unit(benchmark::kMillisecond)->UseRealTime();
+
+} // namespace
@@ -0,0 +1,33 @@
+#include <benchmark/benchmark.h>
+#include "serial_bus_generator/trace/tracer.hpp"
+
+using namespace serial_bus_generator;
+
+namespace {
+
+// One traced scope per iteration: two clock reads and one ring store
+void BM_TraceScope(benchmark::State& state) {
+    Tracer::setEnabled(state.range(0) != 0);
+    for (auto _ : state) {
+        TraceScope scope("bench", 0);
+        benchmark::ClobberMemory();
+    }
+    Tracer::setEnabled(false);
+    Tracer::clear();
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TraceScope)->Arg(0)->Arg(1)->ArgName("enabled");
+
+void BM_TraceInstant(benchmark::State& state) {
+    Tracer::setEnabled(true);
+    int64_t value = 0;
+    for (auto _ : state) {
+        Tracer::recordInstant("bench", 0, nullptr, value++);
+    }
+    Tracer::setEnabled(false);
+    Tracer::clear();
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TraceInstant);
+
+} // namespace
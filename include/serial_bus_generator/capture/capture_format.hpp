@@ -0,0 +1,60 @@
+#pragma once
+
+#include "serial_bus_generator/messages/frame.hpp"
+#include <cstdint>
+#include <type_traits>
+
+namespace serial_bus_generator {
+
+/*
+ * Capture file layout (little-endian, every section 8-byte aligned):
+ *
+ *   CaptureFileHeader
+ *   CaptureChannelInfo[channel_count]
+ *   blocks of Frame records, written back to back
+ *   CaptureBlockIndex[block_count]     (at index_offset)
+ *
+ * The header is rewritten when the writer closes; index_offset stays 0 in
+ * a file whose writer never finished.
+ */
+
+constexpr char CAPTURE_MAGIC[8] = {'S', 'B', 'G', 'C', 'A', 'P', '\r', '\n'};
+constexpr uint32_t CAPTURE_VERSION = 1;
+
+struct CaptureFileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t record_size;      // sizeof(Frame)
+    uint32_t channel_count;
+    uint32_t block_count;
+    uint64_t record_count;
+    uint64_t data_offset;      // First record block
+    uint64_t index_offset;     // Block index, 0 until the file is closed
+    uint64_t first_ns;         // Earliest record timestamp
+    uint64_t last_ns;          // Latest record timestamp
+};
+
+struct CaptureChannelInfo {
+    uint16_t channel;
+    MessageType type;
+    uint8_t reserved{0};
+    uint32_t rate_hz;
+    char name[24];
+};
+
+struct CaptureBlockIndex {
+    uint64_t offset;           // File offset of the block's first record
+    uint64_t min_ns;           // Earliest timestamp in the block
+    uint64_t max_ns;           // Latest timestamp in the block
+    uint64_t max_before_ns;    // Latest timestamp in this or any earlier block
+    uint64_t min_after_ns;     // Earliest timestamp in this or any later block
+    uint32_t record_count;
+    uint32_t reserved;
+};
+
+static_assert(sizeof(CaptureFileHeader) == 64, "Capture header layout changed");
+static_assert(sizeof(CaptureChannelInfo) == 32, "Capture channel layout changed");
+static_assert(sizeof(CaptureBlockIndex) == 48, "Capture index layout changed");
+static_assert(std::is_trivially_copyable<CaptureChannelInfo>::value, "Channel info is written raw");
+
+} // namespace serial_bus_generator
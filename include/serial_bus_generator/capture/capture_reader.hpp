@@ -0,0 +1,80 @@
+#pragma once
+
+#include "serial_bus_generator/capture/capture_format.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace serial_bus_generator {
+
+/**
+ * @brief Read-only, memory-mapped view of a capture file
+ *
+ * Records are read in place from the mapping. Time-range queries use the
+ * block index to find the first candidate block, so they touch only the
+ * blocks that can hold matching records.
+ */
+class CaptureReader {
+public:
+    explicit CaptureReader(const std::string& path);
+    ~CaptureReader();
+
+    CaptureReader(const CaptureReader&) = delete;
+    CaptureReader& operator=(const CaptureReader&) = delete;
+
+    const CaptureFileHeader& getHeader() const { return *header_; }
+    uint64_t getRecordCount() const { return header_->record_count; }
+    uint64_t getFirstTimestamp() const { return header_->first_ns; }
+    uint64_t getLastTimestamp() const { return header_->last_ns; }
+
+    size_t getChannelCount() const { return header_->channel_count; }
+    const CaptureChannelInfo& getChannel(size_t index) const { return channels_[index]; }
+
+    size_t getBlockCount() const { return header_->block_count; }
+    const CaptureBlockIndex& getBlock(size_t block) const { return index_[block]; }
+    const Frame* getBlockRecords(size_t block) const;
+
+    // Paging hints for a run of blocks: prefetch asks the kernel to read
+    // them ahead, release drops them from this process's resident set
+    void prefetchBlocks(size_t first, size_t count) const;
+    void releaseBlocks(size_t first, size_t count) const;
+
+    // First block that may hold a record at or after timestamp_ns;
+    // getBlockCount() if there is none
+    size_t findBlock(uint64_t timestamp_ns) const;
+
+    // Calls visit(const Frame&) for every record with begin_ns <= timestamp
+    // < end_ns, in file order. Returns the number of records visited.
+    template <typename Visitor>
+    size_t forEachInRange(uint64_t begin_ns, uint64_t end_ns, Visitor&& visit) const {
+        size_t visited = 0;
+        for (size_t block = findBlock(begin_ns); block < getBlockCount(); ++block) {
+            const CaptureBlockIndex& entry = index_[block];
+            if (entry.min_after_ns >= end_ns) {
+                break;  // Nothing from here on is early enough
+            }
+            if (entry.max_ns < begin_ns || entry.min_ns >= end_ns) {
+                continue;
+            }
+            const Frame* records = getBlockRecords(block);
+            for (uint32_t i = 0; i < entry.record_count; ++i) {
+                if (records[i].timestamp_ns >= begin_ns && records[i].timestamp_ns < end_ns) {
+                    visit(records[i]);
+                    ++visited;
+                }
+            }
+        }
+        return visited;
+    }
+
+private:
+    void advise(size_t first, size_t count, int advice) const;
+
+    const uint8_t* base_{nullptr};
+    size_t size_{0};
+    const CaptureFileHeader* header_{nullptr};
+    const CaptureChannelInfo* channels_{nullptr};
+    const CaptureBlockIndex* index_{nullptr};
+};
+
+} // namespace serial_bus_generator
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "serial_bus_generator/capture/capture_format.hpp"
+#include "serial_bus_generator/interfaces/frame_sink_interface.hpp"
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace serial_bus_generator {
+
+/**
+ * @brief Sink that records frames to an indexed capture file
+ *
+ * Any number of generator threads may write concurrently. Records are
+ * gathered into large blocks that a background thread writes out, so a
+ * producer only copies its frames under a short lock.
+ */
+class CaptureWriter : public IFrameSink {
+public:
+    static constexpr size_t DEFAULT_BLOCK_RECORDS = 65536;  // 1.5 MiB blocks
+    static constexpr size_t BLOCK_POOL = 4;
+
+    CaptureWriter(const std::string& path, const std::vector<CaptureChannelInfo>& channels,
+                  size_t block_records = DEFAULT_BLOCK_RECORDS);
+    ~CaptureWriter() override;
+
+    CaptureWriter(const CaptureWriter&) = delete;
+    CaptureWriter& operator=(const CaptureWriter&) = delete;
+
+    void write(const Frame* frames, size_t count) override;
+    void flush() override;  // Writes out the partial block and waits for the disk thread
+    void close();           // Writes the index and final header; implied by the destructor
+
+    uint64_t getRecordCount() const;
+
+    static CaptureChannelInfo makeChannelInfo(uint16_t channel, MessageType type,
+                                              uint32_t rate_hz, const std::string& name);
+
+private:
+    void ioLoop();
+    void submitCurrent();  // Caller holds mutex_
+    void writeAll(const void* data, size_t size);
+    void rethrowIoError();  // Caller holds mutex_
+
+    int fd_{-1};
+    const size_t block_records_;
+    CaptureFileHeader header_{};
+    uint64_t file_offset_{0};  // Owned by the disk thread while open
+
+    mutable std::mutex mutex_;
+    std::condition_variable block_ready_;
+    std::condition_variable block_free_;
+    std::vector<Frame> current_;
+    std::deque<std::vector<Frame>> full_;
+    std::vector<std::vector<Frame>> free_;
+    size_t in_flight_{0};
+    uint64_t record_count_{0};
+    bool closing_{false};
+    bool closed_{false};
+    std::exception_ptr io_error_;
+
+    std::vector<CaptureBlockIndex> index_;  // Owned by the disk thread
+    std::thread io_thread_;
+};
+
+} // namespace serial_bus_generator
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "serial_bus_generator/capture/capture_reader.hpp"
+#include "serial_bus_generator/interfaces/frame_sink_interface.hpp"
+#include "serial_bus_generator/interfaces/generator_interface.hpp"
+#include "serial_bus_generator/messages/frame_batch.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace serial_bus_generator {
+
+struct ReplayOptions {
+    double speed{1.0};  // 0.1x - 100x of the recorded timing; 0 = as fast as possible
+    uint64_t begin_ns{0};                                  // Replay records at or after this time
+    uint64_t end_ns{std::numeric_limits<uint64_t>::max()};  // ... and before this one
+    bool restamp{false};   // Shift timestamps onto the replay's wall-clock timeline
+    size_t lookahead_blocks{4};  // Blocks prefetched ahead of the replay position
+    std::chrono::nanoseconds batch_window{100000};  // Frames due this close together go out as one batch
+};
+
+/**
+ * @brief Re-emits a recorded capture to frame sinks
+ *
+ * Frames keep their recorded spacing, scaled by the speed, and are paced
+ * against absolute deadlines like live generation. The capture stays
+ * memory-mapped: blocks ahead of the replay position are prefetched and
+ * blocks behind it released, so memory use does not grow with file size.
+ * Frames are replayed in file order; one recorded earlier than its
+ * predecessor goes out immediately.
+ */
+class ReplayEngine {
+public:
+    static constexpr double MIN_SPEED = 0.1;
+    static constexpr double MAX_SPEED = 100.0;
+    static constexpr size_t MAX_BATCH = 4096;
+    static constexpr std::chrono::milliseconds LATE_THRESHOLD{1};
+
+    explicit ReplayEngine(const std::string& path, const ReplayOptions& options = ReplayOptions());
+    ~ReplayEngine();
+
+    ReplayEngine(const ReplayEngine&) = delete;
+    ReplayEngine& operator=(const ReplayEngine&) = delete;
+
+    // Change only while stopped
+    void addSink(std::shared_ptr<IFrameSink> sink);
+
+    void start();  // Replays on a background thread
+    void stop();   // Stops early if still running, even mid-gap, then flushes the sinks
+    void run();    // Replays on the calling thread, then flushes the sinks
+    GeneratorState getState() const { return state_; }
+    std::string getLastError() const;  // Set when the state is ERROR
+
+    const CaptureReader& getReader() const { return reader_; }
+    uint64_t getReplayedFrames() const { return replayed_; }
+    uint64_t getLateBatches() const { return late_batches_; }  // Sent more than LATE_THRESHOLD past their deadline
+
+private:
+    void replay();
+    void emit(FrameBatch& batch, std::chrono::steady_clock::time_point due, bool paced);
+
+    CaptureReader reader_;
+    const ReplayOptions options_;
+    std::vector<std::shared_ptr<IFrameSink>> sinks_;
+    std::thread replay_thread_;
+    std::atomic<GeneratorState> state_{GeneratorState::STOPPED};
+    std::atomic<bool> running_{false};
+    std::atomic<uint64_t> replayed_{0};
+    std::atomic<uint64_t> late_batches_{0};
+    std::mutex wake_mutex_;
+    std::condition_variable wake_;  // Notified by stop() to cut a paced wait short
+    mutable std::mutex last_error_mutex_;
+    std::string last_error_;
+};
+
+} // namespace serial_bus_generator
@@ -0,0 +1,149 @@
+#pragma once
+
+#include "serial_bus_generator/interfaces/message_interface.hpp"
+#include "serial_bus_generator/protocols/arinc429/flight_trajectory.hpp"
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace serial_bus_generator {
+
+class TransmitSchedule;
+
+enum class FaultKind : uint8_t {
+    DROP,               // Signal is not transmitted
+    PARITY_ERROR,       // ARINC429: parity bit inverted
+    SSM_FAILURE,        // ARINC429: SSM set to failure warning
+    NO_COMPUTED_DATA,   // ARINC429: SSM set to no computed data
+    BAD_LENGTH          // J1939: frame sent with a short DLC
+};
+
+// One scheduled signal: an ARINC429 label or a J1939 PGN
+struct SignalPlan {
+    uint32_t key;
+    std::chrono::nanoseconds period;
+    std::chrono::nanoseconds phase;
+};
+
+// Fault on one signal over [start, end) of run time
+struct FaultPlan {
+    std::chrono::nanoseconds start;
+    std::chrono::nanoseconds end;
+    uint32_t key;
+    FaultKind kind;
+};
+
+/**
+ * @brief Everything one generator channel runs, resolved to protocol keys
+ */
+struct ChannelPlan {
+    std::string name;
+    MessageType protocol{MessageType::ARINC429};
+    uint16_t channel{0};
+    uint32_t rate{100};
+    std::vector<SignalPlan> signals;
+    std::vector<FaultPlan> faults;  // Sorted by start
+
+    // ARINC429
+    size_t fleet_size{0};
+    bool has_route{false};
+    GeoPoint origin{0.0, 0.0};
+    GeoPoint destination{0.0, 0.0};
+
+    // CANJ1939 engine noise
+    float rpm_jitter{50.0f};         // Per tick, either way
+    float temperature_drift{2.0f};   // Celsius per second, either way
+};
+
+/**
+ * @brief Compiled scenario: channels, signal sets, rates, routes and faults
+ *
+ * A scenario is an INI-style text file: a [scenario] section with name and
+ * seed, then one [channel <name>] section per generator:
+ *
+ *   [channel nav]
+ *   protocol = ARINC429
+ *   channel = 0
+ *   rate = 100
+ *   route = 47.6062,-122.3321 -> 25.7959,-80.2870
+ *   signal = ALTITUDE 50ms 15ms          # name, period, optional phase
+ *   fault = ALTITUDE SSM_FAILURE 10s 5s  # signal, kind, start, duration
+ *
+ * ARINC429 channels also take 'fleet = <aircraft>'; CANJ1939 channels take
+ * 'rpm_jitter' and 'temperature_drift'. Durations need a unit of ns, us, ms
+ * or s, and a fault must follow the signal it targets. Names are resolved
+ * and everything is validated once, here, so generators apply a plan
+ * without further lookups.
+ */
+struct ScenarioPlan {
+    std::string name;
+    bool has_seed{false};
+    uint64_t seed{0};
+    std::vector<ChannelPlan> channels;
+
+    // Throws std::invalid_argument naming the source and line of the first error
+    static ScenarioPlan compile(std::istream& in, const std::string& source = "scenario");
+    static ScenarioPlan load(const std::string& path);
+
+    const ChannelPlan* findChannel(const std::string& name) const;
+};
+
+// Loads a channel's signals into a transmit schedule. A stopped schedule is
+// rebuilt in plan order; a running one keeps the phase of the signals it
+// already has and disables the ones the plan dropped.
+void loadSignals(const std::vector<SignalPlan>& signals, TransmitSchedule& schedule, bool running);
+
+/**
+ * @brief Current plan of a scenario file, swapped atomically on reload
+ *
+ * getPlan() may be called from any thread. A changed file is only accepted
+ * if it compiles and keeps the same channels (name, protocol, channel number
+ * and fleet size); otherwise the running plan stays and getLastError() says why.
+ */
+class ScenarioLoader {
+public:
+    explicit ScenarioLoader(std::string path);  // Loads now; throws on error
+
+    std::shared_ptr<const ScenarioPlan> getPlan() const;
+    const std::string& getPath() const { return path_; }
+    const std::string& getLastError() const { return last_error_; }
+    uint64_t getVersion() const { return version_; }
+
+    // True if the file changed and its new plan was swapped in
+    bool reloadIfChanged();
+
+private:
+    std::string path_;
+    std::shared_ptr<const ScenarioPlan> plan_;
+    std::filesystem::file_time_type modified_;
+    std::string last_error_;
+    uint64_t version_{1};
+};
+
+/**
+ * @brief Fault windows of one channel, tracked along its run time
+ *
+ * advance() is called once per tick; find() only scans the faults active
+ * at that time, which is usually none.
+ */
+class FaultSchedule {
+public:
+    void assign(const std::vector<FaultPlan>& faults);  // Keeps the current time
+    void restart();  // Back to time zero, as at the start of a run
+
+    void advance(std::chrono::nanoseconds now);
+    bool anyActive() const { return !active_.empty(); }
+    const FaultPlan* find(uint32_t key) const;
+
+private:
+    std::vector<FaultPlan> faults_;     // Sorted by start
+    size_t next_{0};                    // First fault not yet started
+    std::vector<FaultPlan> active_;
+    std::chrono::nanoseconds now_{0};
+};
+
+} // namespace serial_bus_generator
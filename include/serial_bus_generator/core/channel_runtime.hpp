@@ -0,0 +1,86 @@
+#pragma once
+
+#include "serial_bus_generator/core/data_generator.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace serial_bus_generator {
+
+/**
+ * @brief Hosts many generator channels on a fixed pool of worker threads
+ *
+ * Each worker keeps its channels in a deadline-ordered queue. A worker with
+ * nothing due steals overdue channels from busier workers, and the stolen
+ * channel stays with the thief. Hosted generators keep their IGenerator
+ * semantics: start(), stop() and setRate() behave as with a dedicated thread.
+ */
+class ChannelRuntime {
+public:
+    static constexpr std::chrono::microseconds STEAL_INTERVAL{500};
+
+    // worker_count 0 uses one worker per hardware thread
+    explicit ChannelRuntime(size_t worker_count = 0, bool pin_workers = false);
+    ~ChannelRuntime();
+
+    ChannelRuntime(const ChannelRuntime&) = delete;
+    ChannelRuntime& operator=(const ChannelRuntime&) = delete;
+
+    // Take ownership of a stopped generator and host it as the next channel
+    DataGenerator& addChannel(std::unique_ptr<DataGenerator> generator);
+
+    size_t getChannelCount() const;
+    DataGenerator& getChannel(size_t channel);
+    size_t getWorkerCount() const { return workers_.size(); }
+
+    void startAll();
+    void stopAll();
+
+private:
+    friend class DataGenerator;
+
+    struct Channel {
+        std::unique_ptr<DataGenerator> generator;
+        std::mutex tick_mutex;          // Held while a worker runs a tick
+        std::atomic<uint64_t> epoch{0}; // Bumped on every activation/deactivation
+    };
+
+    struct Entry {
+        DeadlineScheduler::Clock::time_point deadline;
+        Channel* channel;
+        uint64_t epoch;
+
+        bool operator>(const Entry& other) const { return deadline > other.deadline; }
+    };
+
+    struct Worker {
+        std::mutex mutex;
+        std::condition_variable wake;
+        std::vector<Entry> queue;  // Min-heap on deadline
+        std::thread thread;
+    };
+
+    // Called from DataGenerator::start()/stop() of hosted channels
+    void activate(size_t channel);
+    void deactivate(size_t channel);
+
+    void workerLoop(size_t index);
+    bool popDue(Worker& worker, DeadlineScheduler::Clock::time_point now, Entry& entry);
+    bool steal(size_t thief, DeadlineScheduler::Clock::time_point now, Entry& entry);
+    void runEntry(size_t worker, const Entry& entry);
+    void push(Worker& worker, const Entry& entry);
+    void pinWorker(size_t index);
+
+    mutable std::mutex channels_mutex_;
+    std::vector<std::unique_ptr<Channel>> channels_;
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::atomic<bool> shutdown_{false};
+    std::atomic<size_t> next_worker_{0};
+};
+
+} // namespace serial_bus_generator
\ No newline at end of file
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+namespace serial_bus_generator {
+
+/**
+ * @brief Counter-based random numbers (Philox4x32-10)
+ *
+ * A draw is a pure function of the seed and a (channel, entity, tick, draw)
+ * counter, so any value can be recomputed on its own: output does not depend
+ * on how many threads generate, in which order entities are visited, or what
+ * was drawn before. There is no state beyond the 64-bit key.
+ */
+class CounterRng {
+public:
+    using Block = std::array<uint32_t, 4>;
+
+    static constexpr int ROUNDS = 10;
+
+    explicit CounterRng(uint64_t seed = 0)
+        : key0_(static_cast<uint32_t>(seed))
+        , key1_(static_cast<uint32_t>(seed >> 32))
+    {}
+
+    uint64_t getSeed() const { return (static_cast<uint64_t>(key1_) << 32) | key0_; }
+
+    // Four independent 32-bit values. 'draw' selects further blocks for the
+    // same entity and tick when four values are not enough.
+    Block operator()(uint16_t channel, uint32_t entity, uint64_t tick, uint16_t draw = 0) const {
+        return philox({static_cast<uint32_t>(tick), static_cast<uint32_t>(tick >> 32), entity,
+                       (static_cast<uint32_t>(channel) << 16) | draw},
+                      key0_, key1_);
+    }
+
+    // Uniform in [0, 1) with 24 bits of precision
+    static float toUnit(uint32_t bits) { return static_cast<float>(bits >> 8) * (1.0f / 16777216.0f); }
+
+    // Uniform in [low, high)
+    static float toRange(uint32_t bits, float low, float high) {
+        return low + (high - low) * toUnit(bits);
+    }
+
+    // Raw Philox4x32 block function
+    static Block philox(Block counter, uint32_t key0, uint32_t key1) {
+        for (int round = 0; round < ROUNDS; ++round) {
+            const uint64_t product0 = static_cast<uint64_t>(MULTIPLIER0) * counter[0];
+            const uint64_t product1 = static_cast<uint64_t>(MULTIPLIER1) * counter[2];
+            counter = {static_cast<uint32_t>(product1 >> 32) ^ counter[1] ^ key0,
+                       static_cast<uint32_t>(product1),
+                       static_cast<uint32_t>(product0 >> 32) ^ counter[3] ^ key1,
+                       static_cast<uint32_t>(product0)};
+            key0 += WEYL0;
+            key1 += WEYL1;
+        }
+        return counter;
+    }
+
+private:
+    static constexpr uint32_t MULTIPLIER0 = 0xD2511F53;
+    static constexpr uint32_t MULTIPLIER1 = 0xCD9E8D57;
+    static constexpr uint32_t WEYL0 = 0x9E3779B9;
+    static constexpr uint32_t WEYL1 = 0xBB67AE85;
+
+    uint32_t key0_;
+    uint32_t key1_;
+};
+
+} // namespace serial_bus_generator
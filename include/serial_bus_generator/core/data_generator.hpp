@@ -1,14 +1,31 @@
 #pragma once
 
 #include "serial_bus_generator/interfaces/generator_interface.hpp"
+#include "serial_bus_generator/interfaces/frame_sink_interface.hpp"
+#include "serial_bus_generator/config/generator_config.hpp"
+#include "serial_bus_generator/core/counter_rng.hpp"
+#include "serial_bus_generator/core/deadline_scheduler.hpp"
+#include "serial_bus_generator/core/spsc_ring.hpp"
+#include "serial_bus_generator/messages/frame_batch.hpp"
+#include "serial_bus_generator/metrics/latency_histogram.hpp"
+#include "serial_bus_generator/metrics/stats_recorder.hpp"
 #include <atomic>
+#include <mutex>
 #include <string>
 #include <thread>
 namespace serial_bus_generator {
 
+class ChannelRuntime;
+
+enum class ClockMode {
+    REALTIME,   // Ticks are paced against the steady clock
+    VIRTUAL     // Ticks run back to back on a simulated timeline
+};
+
 class DataGenerator : public IGenerator {
 public:
-    static constexpr uint32_t MAX_RATE = 1000;  // Maximum 1kHz rate
+    static constexpr uint32_t MAX_RATE = 100000;  // Maximum 100kHz rate
+    static constexpr size_t DEFAULT_FRAME_BUFFER = 16384;
 
     DataGenerator();
     ~DataGenerator() override;
@@ -18,24 +35,111 @@ public:
     void stop() override;
     void setRate(uint32_t rate) override;
     GeneratorState getState() const override;
+    GeneratorStats getStats() const override;
+    std::string getLastError() const override;  // Set when the state is ERROR
     virtual std::vector<std::unique_ptr<IMessage>> generateMessages(
         std::chrono::milliseconds duration) override = 0;
 
+    // Primary generation path. Appends the frames due over the next duration
+    // of simulated time to a caller-owned batch, stamped with the tick time
+    // and channel. Allocates nothing once the batch has grown to fit a tick;
+    // generateMessages() wraps the same frames in IMessage views.
+    virtual void generateFrames(std::chrono::milliseconds duration, FrameBatch& batch) = 0;
+
+    // Scheduling statistics
+    uint64_t getTickCount() const { return stats_.getTicks(); }
+    uint64_t getMissedDeadlines() const { return stats_.getMissedDeadlines(); }
+
+    // Tick latency distributions over the generator's lifetime; any thread
+    LatencyStats getLatencyStats() const;
+
+    // Frame output queue. A single consumer thread drains every generated
+    // frame in order; frames that do not fit are dropped and counted.
+    size_t drainFrames(Frame* out, size_t max_frames);
+    size_t getQueuedFrames() const { return frames_->size(); }
+    uint64_t getOverrunCount() const { return stats_.getDroppedFrames(); }
+    void setFrameBufferCapacity(size_t capacity);  // Only while stopped
+
+    // Simulated-time mode for offline generation; change only while stopped.
+    // With a non-zero duration a virtual run stops itself once that much
+    // simulated time has passed. Epoch 0 starts the timeline at wall-clock now.
+    void setClockMode(ClockMode mode);
+    ClockMode getClockMode() const { return clock_mode_; }
+    void setVirtualDuration(std::chrono::nanoseconds duration);
+    void setVirtualEpoch(uint64_t epoch_ns);
+    std::chrono::nanoseconds getElapsedTime() const;
+
+    // Sinks receive every tick's frames on the generation thread, so text
+    // is only rendered when a text sink is attached; change only while stopped
+    void addSink(std::shared_ptr<IFrameSink> sink);
+    void clearSinks();
+
+    void setChannel(uint16_t channel) { channel_ = channel; }
+    uint16_t getChannel() const { return channel_; }
+
+    // Seed of every random value the generator draws. Defaults to a random
+    // seed; the same seed and channel reproduce a run exactly. Only while stopped.
+    void setSeed(uint64_t seed);
+    uint64_t getSeed() const { return rng_.getSeed(); }
+
+    // Runs a compiled scenario channel. Stopped, the plan applies at once,
+    // channel number included. Running, the rate applies from the next
+    // deadline and the rest is swapped in on the generation thread before
+    // the next tick; the channel number must stay the same.
+    void setPlan(std::shared_ptr<const ChannelPlan> plan);
+
 private:
+    friend class ChannelRuntime;
+
+    void resetTimeline();
+
     std::thread generation_thread_;
+    std::unique_ptr<SpscRing<Frame>> frames_;
+    uint16_t channel_{0};
+    uint64_t epoch_ns_{0};  // Wall-clock time of the timeline origin
+    std::atomic<ClockMode> clock_mode_{ClockMode::REALTIME};
+    std::chrono::nanoseconds virtual_duration_{0};
+    uint64_t virtual_epoch_ns_{0};
+    std::atomic<int64_t> elapsed_ns_{0};  // Published copy of the timeline position
+    FrameBatch tick_frames_;  // Reused by every tick
+    std::vector<std::shared_ptr<IFrameSink>> sinks_;
+    ChannelRuntime* runtime_{nullptr};  // Set when hosted on a shared worker pool
+    size_t runtime_slot_{0};
+    std::shared_ptr<const ChannelPlan> pending_plan_;  // Accessed with std::atomic_load/store
+    std::atomic<bool> plan_pending_{false};
+    StatsRecorder stats_;  // Recorded on the generation thread
+    LatencyHistogram wakeup_lateness_;
+    LatencyHistogram generate_duration_;
+    LatencyHistogram sink_latency_;
+    mutable std::mutex last_error_mutex_;
+    std::string last_error_;
 
 protected:
     // Template method pattern for protocol-specific generation
+    virtual void prepareGeneration() {}
+    // Protocol part of a scenario channel; on the generation thread while running
+    virtual void applyPlan(const ChannelPlan& plan);
     virtual void startGeneration();
     virtual void stopGeneration();
     virtual void handleError(const std::string& error);
-    virtual void processMessages(std::vector<std::unique_ptr<IMessage>>&& messages);
+    virtual void processFrames(const FrameBatch& frames);
+
+    // Run one tick at the scheduler's pending deadline and advance to the next one
+    bool runTick();
+
+    // Queue frames for consumers in order
+    void publishFrames(const Frame* frames, size_t count);
+    uint64_t currentTimestamp() const;
 
     std::atomic<GeneratorState> state_;
     std::atomic<uint32_t> rate_;
     std::atomic<bool> running_;
-    std::atomic<size_t> message_count_{0};
-    std::string last_error_;
+    CounterRng rng_;  // Draw with (getChannel(), entity, tick) counters
+    std::mutex last_message_mutex_;  // Guards subclasses' getLastMessage() state
+
+    // Owned by the generation thread while running
+    DeadlineScheduler scheduler_;
+    std::chrono::milliseconds simulated_time_{0};
 };
 
 } // namespace serial_bus_generator
\ No newline at end of file
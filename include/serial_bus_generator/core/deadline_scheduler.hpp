@@ -0,0 +1,60 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+namespace serial_bus_generator {
+
+/**
+ * @brief Absolute-deadline tick scheduler
+ *
+ * Deadlines are computed from a fixed origin as origin + n * 1s / rate using
+ * integer arithmetic, so work time and rounding never accumulate as drift and
+ * the average rate is exact for any rate. Waiting sleeps until shortly before
+ * the deadline and spins for the remainder to get microsecond accuracy.
+ */
+class DeadlineScheduler {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr std::chrono::nanoseconds DEFAULT_SPIN_THRESHOLD{50000};  // 50us
+
+    explicit DeadlineScheduler(uint32_t rate);
+
+    // Restart the timeline; the first deadline is the origin itself
+    void start(Clock::time_point origin);
+
+    // Change the rate; the pending deadline is kept and later ones use the new period
+    void setRate(uint32_t rate);
+    uint32_t getRate() const { return rate_; }
+
+    Clock::time_point nextDeadline() const;
+
+    // Ideal time of the pending deadline since start(), across rate changes
+    std::chrono::nanoseconds elapsed() const;
+
+    // Step to the following deadline without checking the clock
+    void advance();
+
+    // Step past every deadline that can no longer be met at 'now'.
+    // A deadline counts as missed when the one after it has already passed;
+    // returns the number of deadlines skipped this way.
+    uint64_t advance(Clock::time_point now);
+
+    void sleepUntilDeadline() const;
+    void setSpinThreshold(std::chrono::nanoseconds threshold) { spin_threshold_ = threshold; }
+
+    // Hybrid wait: sleep until 'deadline - spin_threshold', then busy-wait
+    static void sleepUntil(Clock::time_point deadline, std::chrono::nanoseconds spin_threshold);
+
+private:
+    std::chrono::nanoseconds offsetOf(uint64_t tick) const;
+
+    uint32_t rate_;
+    Clock::time_point origin_;
+    uint64_t tick_{0};                        // Ticks since origin_
+    std::chrono::nanoseconds elapsed_base_{0};  // Elapsed time at origin_
+    std::chrono::nanoseconds spin_threshold_{DEFAULT_SPIN_THRESHOLD};
+};
+
+} // namespace serial_bus_generator
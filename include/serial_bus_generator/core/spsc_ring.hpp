@@ -0,0 +1,116 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+
+namespace serial_bus_generator {
+
+/**
+ * @brief Bounded lock-free single-producer/single-consumer ring
+ *
+ * Storage is allocated once at construction. One thread may push and one
+ * other thread may pop; neither side ever blocks or allocates. Each side
+ * caches the other's index so the shared cache lines are only touched when
+ * the cached view runs out.
+ */
+template <typename T>
+class SpscRing {
+    static_assert(std::is_trivially_copyable<T>::value, "SpscRing holds trivially copyable items");
+
+public:
+    // Capacity is rounded up to a power of two
+    explicit SpscRing(size_t capacity)
+        : capacity_(roundUp(capacity))
+        , mask_(capacity_ - 1)
+        , buffer_(new T[capacity_])
+    {}
+
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    // Producer side; false when the ring is full
+    bool tryPush(const T& item) {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        if (head - tail_cache_ == capacity_) {
+            tail_cache_ = tail_.load(std::memory_order_acquire);
+            if (head - tail_cache_ == capacity_) {
+                return false;
+            }
+        }
+        buffer_[head & mask_] = item;
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Producer side; pushes as many items as fit and returns that count
+    size_t tryPush(const T* items, size_t count) {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        size_t free = capacity_ - (head - tail_cache_);
+        if (free < count) {
+            tail_cache_ = tail_.load(std::memory_order_acquire);
+            free = capacity_ - (head - tail_cache_);
+        }
+        const size_t n = count < free ? count : free;
+        for (size_t i = 0; i < n; ++i) {
+            buffer_[(head + i) & mask_] = items[i];
+        }
+        head_.store(head + n, std::memory_order_release);
+        return n;
+    }
+
+    // Consumer side; false when the ring is empty
+    bool tryPop(T& item) {
+        return tryPop(&item, 1) == 1;
+    }
+
+    // Consumer side; pops up to max_items in FIFO order and returns the count
+    size_t tryPop(T* out, size_t max_items) {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        size_t available = head_cache_ - tail;
+        if (available < max_items) {
+            head_cache_ = head_.load(std::memory_order_acquire);
+            available = head_cache_ - tail;
+        }
+        const size_t n = max_items < available ? max_items : available;
+        for (size_t i = 0; i < n; ++i) {
+            out[i] = buffer_[(tail + i) & mask_];
+        }
+        tail_.store(tail + n, std::memory_order_release);
+        return n;
+    }
+
+    // Approximate when called concurrently with either side
+    size_t size() const {
+        return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire);
+    }
+    bool empty() const { return size() == 0; }
+    size_t capacity() const { return capacity_; }
+
+private:
+    static constexpr size_t CACHE_LINE = 64;
+
+    static size_t roundUp(size_t capacity) {
+        if (capacity == 0) {
+            throw std::invalid_argument("Ring capacity must be non-zero");
+        }
+        size_t rounded = 1;
+        while (rounded < capacity) {
+            rounded <<= 1;
+        }
+        return rounded;
+    }
+
+    const size_t capacity_;
+    const size_t mask_;
+    std::unique_ptr<T[]> buffer_;
+
+    alignas(CACHE_LINE) std::atomic<size_t> head_{0};  // Written by the producer
+    size_t tail_cache_{0};                             // Producer's view of tail_
+    alignas(CACHE_LINE) std::atomic<size_t> tail_{0};  // Written by the consumer
+    size_t head_cache_{0};                             // Consumer's view of head_
+};
+
+} // namespace serial_bus_generator
\ No newline at end of file
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+namespace serial_bus_generator {
+
+// Blocks until ready() holds, like cv.wait(lock, ready); every change that
+// makes it hold must notify under the lock. Spelled as a wait without a
+// deadline because the untimed wait needs a newer libstdc++ runtime
+// (GLIBCXX_3.4.30) than some toolchains we link against ship.
+template <typename Predicate>
+void waitUntil(std::condition_variable& cv, std::unique_lock<std::mutex>& lock, Predicate ready) {
+    cv.wait_until(lock, std::chrono::steady_clock::time_point::max(), ready);
+}
+
+} // namespace serial_bus_generator
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace serial_bus_generator {
+
+/**
+ * @brief Hierarchical timing wheel
+ *
+ * Timers are identified by a caller-chosen dense id and expire at an absolute
+ * tick. Scheduling and expiry are O(1); timers further out live on coarser
+ * levels and are cascaded down as time approaches them.
+ */
+class TimingWheel {
+public:
+    static constexpr unsigned SLOT_BITS = 6;
+    static constexpr unsigned SLOTS = 1u << SLOT_BITS;
+    static constexpr unsigned LEVELS = 4;
+
+    TimingWheel();
+
+    // Drop all timers and restart at tick 0
+    void reset();
+
+    // Arm timer 'id', which must not already be pending.
+    // Expiries in the past fire on the next advance.
+    void schedule(uint32_t id, uint64_t expiry);
+
+    // Next tick that has not been processed yet
+    uint64_t now() const { return now_; }
+    size_t pending() const { return pending_; }
+
+    // Process every tick up to and including 'tick', calling on_expire(id, expiry)
+    // for each timer that fires. The callback may re-arm the timer.
+    template <typename Callback>
+    void advanceTo(uint64_t tick, Callback&& on_expire);
+
+private:
+    static constexpr uint32_t NONE = std::numeric_limits<uint32_t>::max();
+
+    struct Node {
+        uint64_t expiry{0};
+        uint32_t next{NONE};
+        bool armed{false};
+    };
+
+    void insert(uint32_t id);
+    void cascade();
+    uint32_t detach(unsigned level, unsigned slot);
+
+    std::vector<Node> nodes_;
+    std::array<std::array<uint32_t, SLOTS>, LEVELS> slots_;
+    uint64_t now_{0};
+    size_t pending_{0};
+};
+
+template <typename Callback>
+void TimingWheel::advanceTo(uint64_t tick, Callback&& on_expire) {
+    while (now_ <= tick) {
+        if (pending_ == 0) {
+            now_ = tick + 1;
+            return;
+        }
+
+        cascade();
+        uint32_t id = detach(0, static_cast<unsigned>(now_ & (SLOTS - 1)));
+        ++now_;
+
+        while (id != NONE) {
+            const uint32_t next = nodes_[id].next;
+            nodes_[id].next = NONE;
+            nodes_[id].armed = false;
+            --pending_;
+            on_expire(id, nodes_[id].expiry);
+            id = next;
+        }
+    }
+}
+
+} // namespace serial_bus_generator
\ No newline at end of file
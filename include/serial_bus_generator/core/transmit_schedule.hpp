@@ -0,0 +1,63 @@
+#pragma once
+
+#include "serial_bus_generator/core/timing_wheel.hpp"
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+namespace serial_bus_generator {
+
+/**
+ * @brief Per-signal transmit schedule
+ *
+ * Each entry (an ARINC 429 label, a J1939 PGN, ...) is sent every 'period'
+ * starting at its 'phase' offset. Entries are driven by a TimingWheel so the
+ * cost of a tick depends only on the entries that are actually due.
+ */
+class TransmitSchedule {
+public:
+    static constexpr std::chrono::nanoseconds DEFAULT_RESOLUTION{1000000};  // 1ms
+
+    explicit TransmitSchedule(std::chrono::nanoseconds resolution = DEFAULT_RESOLUTION);
+
+    // Returns the entry index; entries are due at 'phase', then every 'period'
+    size_t addEntry(uint32_t key, std::chrono::nanoseconds period,
+                    std::chrono::nanoseconds phase = std::chrono::nanoseconds(0));
+    void setPeriod(size_t entry, std::chrono::nanoseconds period);
+    // A disabled entry keeps its phase but is not reported as due
+    void setEnabled(size_t entry, bool enabled);
+    bool isEnabled(size_t entry) const { return entries_[entry].enabled; }
+    void clear();
+
+    // Restart the timeline at zero with every entry due at its phase
+    void reset();
+
+    size_t size() const { return entries_.size(); }
+    size_t findEntry(uint32_t key) const;  // size() when absent
+    uint32_t getKey(size_t entry) const { return entries_[entry].key; }
+    std::chrono::nanoseconds getPeriod(size_t entry) const;
+    std::chrono::nanoseconds now() const { return now_; }
+
+    // Move the timeline forward and return the keys that became due, in
+    // deadline order. An entry due several times within one step is reported
+    // once and keeps its phase. The returned buffer is reused by the next call.
+    const std::vector<uint32_t>& advance(std::chrono::nanoseconds delta);
+
+private:
+    struct Entry {
+        uint32_t key;
+        uint64_t period_ticks;
+        uint64_t phase_ticks;
+        bool enabled;
+    };
+
+    uint64_t toTicks(std::chrono::nanoseconds duration) const;
+
+    std::chrono::nanoseconds resolution_;
+    std::chrono::nanoseconds now_{0};
+    std::vector<Entry> entries_;
+    std::vector<uint32_t> due_;
+    TimingWheel wheel_;
+};
+
+} // namespace serial_bus_generator
\ No newline at end of file
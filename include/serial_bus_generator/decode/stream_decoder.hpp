@@ -0,0 +1,95 @@
+#pragma once
+
+#include "serial_bus_generator/interfaces/frame_sink_interface.hpp"
+#include "serial_bus_generator/protocols/arinc429/arinc429_codec.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+namespace serial_bus_generator {
+
+// Validation results, one bit per check that failed
+enum DecodeStatus : uint8_t {
+    DECODE_OK = 0,
+    DECODE_BAD_PARITY = 1 << 0,      // ARINC429 word without odd parity
+    DECODE_UNKNOWN_LABEL = 1 << 1,   // ARINC429 label not in the label database
+    DECODE_SSM_NOT_NORMAL = 1 << 2,  // ARINC429 SSM other than normal operation
+    DECODE_UNKNOWN_PGN = 1 << 3,     // J1939 PGN without a known decoding
+    DECODE_BAD_LENGTH = 1 << 4       // Frame length does not match its protocol
+};
+
+/**
+ * @brief One decoded value
+ *
+ * key is the ARINC429Label (or the raw 8-bit label field when unknown) or
+ * the J1939 PGN. value is NaN when the frame could not be decoded.
+ */
+struct DecodedSample {
+    uint64_t timestamp_ns;
+    uint32_t key;
+    uint16_t channel;
+    MessageType type;
+    uint8_t status;  // DecodeStatus bits
+    float value;
+};
+
+struct DecodeStats {
+    uint64_t frames{0};
+    uint64_t arinc429_words{0};
+    uint64_t j1939_frames{0};
+    uint64_t parity_errors{0};
+    uint64_t unknown_labels{0};
+    uint64_t ssm_not_normal{0};
+    uint64_t unknown_pgns{0};
+    uint64_t bad_lengths{0};
+
+    // Frames that failed any check other than the SSM, which is informational
+    uint64_t invalid{0};
+};
+
+/**
+ * @brief Batch decoder and validator for raw ARINC429 words and J1939 frames
+ *
+ * ARINC429 words are gathered into contiguous chunks and decoded and
+ * parity-checked with ARINC429BatchCodec's vector kernels; J1939 frames
+ * are decoded with CANJ1939Message::decodeValue(). Values match the
+ * per-message getDecodedValue() paths. As a sink it decodes every frame
+ * it receives, keeps running statistics and hands each chunk of samples
+ * to an optional consumer.
+ */
+class StreamDecoder : public IFrameSink {
+public:
+    static constexpr size_t CHUNK = 1024;
+    using Consumer = std::function<void(const DecodedSample* samples, size_t count)>;
+
+    StreamDecoder();
+    explicit StreamDecoder(Consumer consumer,
+                           ARINC429BatchCodec::Kernel kernel = ARINC429BatchCodec::bestKernel());
+
+    // Decodes count frames into out and returns how many are invalid
+    size_t decode(const Frame* frames, size_t count, DecodedSample* out);
+
+    // Decodes raw ARINC429 words into values and DecodeStatus bits and
+    // returns how many are invalid
+    size_t decodeWords(const uint32_t* words, size_t count, float* values, uint8_t* status);
+
+    void write(const Frame* frames, size_t count) override;
+    void flush() override {}
+
+    const DecodeStats& getStats() const { return stats_; }
+    void resetStats() { stats_ = DecodeStats(); }
+
+private:
+    Consumer consumer_;
+    ARINC429BatchCodec codec_;
+    DecodeStats stats_;
+
+    // Chunk scratch space, reused by every call
+    uint32_t words_[CHUNK];
+    uint32_t word_index_[CHUNK];
+    float values_[CHUNK];
+    uint8_t status_[CHUNK];
+    DecodedSample samples_[CHUNK];
+};
+
+} // namespace serial_bus_generator
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "serial_bus_generator/messages/frame.hpp"
+#include <cstddef>
+
+namespace serial_bus_generator {
+
+/**
+ * @brief Interface for consumers of generated frames
+ *
+ * A sink attached to a generator is called on its generation thread with
+ * every tick's frames, in order, so a sink that stalls stalls generation;
+ * wrap such sinks in a QueuedSink to give them an overrun policy instead.
+ */
+class IFrameSink {
+public:
+    virtual ~IFrameSink() = default;
+    virtual void write(const Frame* frames, size_t count) = 0;
+    virtual void flush() {}
+};
+
+} // namespace serial_bus_generator
@@ -1,9 +1,11 @@
 #pragma once
 
 #include "serial_bus_generator/interfaces/message_interface.hpp"
+#include "serial_bus_generator/metrics/generator_stats.hpp"
 #include <vector>
 #include <memory>
 #include <chrono>
+#include <string>
 
 namespace serial_bus_generator {
 
@@ -24,6 +26,10 @@ public:
     virtual std::vector<std::unique_ptr<IMessage>> generateMessages(
         std::chrono::milliseconds duration) = 0;
     virtual std::string getLastMessage() = 0;
+
+    // Safe to call from any thread while the generator runs
+    virtual GeneratorStats getStats() const = 0;
+    virtual std::string getLastError() const = 0;
 };
 
 } // namespace serial_bus_generator
\ No newline at end of file
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <algorithm>
 #include <vector>
 #include <string>
 #include <cstdint>
@@ -10,7 +11,7 @@ namespace serial_bus_generator {
 /**
  * @brief Enumeration of supported message types
  */
-enum class MessageType {
+enum class MessageType : uint8_t {
     ARINC429,
     CANJ1939
 };
@@ -23,6 +24,17 @@ public:
     virtual ~IMessage() = default;
     virtual bool isValid() const = 0;
     virtual std::vector<uint8_t> serialize() const = 0;
+
+    // Writes the serialize() bytes into a caller-supplied buffer and returns
+    // the count, or 0 if they do not fit. Override to avoid the allocation.
+    virtual size_t serializeInto(uint8_t* out, size_t capacity) const {
+        const auto bytes = serialize();
+        if (bytes.size() > capacity) {
+            return 0;
+        }
+        std::copy(bytes.begin(), bytes.end(), out);
+        return bytes.size();
+    }
     virtual std::string toString() const = 0;
     virtual MessageType getType() const = 0;
     virtual uint32_t getTimestamp() const = 0;
@@ -23,6 +23,7 @@ public:
     // Implementation of common methods from IMessage
     MessageType getType() const override { return type_; }
     uint32_t getTimestamp() const override { return timestamp_; }
+    void setTimestamp(uint32_t timestamp) { timestamp_ = timestamp; }
 
     // These still need to be implemented by derived classes
     bool isValid() const override = 0;
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "serial_bus_generator/interfaces/message_interface.hpp"
+#include <cstdint>
+#include <type_traits>
+
+namespace serial_bus_generator {
+
+/**
+ * @brief Encoded bus frame
+ *
+ * Fixed-size value type shared by every protocol so frames can be queued,
+ * recorded and replayed without allocation or virtual dispatch.
+ * - ARINC429: id holds the full 32-bit word, data its 4 bytes little-endian
+ * - CANJ1939: id holds the 29-bit CAN identifier, data the CAN payload
+ */
+struct Frame {
+    uint64_t timestamp_ns{0};  // Nanoseconds since the Unix epoch
+    uint32_t id{0};
+    uint16_t channel{0};
+    MessageType type{MessageType::ARINC429};
+    uint8_t dlc{0};            // Number of valid bytes in data
+    uint8_t data[8]{};
+};
+
+static_assert(sizeof(Frame) == 24, "Frame layout must stay packed");
+static_assert(std::is_trivially_copyable<Frame>::value, "Frame must be trivially copyable");
+
+} // namespace serial_bus_generator
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "serial_bus_generator/messages/frame.hpp"
+#include <cstddef>
+#include <vector>
+
+namespace serial_bus_generator {
+
+/**
+ * @brief Reusable, caller-owned buffer of contiguous frames
+ *
+ * clear() keeps the storage, so a batch that is reused every tick stops
+ * allocating once it has grown to the largest tick it has seen.
+ */
+class FrameBatch {
+public:
+    FrameBatch() = default;
+    explicit FrameBatch(size_t capacity) { frames_.reserve(capacity); }
+
+    void push(const Frame& frame) { frames_.push_back(frame); }
+    void clear() { frames_.clear(); }
+    void reserve(size_t capacity) { frames_.reserve(capacity); }
+
+    size_t size() const { return frames_.size(); }
+    bool empty() const { return frames_.empty(); }
+    size_t capacity() const { return frames_.capacity(); }
+
+    const Frame* data() const { return frames_.data(); }
+    Frame* data() { return frames_.data(); }
+    const Frame& operator[](size_t index) const { return frames_[index]; }
+    Frame& operator[](size_t index) { return frames_[index]; }
+
+    const Frame* begin() const { return frames_.data(); }
+    const Frame* end() const { return frames_.data() + frames_.size(); }
+    Frame* begin() { return frames_.data(); }
+    Frame* end() { return frames_.data() + frames_.size(); }
+
+private:
+    std::vector<Frame> frames_;
+};
+
+} // namespace serial_bus_generator
\ No newline at end of file
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "serial_bus_generator/messages/frame.hpp"
+#include <cstddef>
+#include <cstdint>
+
+namespace serial_bus_generator {
+
+// Wire layout is the one IMessage::serialize() has always produced:
+// - ARINC429: the 32-bit word, 4 bytes little-endian
+// - CANJ1939: PGN in bytes 0-2 little-endian, then the first 5 payload bytes
+constexpr size_t ARINC429_WIRE_SIZE = 4;
+constexpr size_t CANJ1939_WIRE_SIZE = 8;
+constexpr size_t MAX_WIRE_SIZE = 8;
+
+// Number of bytes serializeFrame() writes for this frame
+size_t serializedSize(const Frame& frame);
+
+// Writes one frame and returns the bytes written, or 0 if it does not fit
+size_t serializeFrame(const Frame& frame, uint8_t* out, size_t capacity);
+
+// Packs frames back to back, stopping at the first one that does not fit.
+// Returns the bytes written; consumed, if given, receives the frame count.
+size_t serializeFrames(const Frame* frames, size_t count, uint8_t* out, size_t capacity,
+                       size_t* consumed = nullptr);
+
+} // namespace serial_bus_generator
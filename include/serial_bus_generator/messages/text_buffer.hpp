@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace serial_bus_generator {
+
+/**
+ * @brief Growable character buffer for allocation-free text rendering
+ *
+ * Numbers are rendered with std::to_chars. clear() keeps the storage, so a
+ * buffer reused for every batch stops allocating once it is large enough.
+ */
+class TextBuffer {
+public:
+    explicit TextBuffer(size_t capacity = 4096);
+
+    void append(std::string_view text);
+    void append(char c);
+    void appendInt(int64_t value);
+    void appendHex(uint64_t value);          // Uppercase digits, no prefix
+    void appendFixed(double value, int precision);
+
+    const char* data() const { return buffer_.data(); }
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    void clear() { size_ = 0; }
+    std::string str() const { return std::string(buffer_.data(), size_); }
+    std::string_view view() const { return std::string_view(buffer_.data(), size_); }
+
+private:
+    char* reserve(size_t count);  // Room for count more characters at the end
+
+    std::vector<char> buffer_;
+    size_t size_{0};
+};
+
+} // namespace serial_bus_generator
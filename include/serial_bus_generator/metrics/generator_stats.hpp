@@ -0,0 +1,46 @@
+#pragma once
+
+#include "serial_bus_generator/interfaces/message_interface.hpp"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace serial_bus_generator {
+
+/**
+ * @brief Frames generated for one label or PGN
+ *
+ * key is the ARINC429Label (or the raw 8-bit label field when unknown) or
+ * the J1939 PGN, as in DecodedSample.
+ */
+struct SignalStats {
+    MessageType type{MessageType::ARINC429};
+    uint32_t key{0};
+    uint64_t frames{0};
+};
+
+/**
+ * @brief Snapshot of a generator's counters
+ *
+ * Counters only grow over the generator's lifetime, across restarts.
+ * Lateness is how far past its deadline a real-time tick started; virtual
+ * runs do not record it.
+ */
+struct GeneratorStats {
+    uint16_t channel{0};
+    uint64_t frames{0};
+    uint64_t ticks{0};
+    uint64_t missed_deadlines{0};
+    uint64_t dropped_frames{0};   // Frames that did not fit the output queue
+    uint64_t encode_errors{0};    // Ticks that failed with an exception
+    size_t queue_depth{0};        // Frames waiting in the output queue
+    size_t queue_capacity{0};
+    std::chrono::nanoseconds elapsed{0};  // Timeline position of the current run
+    std::chrono::nanoseconds last_lateness{0};
+    std::chrono::nanoseconds max_lateness{0};
+    std::chrono::nanoseconds total_lateness{0};  // Sum over every recorded tick
+    std::vector<SignalStats> signals;  // Ordered by type, then key
+};
+
+} // namespace serial_bus_generator
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace serial_bus_generator {
+
+/**
+ * @brief Copy of a LatencyHistogram's buckets
+ *
+ * Percentiles are the highest value that falls in the same bucket as the
+ * sample at that rank, capped at the recorded maximum, so they are never
+ * under-reported and are within the histogram's precision of the truth.
+ */
+struct HistogramSnapshot {
+    std::vector<uint64_t> buckets;
+    uint64_t count{0};
+    std::chrono::nanoseconds max{0};
+    std::chrono::nanoseconds total{0};
+
+    bool empty() const { return count == 0; }
+    std::chrono::nanoseconds percentile(double percent) const;
+    std::chrono::nanoseconds mean() const;
+
+    // "p50 12.1us p99 40.3us p99.9 88.0us max 0.12ms (n=1000)"
+    std::string summary() const;
+};
+
+/**
+ * @brief Log-bucketed latency histogram in the style of HdrHistogram
+ *
+ * Each power-of-two range of nanoseconds is split into SUB_BUCKETS / 2
+ * linear buckets, which bounds the relative error of any value at about
+ * 1.6% over the whole range while one record is an index computation and
+ * a counter bump. Values beyond MAX_TRACKABLE land in the top bucket; the
+ * maximum is kept exactly.
+ *
+ * One thread records, without locks or read-modify-write instructions;
+ * any thread may take a snapshot while it does.
+ */
+class LatencyHistogram {
+public:
+    static constexpr unsigned SUB_BUCKET_BITS = 6;
+    static constexpr uint64_t SUB_BUCKETS = uint64_t{1} << SUB_BUCKET_BITS;
+    static constexpr unsigned MAX_MAGNITUDE = 42;  // 2^42 ns, about 73 minutes
+    static constexpr uint64_t MAX_TRACKABLE = (uint64_t{1} << MAX_MAGNITUDE) - 1;
+    static constexpr size_t BUCKET_COUNT =
+        (MAX_MAGNITUDE - SUB_BUCKET_BITS + 1) * (SUB_BUCKETS / 2) + SUB_BUCKETS / 2;
+
+    LatencyHistogram();
+
+    LatencyHistogram(const LatencyHistogram&) = delete;
+    LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+    // Writer side; negative durations count as zero
+    void record(std::chrono::nanoseconds value) {
+        const uint64_t ns = value.count() > 0 ? static_cast<uint64_t>(value.count()) : 0;
+        bump(buckets_[bucketIndex(ns)], 1);
+        bump(count_, 1);
+        bump(total_ns_, ns);
+        if (ns > max_ns_.load(std::memory_order_relaxed)) {
+            max_ns_.store(ns, std::memory_order_relaxed);
+        }
+    }
+
+    // Reader side, any thread
+    HistogramSnapshot snapshot() const;
+    uint64_t getCount() const { return count_.load(std::memory_order_relaxed); }
+
+    // Bucket layout, shared with HistogramSnapshot
+    static size_t bucketIndex(uint64_t value) {
+        if (value > MAX_TRACKABLE) {
+            value = MAX_TRACKABLE;
+        }
+        if (value < SUB_BUCKETS) {
+            return static_cast<size_t>(value);
+        }
+        // Keep the top SUB_BUCKET_BITS bits: value >> shift is in [SUB_BUCKETS / 2, SUB_BUCKETS)
+        const unsigned shift = 63 - __builtin_clzll(value) - (SUB_BUCKET_BITS - 1);
+        return static_cast<size_t>(shift * (SUB_BUCKETS / 2) + (value >> shift));
+    }
+    static uint64_t bucketLowest(size_t index);
+    static uint64_t bucketHighest(size_t index);
+
+private:
+    static void bump(std::atomic<uint64_t>& counter, uint64_t count) {
+        counter.store(counter.load(std::memory_order_relaxed) + count, std::memory_order_relaxed);
+    }
+
+    std::array<std::atomic<uint64_t>, BUCKET_COUNT> buckets_;
+    std::atomic<uint64_t> count_{0};
+    std::atomic<uint64_t> total_ns_{0};
+    std::atomic<uint64_t> max_ns_{0};
+};
+
+/**
+ * @brief Latency distributions of a generator's ticks
+ *
+ * - wakeup_lateness: how far past its deadline a real-time tick started
+ * - generate_duration: time spent generating a tick's frames
+ * - sink_latency: from a real-time tick's frame timestamp until its frames
+ *   were queued and written to every sink
+ */
+struct LatencyStats {
+    HistogramSnapshot wakeup_lateness;
+    HistogramSnapshot generate_duration;
+    HistogramSnapshot sink_latency;
+};
+
+} // namespace serial_bus_generator
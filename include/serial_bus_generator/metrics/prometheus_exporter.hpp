@@ -0,0 +1,88 @@
+#pragma once
+
+#include "serial_bus_generator/interfaces/generator_interface.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+namespace serial_bus_generator {
+
+/**
+ * @brief Publishes generator statistics in the Prometheus text format
+ *
+ * The target is either a file path, rewritten every interval through a
+ * temporary file and a rename so readers (such as node_exporter's textfile
+ * collector) never see a partial file, or "unix:<path>" to answer each
+ * connection on a local socket with one HTTP/1.0 scrape response.
+ * Generators are only read through getStats(), never locked, so exporting
+ * does not disturb their timing. Per-second rates are computed from the
+ * change since the previous export.
+ */
+class PrometheusExporter {
+public:
+    static constexpr std::chrono::milliseconds DEFAULT_INTERVAL{1000};
+    static constexpr const char* SOCKET_PREFIX = "unix:";
+
+    explicit PrometheusExporter(std::string target,
+                                std::chrono::milliseconds interval = DEFAULT_INTERVAL);
+    ~PrometheusExporter();
+
+    PrometheusExporter(const PrometheusExporter&) = delete;
+    PrometheusExporter& operator=(const PrometheusExporter&) = delete;
+
+    // The generator must outlive the exporter's run; only while stopped
+    void addGenerator(const IGenerator& generator);
+
+    // Exports in the background until stopped; stop() writes a final file export
+    void start();
+    void stop();
+    bool isRunning() const { return running_; }
+
+    // One export to the file target, on the calling thread
+    void exportNow();
+
+    // Current exposition text; advances the rate baseline
+    std::string render();
+
+    const std::string& getTarget() const { return target_; }
+    uint64_t getExportCount() const { return exports_; }
+    std::string getLastError() const;  // Most recent failed export, empty if none
+
+private:
+    using SignalKey = std::tuple<size_t, MessageType, uint32_t>;  // Generator, protocol, key
+
+    void exportLoop();
+    void serveLoop();
+    void writeFile(const std::string& text);
+    void setError(const std::string& error);
+
+    const std::string target_;
+    const std::chrono::milliseconds interval_;
+    const bool serve_socket_;
+    std::vector<const IGenerator*> generators_;
+    std::thread thread_;
+    std::atomic<bool> running_{false};
+    std::atomic<uint64_t> exports_{0};
+    int listen_fd_{-1};
+
+    std::mutex wake_mutex_;
+    std::condition_variable wake_;
+
+    // Rate baseline, guarded by render_mutex_
+    std::mutex render_mutex_;
+    std::chrono::steady_clock::time_point last_render_;
+    std::vector<uint64_t> last_frames_;
+    std::map<SignalKey, uint64_t> last_signal_frames_;
+
+    mutable std::mutex error_mutex_;
+    std::string last_error_;
+};
+
+} // namespace serial_bus_generator
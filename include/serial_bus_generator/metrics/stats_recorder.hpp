@@ -0,0 +1,90 @@
+#pragma once
+
+#include "serial_bus_generator/messages/frame.hpp"
+#include "serial_bus_generator/metrics/generator_stats.hpp"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace serial_bus_generator {
+
+/**
+ * @brief Lock-free counters behind a generator's getStats()
+ *
+ * One thread at a time records; any thread may snapshot. Since there is a
+ * single writer, counters are bumped with a relaxed load and store instead
+ * of a locked read-modify-write, so recording costs about as much as a
+ * plain increment. A generator hosted on a ChannelRuntime may move between
+ * workers, but its ticks never overlap, which keeps it a single writer.
+ * Values in a snapshot are each exact but are not read as one transaction.
+ *
+ * Frames are counted per ARINC429 label field in a directly indexed table
+ * and per J1939 identifier in a small open-addressed one; frames beyond
+ * MAX_J1939_KEYS distinct identifiers only count towards the total.
+ */
+class StatsRecorder {
+public:
+    static constexpr size_t MAX_J1939_KEYS = 64;  // Power of two
+
+    StatsRecorder();
+
+    StatsRecorder(const StatsRecorder&) = delete;
+    StatsRecorder& operator=(const StatsRecorder&) = delete;
+
+    // Writer side
+    void addFrames(const Frame* frames, size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+            const Frame& frame = frames[i];
+            if (frame.type == MessageType::ARINC429) {
+                bump(arinc429_frames_[frame.id & 0xFF], 1);
+            } else {
+                addJ1939Frame((frame.id >> 8) & J1939_KEY_MASK);
+            }
+        }
+        bump(frames_, count);
+    }
+    void addTick() { bump(ticks_, 1); }
+    void addMissedDeadlines(uint64_t count) { bump(missed_deadlines_, count); }
+    void addDroppedFrames(uint64_t count) { bump(dropped_frames_, count); }
+    void addEncodeError() { bump(encode_errors_, 1); }
+    void recordLateness(std::chrono::nanoseconds lateness);
+
+    // Reader side, any thread
+    uint64_t getFrames() const { return frames_.load(std::memory_order_relaxed); }
+    uint64_t getTicks() const { return ticks_.load(std::memory_order_relaxed); }
+    uint64_t getMissedDeadlines() const { return missed_deadlines_.load(std::memory_order_relaxed); }
+    uint64_t getDroppedFrames() const { return dropped_frames_.load(std::memory_order_relaxed); }
+
+    // Fills every counter field of stats; channel, queue and elapsed time are left alone
+    void snapshot(GeneratorStats& stats) const;
+
+private:
+    static constexpr uint32_t J1939_KEY_MASK = 0x3FFFF;  // PGN field with the PDU1 destination
+    static constexpr uint32_t EMPTY_KEY = 0xFFFFFFFF;
+
+    static void bump(std::atomic<uint64_t>& counter, uint64_t count) {
+        counter.store(counter.load(std::memory_order_relaxed) + count, std::memory_order_relaxed);
+    }
+
+    void addJ1939Frame(uint32_t key);
+
+    struct J1939Slot {
+        std::atomic<uint32_t> key{EMPTY_KEY};  // Published after frames is first set
+        std::atomic<uint64_t> frames{0};
+    };
+
+    std::atomic<uint64_t> frames_{0};
+    std::atomic<uint64_t> ticks_{0};
+    std::atomic<uint64_t> missed_deadlines_{0};
+    std::atomic<uint64_t> dropped_frames_{0};
+    std::atomic<uint64_t> encode_errors_{0};
+    std::atomic<int64_t> last_lateness_ns_{0};
+    std::atomic<int64_t> max_lateness_ns_{0};
+    std::atomic<int64_t> total_lateness_ns_{0};
+    std::array<std::atomic<uint64_t>, 256> arinc429_frames_;
+    std::array<J1939Slot, MAX_J1939_KEYS> j1939_frames_;
+};
+
+} // namespace serial_bus_generator
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "serial_bus_generator/protocols/arinc429/arinc429_message.hpp"
+#include <cstddef>
+#include <cstdint>
+
+namespace serial_bus_generator {
+
+/**
+ * @brief Batch ARINC429 word encoder/decoder
+ *
+ * Converts arrays of (label, value, SSM) to 32-bit words and back, with
+ * SSE4.1 and AVX2 kernels chosen at runtime and a scalar fallback. Every
+ * kernel produces exactly the words and values of the per-message path.
+ */
+class ARINC429BatchCodec {
+public:
+    enum class Kernel {
+        SCALAR,
+        SSE41,
+        AVX2
+    };
+
+    // Defaults to the best kernel the CPU supports
+    ARINC429BatchCodec();
+    explicit ARINC429BatchCodec(Kernel kernel);
+
+    static Kernel bestKernel();
+    static bool isSupported(Kernel kernel);
+    Kernel getKernel() const { return kernel_; }
+
+    // Same words as ARINC429Message::encodeWord(). Throws
+    // MessageValidationError before writing anything if a label is invalid.
+    void encode(const ARINC429Label* labels, const float* values, const ARINC429SSM* ssms,
+                uint32_t* words, size_t count) const;
+
+    // Same values as ARINC429Message::getDecodedValue(). Words whose label is
+    // not recognised decode to NaN; returns how many there were.
+    size_t decode(const uint32_t* words, float* values, size_t count) const;
+
+    // Writes 1 for words with correct odd parity, 0 otherwise, and returns
+    // the number of words that failed
+    size_t verifyParity(const uint32_t* words, uint8_t* valid, size_t count) const;
+
+private:
+    Kernel kernel_;
+};
+
+} // namespace serial_bus_generator
\ No newline at end of file
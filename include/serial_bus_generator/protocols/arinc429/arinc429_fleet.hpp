@@ -0,0 +1,85 @@
+#pragma once
+
+#include "serial_bus_generator/core/counter_rng.hpp"
+#include "serial_bus_generator/messages/frame_batch.hpp"
+#include "serial_bus_generator/protocols/arinc429/arinc429_codec.hpp"
+#include "serial_bus_generator/protocols/arinc429/arinc429_generator.hpp"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace serial_bus_generator {
+
+/**
+ * @brief Flight state of many simulated aircraft in structure-of-arrays form
+ *
+ * Every aircraft flies a jittered copy of one route back and forth,
+ * starting at a random point of its cycle so the fleet does not move in
+ * lockstep. The layout is drawn from (channel, aircraft) counters, so a
+ * seed reproduces it. Each aircraft's current trajectory segment is
+ * unpacked into per-aircraft rates, so update() is a branch-free loop of
+ * multiply-adds over contiguous arrays; the trajectory itself is only
+ * consulted when an aircraft crosses into its next segment.
+ */
+class ARINC429Fleet {
+public:
+    static constexpr size_t MAX_AIRCRAFT = 65536;   // One channel per aircraft
+    static constexpr double ROUTE_SPREAD = 2.0;     // Endpoint jitter, degrees
+    static constexpr size_t ROUTE_SEGMENTS = 16;    // Per flight; keeps 10k trajectories small
+
+    ARINC429Fleet(size_t aircraft, const CounterRng& rng, uint16_t channel,
+                  const GeoPoint& origin = ARINC429Generator::START_POINT,
+                  const GeoPoint& destination = ARINC429Generator::END_POINT);
+
+    size_t size() const { return latitude_.size(); }
+
+    void update(std::chrono::nanoseconds delta_time);
+
+    // Appends one frame per aircraft for a scheduled label, aircraft i on
+    // channel first_channel + i. Throws for labels the simulation cannot fill.
+    void appendLabel(ARINC429Label label, uint64_t timestamp_ns, uint16_t first_channel,
+                     FrameBatch& batch);
+
+    double getLatitude(size_t aircraft) const { return latitude_[aircraft]; }
+    double getLongitude(size_t aircraft) const { return longitude_[aircraft]; }
+    double getAltitude(size_t aircraft) const { return altitude_[aircraft]; }
+    double getGroundSpeed(size_t aircraft) const { return ground_speed_[aircraft]; }
+    double getTrack(size_t aircraft) const { return track_[aircraft]; }
+    FlightPhase getPhase(size_t aircraft) const { return phase_[aircraft]; }
+
+private:
+    // Loads a segment of the aircraft's trajectory, 'elapsed' seconds in;
+    // past the last segment the aircraft is parked for its turnaround
+    void enterSegment(size_t aircraft, size_t segment, double elapsed);
+    void startFlight(size_t aircraft, double elapsed);
+
+    // Kinematic state, one element per aircraft
+    std::vector<double> latitude_;
+    std::vector<double> longitude_;
+    std::vector<double> altitude_;        // feet
+    std::vector<double> ground_speed_;    // knots
+    std::vector<double> track_;           // degrees true, 0 to 360
+    std::vector<double> latitude_rate_;   // Per second over the current segment
+    std::vector<double> longitude_rate_;
+    std::vector<double> climb_rate_;
+    std::vector<double> acceleration_;
+    std::vector<double> track_rate_;
+    std::vector<double> segment_left_;    // seconds
+    std::vector<uint32_t> segment_;
+    std::vector<FlightPhase> phase_;
+
+    // Current flight; the end points swap at every turnaround
+    std::vector<GeoPoint> origin_;
+    std::vector<GeoPoint> destination_;
+    std::vector<FlightTrajectory> trajectories_;
+
+    // Encoder scratch, reused by every appendLabel()
+    ARINC429BatchCodec codec_;
+    std::vector<ARINC429Label> labels_;
+    std::vector<float> values_;
+    std::vector<ARINC429SSM> ssms_;
+    std::vector<uint32_t> words_;
+};
+
+} // namespace serial_bus_generator
@@ -1,73 +1,83 @@
 #pragma once
 
 #include "serial_bus_generator/core/data_generator.hpp"
+#include "serial_bus_generator/core/transmit_schedule.hpp"
 #include "serial_bus_generator/protocols/arinc429/arinc429_message.hpp"
-#include <random>
-#include <map>
+#include "serial_bus_generator/protocols/arinc429/flight_trajectory.hpp"
+#include <memory>
 
 namespace serial_bus_generator {
-enum class FlightPhase {
-    STOPPED,
-    TAKEOFF,
-    CRUISE,
-    LANDING
-};
+
+class ARINC429Fleet;
 
 class ARINC429Generator : public DataGenerator {
 public:
     ARINC429Generator();
-    ~ARINC429Generator() override = default;
+    ~ARINC429Generator() override;
 
     std::vector<std::unique_ptr<IMessage>> generateMessages(
         std::chrono::milliseconds duration) override;
+    void generateFrames(std::chrono::milliseconds duration, FrameBatch& batch) override;
+
+    // Transmit interval of a scheduled label; change only while stopped
+    void setLabelPeriod(ARINC429Label label, std::chrono::nanoseconds period);
+
+    // End points of the route flown back and forth; defaults to START_POINT
+    // and END_POINT. Only while stopped; a fleet is laid out again.
+    void setRoute(const GeoPoint& origin, const GeoPoint& destination);
+
+    // Simulate this many aircraft instead of one; aircraft i transmits on
+    // channel getChannel() + i. Zero returns to single-aircraft mode. Change
+    // only while stopped, and size the frame buffer for a full tick's labels.
+    // The fleet is laid out from the seed and channel, and laid out again on
+    // start() if either has changed since.
+    void setFleetSize(size_t aircraft);
+    size_t getFleetSize() const;
+    const ARINC429Fleet* getFleet() const { return fleet_.get(); }
 
     FlightPhase current_phase_ = FlightPhase::STOPPED;
-    std::chrono::steady_clock::time_point phase_start_time_;
 
-    struct Coordinates {
-        double latitude;
-        double longitude;
-    };
+    using Coordinates = GeoPoint;
     // Flight parameters
     static constexpr double CRUISE_ALTITUDE = 35000.0;  // feet
-    static constexpr double TAKEOFF_RATE = 2000.0;      // feet per minute
+    static constexpr double TAKEOFF_RATE = 2000.0;      // feet per minute, also used to descend
     static constexpr double CRUISE_SPEED = 500.0;       // knots
-    static constexpr double PHASE_DURATION = 300.0;     // seconds per phase
-    const Coordinates START_POINT{47.6062, -122.3321};  // Seattle-Tacoma International
-    const Coordinates END_POINT{25.7959, -80.2870};     // Miami International
+    static constexpr double ACCELERATION = 50.0;        // knots per second
+    static constexpr double TURNAROUND_TIME = 300.0;    // seconds on the ground between flights
+    static constexpr Coordinates START_POINT{47.6062, -122.3321};  // Seattle-Tacoma International
+    static constexpr Coordinates END_POINT{25.7959, -80.2870};     // Miami International
+    static FlightProfile flightProfile();
+
+    // Flies the current leg, then turns around and flies it back
     void updateFlightState(std::chrono::milliseconds delta_time);
-    void transitionToNextPhase();
+    const FlightTrajectory& getTrajectory() const { return trajectory_; }
+    const FlightTrajectory::State& getFlightState() const { return cursor_.getState(); }
 
 protected:
-    void startGeneration() override;
-    void processMessages(std::vector<std::unique_ptr<IMessage>>&& messages) override;
+    void prepareGeneration() override;
+    // Labels, route and faults; a running plan keeps the fleet size, and a
+    // changed route is flown from the next departure
+    void applyPlan(const ChannelPlan& plan) override;
+    void processFrames(const FrameBatch& frames) override;
     std::string getLastMessage() override;
 
 private:
-    std::unique_ptr<ARINC429Message> generateLatitudeMessage();
-    std::unique_ptr<ARINC429Message> generateLongitudeMessage();
-    std::unique_ptr<ARINC429Message> generateStatusMessage();
-    std::unique_ptr<ARINC429Message> generateSpeedMessage();
-    std::unique_ptr<ARINC429Message> generateAltitudeMessage();
-    void calculateInitialTrack();
-
-    // State tracking for realistic data generation
-    struct FlightState {
-        double latitude{0.0};
-        double longitude{0.0};
-        double altitude{0.0};
-        double ground_speed{0.0};
-        double vertical_speed{0.0};
-        double track{0.0};
-    };
-
-    FlightState flight_state_;
-    std::mt19937 rng_;  // Random number generator
-    std::uniform_real_distribution<float> status_dist_;
-    std::map<ARINC429Label, std::chrono::steady_clock::time_point> last_updates_;
-    std::vector<std::string> last_messages_;
-
+    Frame generateLabelFrame(ARINC429Label label, uint64_t timestamp_ns) const;
+    void layoutFleet(size_t aircraft);
+    FlightTrajectory legTrajectory() const;
 
+    GeoPoint origin_{START_POINT};
+    GeoPoint destination_{END_POINT};
+    bool outbound_{true};  // Flying origin_ to destination_
+    FlightTrajectory trajectory_;
+    FlightTrajectory::Cursor cursor_;
+    double ground_time_{0.0};  // seconds since arrival
+    TransmitSchedule schedule_;
+    FaultSchedule faults_;
+    FrameBatch last_frames_;  // Formatted on demand by getLastMessage()
+    std::unique_ptr<ARINC429Fleet> fleet_;  // Null in single-aircraft mode
+    uint64_t fleet_seed_{0};      // Seed and channel the fleet was laid out with
+    uint16_t fleet_channel_{0};
 };
 
 } // namespace serial_bus_generator
\ No newline at end of file
@@ -0,0 +1,179 @@
+#pragma once
+
+#include "serial_bus_generator/protocols/arinc429/arinc429_message.hpp"
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+namespace serial_bus_generator {
+
+enum class ARINC429Format : uint8_t {
+    BNR,        // Binary, sign-magnitude when signed
+    BCD,        // Binary-coded decimal, 4 bits per digit
+    DISCRETE    // Bit field carried as an unsigned integer
+};
+
+/**
+ * @brief Coding of one label's 19-bit data field
+ *
+ * The magnitude is right-justified in the low `bits` bits. Signed labels
+ * carry the sign in the top data bit (bit 18). Values are clamped to
+ * [min_value, max_value] and truncated toward zero on encode.
+ */
+struct ARINC429LabelSpec {
+    ARINC429Label label;
+    ARINC429Format format;
+    uint8_t bits;
+    bool is_signed;
+    float resolution;   // Units per least significant bit (BCD: per count)
+    float min_value;
+    float max_value;
+};
+
+inline constexpr uint32_t ARINC429_DATA_MASK = 0x7FFFF;
+inline constexpr uint32_t ARINC429_SIGN_BIT = 0x40000;
+
+// Label database. A label not listed here is not supported.
+inline constexpr ARINC429LabelSpec ARINC429_LABEL_SPECS[] = {
+    // label                              format                  bits signed resolution              min        max
+    {ARINC429Label::LATITUDE,             ARINC429Format::BNR,      18, true,  180.0f / 262144.0f, -90.0f,    90.0f},
+    {ARINC429Label::LONGITUDE,            ARINC429Format::BNR,      18, true,  180.0f / 262144.0f, -179.999f, 179.999f},
+    {ARINC429Label::ALTITUDE,             ARINC429Format::BNR,      19, false, 0.125f,             0.0f,      65535.0f},
+    {ARINC429Label::GROUND_SPEED,         ARINC429Format::BNR,      19, false, 1.0f,               0.0f,      4095.0f},
+    {ARINC429Label::TRACK_HEADING,        ARINC429Format::BNR,      18, true,  180.0f / 262144.0f, -179.999f, 179.999f},
+    {ARINC429Label::VERTICAL_SPEED,       ARINC429Format::BNR,      18, true,  0.125f,             -32767.0f, 32767.0f},
+    {ARINC429Label::EQUIPMENT_STATUS,     ARINC429Format::DISCRETE, 19, false, 1.0f,               0.0f,      524287.0f},
+    {ARINC429Label::NAVIGATION_MODE,      ARINC429Format::DISCRETE, 19, false, 1.0f,               0.0f,      524287.0f},
+    {ARINC429Label::GPS_SATELLITE_STATUS, ARINC429Format::BCD,      19, false, 1.0f,               0.0f,      79999.0f},
+    {ARINC429Label::SYSTEM_CONFIG,        ARINC429Format::DISCRETE, 19, false, 1.0f,               0.0f,      524287.0f},
+};
+
+inline constexpr size_t ARINC429_LABEL_COUNT = sizeof(ARINC429_LABEL_SPECS) / sizeof(ARINC429_LABEL_SPECS[0]);
+
+constexpr size_t findLabelSpec(ARINC429Label label) {
+    for (size_t i = 0; i < ARINC429_LABEL_COUNT; ++i) {
+        if (ARINC429_LABEL_SPECS[i].label == label) {
+            return i;
+        }
+    }
+    return ARINC429_LABEL_COUNT;
+}
+
+constexpr bool labelSpecsAreConsistent() {
+    for (size_t i = 0; i < ARINC429_LABEL_COUNT; ++i) {
+        const ARINC429LabelSpec& spec = ARINC429_LABEL_SPECS[i];
+        const uint32_t field = static_cast<uint32_t>(spec.label) & 0xFF;
+        for (size_t j = i + 1; j < ARINC429_LABEL_COUNT; ++j) {
+            if ((static_cast<uint32_t>(ARINC429_LABEL_SPECS[j].label) & 0xFF) == field) {
+                return false;  // Two labels sharing one 8-bit label field
+            }
+        }
+        if (spec.bits > (spec.is_signed ? 18 : 19) || spec.min_value > spec.max_value ||
+            (!spec.is_signed && spec.min_value < 0.0f)) {
+            return false;
+        }
+        // The clamped range must fit the magnitude bits
+        const double limit = spec.format == ARINC429Format::BCD
+            ? 79999.0 : static_cast<double>((1u << spec.bits) - 1);
+        if (spec.max_value / spec.resolution > limit || -spec.min_value / spec.resolution > limit) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static_assert(labelSpecsAreConsistent(), "ARINC429 label database is inconsistent");
+
+/**
+ * @brief Compile-time codec for one label
+ */
+template <ARINC429Label L>
+struct ARINC429LabelTraits {
+    static constexpr size_t INDEX = findLabelSpec(L);
+    static_assert(INDEX < ARINC429_LABEL_COUNT, "Label is not in the ARINC429 label database");
+
+    static constexpr ARINC429LabelSpec SPEC = ARINC429_LABEL_SPECS[INDEX];
+    static constexpr uint32_t MAGNITUDE_MASK = (1u << SPEC.bits) - 1;
+    static constexpr float SCALE = 1.0f / SPEC.resolution;
+
+    // 19-bit data field for a value in engineering units
+    static uint32_t encode(float value) {
+        const float clamped = std::fmax(SPEC.min_value, std::fmin(SPEC.max_value, value));
+        if constexpr (SPEC.format == ARINC429Format::BCD) {
+            uint32_t count = static_cast<uint32_t>(std::fabs(clamped) * SCALE);
+            uint32_t field = 0;
+            for (uint32_t shift = 0; shift < 20; shift += 4) {
+                field |= (count % 10) << shift;
+                count /= 10;
+            }
+            return field & ARINC429_DATA_MASK;
+        } else if constexpr (SPEC.is_signed) {
+            const uint32_t magnitude = static_cast<uint32_t>(std::fabs(clamped) * SCALE) & MAGNITUDE_MASK;
+            return magnitude | (std::signbit(clamped) && magnitude ? ARINC429_SIGN_BIT : 0);
+        } else {
+            return static_cast<uint32_t>(clamped * SCALE) & MAGNITUDE_MASK;
+        }
+    }
+
+    // Value in engineering units for a 19-bit data field
+    static float decode(uint32_t field) {
+        if constexpr (SPEC.format == ARINC429Format::BCD) {
+            uint32_t count = 0;
+            for (int shift = 16; shift >= 0; shift -= 4) {
+                count = count * 10 + ((field >> shift) & 0xF);
+            }
+            return static_cast<float>(count) * SPEC.resolution;
+        } else if constexpr (SPEC.is_signed) {
+            const float magnitude = static_cast<float>(field & MAGNITUDE_MASK) * SPEC.resolution;
+            return (field & ARINC429_SIGN_BIT) ? -magnitude : magnitude;
+        } else {
+            return static_cast<float>(field & MAGNITUDE_MASK) * SPEC.resolution;
+        }
+    }
+};
+
+/**
+ * @brief Runtime dispatch entry for one 8-bit label field
+ */
+struct ARINC429LabelCodec {
+    using EncodeFn = uint32_t (*)(float);
+    using DecodeFn = float (*)(uint32_t);
+
+    const ARINC429LabelSpec* spec{nullptr};  // Null for unsupported label fields
+    EncodeFn encode{nullptr};
+    DecodeFn decode{nullptr};
+};
+
+namespace detail {
+
+template <size_t... I>
+constexpr std::array<ARINC429LabelCodec, 256> makeLabelDispatch(std::index_sequence<I...>) {
+    std::array<ARINC429LabelCodec, 256> table{};
+    ((table[static_cast<uint32_t>(ARINC429_LABEL_SPECS[I].label) & 0xFF] = ARINC429LabelCodec{
+        &ARINC429_LABEL_SPECS[I],
+        &ARINC429LabelTraits<ARINC429_LABEL_SPECS[I].label>::encode,
+        &ARINC429LabelTraits<ARINC429_LABEL_SPECS[I].label>::decode}), ...);
+    return table;
+}
+
+} // namespace detail
+
+// Indexed by the 8-bit label field of a word
+inline constexpr std::array<ARINC429LabelCodec, 256> ARINC429_LABEL_DISPATCH =
+    detail::makeLabelDispatch(std::make_index_sequence<ARINC429_LABEL_COUNT>{});
+
+// Codec for a full label value, or null if the label is not supported
+inline const ARINC429LabelCodec* findLabelCodec(ARINC429Label label) {
+    const ARINC429LabelCodec& codec = ARINC429_LABEL_DISPATCH[static_cast<uint16_t>(label) & 0xFF];
+    return codec.spec && codec.spec->label == label ? &codec : nullptr;
+}
+
+// Codec for the label field of a received word, or null if unsupported
+inline const ARINC429LabelCodec* findWordCodec(uint32_t word) {
+    const ARINC429LabelCodec& codec = ARINC429_LABEL_DISPATCH[word & 0xFF];
+    return codec.spec ? &codec : nullptr;
+}
+
+} // namespace serial_bus_generator
\ No newline at end of file
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "serial_bus_generator/messages/base_message.hpp"
+#include "serial_bus_generator/messages/frame.hpp"
+#include "serial_bus_generator/messages/text_buffer.hpp"
 #include <cstdint>
 #include <string>
 #include <vector>
@@ -33,24 +35,34 @@ enum class ARINC429SSM : uint8_t {
 class ARINC429Message : public BaseMessage {
 public:
     ARINC429Message(ARINC429Label label, float value, ARINC429SSM ssm);
+    explicit ARINC429Message(const Frame& frame);
     
     bool isValid() const override;
     std::vector<uint8_t> serialize() const override;
+    size_t serializeInto(uint8_t* out, size_t capacity) const override;
     std::string toString() const override;
+    void formatTo(TextBuffer& out) const;  // Appends the toString() text
     
     ARINC429Label getLabel() const { return label_; }
     ARINC429SSM getSSM() const { return ssm_; }
+    uint32_t getRawWord() const { return raw_data_; }
     float getDecodedValue() const;
     bool verifyParity() const;
+    Frame toFrame() const;
+
+    // Allocation-free encoding for the batch path; same word as the constructor
+    static uint32_t encodeWord(ARINC429Label label, float value, ARINC429SSM ssm);
+    static Frame encodeFrame(ARINC429Label label, float value, ARINC429SSM ssm,
+                             uint64_t timestamp_ns);
+    static Frame makeFrame(uint32_t word, uint64_t timestamp_ns);  // For an encoded word
 
 private:
     ARINC429Label label_;
     ARINC429SSM ssm_;
     uint32_t raw_data_;  // Full 32-bit word
     
-    void encodeValue(float value);
-    uint8_t calculateParity() const;
-    bool isValidLabel(ARINC429Label label) const;
+    static uint8_t calculateParity(uint32_t word);
+    static bool isValidLabel(ARINC429Label label);
 };
 
 } // namespace serial_bus_generator
\ No newline at end of file
@@ -0,0 +1,145 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace serial_bus_generator {
+
+enum class FlightPhase {
+    STOPPED,
+    TAKEOFF,
+    CRUISE,
+    LANDING
+};
+
+inline const char* flightPhaseName(FlightPhase phase) {
+    switch (phase) {
+        case FlightPhase::STOPPED: return "STOPPED";
+        case FlightPhase::TAKEOFF: return "TAKEOFF";
+        case FlightPhase::CRUISE: return "CRUISE";
+        case FlightPhase::LANDING: return "LANDING";
+    }
+    return "UNKNOWN";
+}
+
+struct GeoPoint {
+    double latitude;   // degrees
+    double longitude;  // degrees
+};
+
+/**
+ * @brief Vertical and speed profile of a flight
+ */
+struct FlightProfile {
+    double cruise_altitude{0.0};  // feet
+    double cruise_speed{0.0};     // knots
+    double climb_rate{0.0};       // feet per minute
+    double descent_rate{0.0};     // feet per minute
+    double acceleration{0.0};     // knots per second, also used to slow down
+};
+
+/**
+ * @brief Precomputed great-circle flight from origin to destination
+ *
+ * The route and the climb/cruise/descent profile are computed once and
+ * stored as segments over which every quantity changes at a constant rate.
+ * Altitude and ground speed are piecewise linear, so they are exact;
+ * position follows the great circle through the segment end points. A
+ * Cursor then moves along the flight with a few multiply-adds per step.
+ */
+class FlightTrajectory {
+public:
+    static constexpr double EARTH_RADIUS_NM = 3440.065;
+    static constexpr size_t DEFAULT_ROUTE_SEGMENTS = 64;
+
+    struct State {
+        double latitude{0.0};
+        double longitude{0.0};
+        double altitude{0.0};        // feet
+        double ground_speed{0.0};    // knots
+        double track{0.0};           // degrees true, 0 to 360
+        double vertical_speed{0.0};  // feet per minute
+        FlightPhase phase{FlightPhase::STOPPED};
+    };
+
+    struct Segment {
+        double start_time;  // seconds from departure
+        double duration;
+        State start;        // Rates below are per second
+        double latitude_rate;
+        double longitude_rate;
+        double climb_rate;
+        double acceleration;
+        double track_rate;
+    };
+
+    // The route is split into route_segments equal-time pieces on top of the
+    // profile's own break points. Throws std::invalid_argument for coincident
+    // end points or a profile without positive speed, rates and acceleration.
+    FlightTrajectory(const GeoPoint& origin, const GeoPoint& destination, const FlightProfile& profile,
+                     size_t route_segments = DEFAULT_ROUTE_SEGMENTS);
+
+    const GeoPoint& getOrigin() const { return origin_; }
+    const GeoPoint& getDestination() const { return destination_; }
+    double getDistance() const { return distance_; }  // nautical miles
+    double getDuration() const { return duration_; }  // seconds, departure to arrival
+    size_t getSegmentCount() const { return segments_.size(); }
+    const Segment& getSegment(size_t index) const { return segments_[index]; }
+
+    // Segment in flight at a time; getSegmentCount() from arrival on
+    size_t findSegment(double time) const;
+
+    // State at any time; parked at the destination from arrival on
+    State stateAt(double time) const;
+
+    // State 'elapsed' seconds into a segment
+    static State advanceWithin(const Segment& segment, double elapsed);
+
+    /**
+     * @brief Walks a trajectory forward in time
+     */
+    class Cursor {
+    public:
+        explicit Cursor(const FlightTrajectory& trajectory, double start_time = 0.0);
+
+        void advance(double delta_seconds);
+
+        const State& getState() const { return state_; }
+        double getTime() const { return time_; }
+        bool isFinished() const { return segment_ == trajectory_->getSegmentCount(); }
+
+    private:
+        const FlightTrajectory* trajectory_;
+        size_t segment_;
+        double time_;
+        double segment_left_;  // seconds
+        State state_;
+    };
+
+private:
+    State exactState(double time) const;
+    State arrivalState() const;
+
+    GeoPoint origin_;
+    GeoPoint destination_;
+    FlightProfile profile_;
+    double distance_;
+    double duration_;
+
+    // Great-circle basis: position at central angle a is cos(a)*u + sin(a)*v
+    double central_angle_;
+    double u_[3];
+    double v_[3];
+
+    // Profile break points, seconds
+    double accelerate_end_;
+    double decelerate_start_;
+    double climb_end_;
+    double descent_start_;
+    double peak_speed_;     // knots; below cruise speed on short routes
+    double peak_altitude_;  // feet; below cruise altitude on short routes
+
+    std::vector<Segment> segments_;
+};
+
+} // namespace serial_bus_generator
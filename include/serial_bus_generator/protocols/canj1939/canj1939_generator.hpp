@@ -1,29 +1,52 @@
 #pragma once
 
 #include "serial_bus_generator/core/data_generator.hpp"
+#include "serial_bus_generator/core/transmit_schedule.hpp"
 #include "serial_bus_generator/protocols/canj1939/canj1939_message.hpp"
-#include <random>
-#include <map>
+#include "serial_bus_generator/protocols/canj1939/canj1939_transport.hpp"
 
 namespace serial_bus_generator {
 
 class CANJ1939Generator : public DataGenerator {
 public:
     CANJ1939Generator();
-    ~CANJ1939Generator() override = default;
+    ~CANJ1939Generator() override;
 
+    // Frames cut short by a BAD_LENGTH fault are left out
     std::vector<std::unique_ptr<IMessage>> generateMessages(
         std::chrono::milliseconds duration) override;
+    void generateFrames(std::chrono::milliseconds duration, FrameBatch& batch) override;
+
+    static constexpr uint8_t SOURCE_ADDRESS = 0xFE;  // Source of the generator's own PGNs
+
+    // Transmit interval of a scheduled PGN; change only while stopped
+    void setPGNPeriod(CANJ1939PGN pgn, std::chrono::nanoseconds period);
+
+    // Queues a multi-packet transfer sent from the next tick on; BAM when the
+    // destination is the global address, RTS/CTS otherwise. Only while stopped.
+    void queueTransfer(CANJ1939PGN pgn, const std::vector<uint8_t>& payload,
+                       uint8_t source, uint8_t destination);
+    void setTransportTiming(const J1939TransportTiming& timing);  // Only while stopped
+    const J1939TransportScheduler& getTransport() const { return transport_; }
 
 protected:
-    void startGeneration() override;
-    void processMessages(std::vector<std::unique_ptr<IMessage>>&& messages) override;
+    void prepareGeneration() override;
+    // PGNs, engine noise and faults
+    void applyPlan(const ChannelPlan& plan) override;
+    void processFrames(const FrameBatch& frames) override;
     std::string getLastMessage() override;
 
 private:
-    std::unique_ptr<CANJ1939Message> generateEngineSpeedMessage();
-    std::unique_ptr<CANJ1939Message> generateEngineTemperatureMessage();
-    std::unique_ptr<CANJ1939Message> generateEngineHoursMessage();
+    Frame generatePGNFrame(CANJ1939PGN pgn, uint64_t timestamp_ns) const;
+    // Payload of a PGN sent with the transport protocol; returns its size
+    size_t buildPayload(CANJ1939PGN pgn, uint8_t* out) const;
+
+    struct PendingTransfer {
+        CANJ1939PGN pgn;
+        std::vector<uint8_t> payload;
+        uint8_t source;
+        uint8_t destination;
+    };
 
     struct EngineState {
         double rpm{0.0};
@@ -33,12 +56,20 @@ private:
         bool running{false};
     };
 
+    static constexpr float TEMPERATURE_DRIFT = 2.0f;  // Celsius per second, either way
+    static constexpr float RPM_JITTER = 50.0f;        // Per tick, either way
+    static constexpr uint8_t BAD_LENGTH_DLC = 4;      // Truncated frames under a BAD_LENGTH fault
+
     EngineState engine_state_;
-    std::mt19937 rng_;
-    std::uniform_real_distribution<float> temp_variation_;
-    std::uniform_real_distribution<float> rpm_variation_;
-    std::map<CANJ1939PGN, std::chrono::steady_clock::time_point> last_updates_;
-    std::string last_message_;
+    float temperature_drift_{TEMPERATURE_DRIFT};
+    float rpm_jitter_{RPM_JITTER};
+    uint64_t tick_index_{0};  // Random-stream counter, restarted on start()
+    TransmitSchedule schedule_;
+    FaultSchedule faults_;
+    J1939TransportScheduler transport_;
+    std::vector<PendingTransfer> pending_transfers_;
+    Frame last_frame_;  // Formatted on demand by getLastMessage()
+    bool has_last_frame_{false};
 };
 
 } // namespace serial_bus_generator
\ No newline at end of file
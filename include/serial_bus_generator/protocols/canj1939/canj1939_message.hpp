@@ -1,6 +1,9 @@
 #pragma once
 
 #include "serial_bus_generator/messages/base_message.hpp"
+#include "serial_bus_generator/messages/frame.hpp"
+#include "serial_bus_generator/messages/text_buffer.hpp"
+#include <array>
 #include <cstdint>
 #include <string>
 #include <vector>
@@ -12,7 +15,11 @@ enum class CANJ1939PGN : uint32_t {
     ENGINE_TEMPERATURE = 65262, // 0xFEEE
     ENGINE_HOURS = 65253,      // 0xFEE5
     ENGINE_FLUID_LEVEL = 65263, // 0xFEEF
-    ENGINE_CONFIG = 65251       // 0xFEE3
+    ENGINE_CONFIG = 65251,      // 0xFEE3, 39 bytes: sent with the transport protocol
+    DM1 = 65226,                // 0xFECA, active diagnostic trouble codes
+    COMPONENT_ID = 65259,       // 0xFEEB, "make*model*serial*unit*"
+    TP_CM = 60416,              // 0xEC00, transport protocol connection management
+    TP_DT = 60160               // 0xEB00, transport protocol data transfer
 };
 
 enum class CANJ1939Priority : uint8_t {
@@ -39,24 +46,40 @@ enum class CANJ1939Priority : uint8_t {
 class CANJ1939Message : public BaseMessage {
 public:
     CANJ1939Message(CANJ1939PGN pgn, float value, CANJ1939Priority priority);
+    explicit CANJ1939Message(const Frame& frame);
     
     bool isValid() const override;
     std::vector<uint8_t> serialize() const override;
+    size_t serializeInto(uint8_t* out, size_t capacity) const override;
     std::string toString() const override;
+    void formatTo(TextBuffer& out) const;  // Appends the toString() text
     
     // J1939 specific methods
     CANJ1939PGN getPGN() const { return pgn_; }
     CANJ1939Priority getPriority() const { return priority_; }
     float getDecodedValue() const;
+    Frame toFrame() const;
+
+    // Allocation-free encoding for the batch path; same frame as toFrame()
+    static Frame encodeFrame(CANJ1939PGN pgn, float value, CANJ1939Priority priority,
+                             uint64_t timestamp_ns);
+
+    // Allocation-free decoding for the batch path; same value as getDecodedValue()
+    static float decodeValue(CANJ1939PGN pgn, const uint8_t* data);
+    static bool isValidPGN(CANJ1939PGN pgn);
+
+    // PGN carried by a 29-bit identifier. For PDU1 PGNs (PF < 240) the low
+    // byte of the identifier's PGN field is the destination address, not
+    // part of the PGN.
+    static CANJ1939PGN pgnFromIdentifier(uint32_t identifier);
 
 private:
     CANJ1939PGN pgn_;
     CANJ1939Priority priority_;
-    std::vector<uint8_t> data_;  // Raw data bytes
+    std::array<uint8_t, 8> data_{};  // Raw data bytes
     
-    void encodeValue(float value);
-    bool isValidPGN(CANJ1939PGN pgn) const;
-    uint32_t calculateIdentifier() const;
+    static void encodeValue(CANJ1939PGN pgn, float value, uint8_t* data);
+    static uint32_t calculateIdentifier(CANJ1939PGN pgn, CANJ1939Priority priority);
 };
 
 } // namespace serial_bus_generator
\ No newline at end of file
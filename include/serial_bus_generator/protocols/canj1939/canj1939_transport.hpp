@@ -0,0 +1,114 @@
+#pragma once
+
+#include "serial_bus_generator/messages/frame_batch.hpp"
+#include "serial_bus_generator/protocols/canj1939/canj1939_message.hpp"
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <unordered_map>
+#include <vector>
+
+namespace serial_bus_generator {
+
+struct J1939TransportTiming {
+    std::chrono::nanoseconds bam_packet_interval{50000000};  // J1939-21: 50-200 ms between BAM packets
+    std::chrono::nanoseconds rts_packet_interval{1000000};   // Between TP.DT packets of one CTS window
+    std::chrono::nanoseconds response_delay{5000000};        // Responder turnaround for CTS and EOM (< Tr)
+    uint8_t packets_per_cts{16};                             // Window the simulated responder grants
+    bool simulate_responder{true};  // Emit the destination's CTS and EndOfMsgAck frames
+};
+
+/**
+ * @brief J1939-21 transport protocol segmentation
+ *
+ * Splits payloads of 9 to 1785 bytes into a TP.CM announcement and TP.DT
+ * packets of 7 bytes each. Transfers to the global address are broadcast
+ * with BAM; others use RTS/CTS, with the destination's CTS and
+ * EndOfMsgAck frames simulated. Like the bus, a source runs one transfer
+ * per destination at a time; transfers to other destinations and from
+ * other sources overlap, and later ones to a busy destination wait.
+ * Frames are produced in time order, each stamped with its own due time.
+ */
+class J1939TransportScheduler {
+public:
+    static constexpr uint8_t CM_RTS = 16;
+    static constexpr uint8_t CM_CTS = 17;
+    static constexpr uint8_t CM_EOM_ACK = 19;
+    static constexpr uint8_t CM_BAM = 32;
+    static constexpr uint8_t GLOBAL_ADDRESS = 0xFF;
+    static constexpr size_t BYTES_PER_PACKET = 7;
+    static constexpr size_t MAX_PAYLOAD = 255 * BYTES_PER_PACKET;
+
+    explicit J1939TransportScheduler(const J1939TransportTiming& timing = J1939TransportTiming());
+
+    // Queues a transfer that starts at start_ns, or when the previous one
+    // between the same addresses finishes
+    void queue(CANJ1939PGN pgn, const uint8_t* data, size_t size, uint8_t source, uint8_t destination,
+               uint64_t start_ns, CANJ1939Priority priority = CANJ1939Priority::PRIORITY_7);
+
+    // Appends every frame due before end_ns
+    void advance(uint64_t end_ns, FrameBatch& batch, uint16_t channel = 0);
+
+    void reset();
+    size_t getActiveSessions() const { return heap_.size(); }
+    size_t getWaitingSessions() const { return waiting_count_; }
+    uint64_t getCompletedSessions() const { return completed_; }
+
+    // 29-bit identifier with the destination address in PDU1 format
+    static uint32_t makeIdentifier(CANJ1939Priority priority, CANJ1939PGN pgn,
+                                   uint8_t destination, uint8_t source);
+
+private:
+    enum class Step : uint8_t {
+        ANNOUNCE,  // TP.CM BAM or RTS
+        CTS,       // Destination grants the next window
+        DATA,      // TP.DT packet
+        ACK,       // Destination acknowledges the whole message
+        DONE
+    };
+
+    struct Session {
+        CANJ1939PGN pgn;
+        CANJ1939Priority priority;
+        uint8_t source;
+        uint8_t destination;
+        Step step;
+        uint16_t packets;
+        uint16_t next_packet;  // 1-based sequence number
+        uint16_t window_left;
+        uint64_t start_ns;
+        uint64_t due_ns;
+        std::vector<uint8_t> payload;  // Capacity is kept when the slot is reused
+    };
+
+    struct HeapEntry {
+        uint64_t due_ns;
+        uint64_t sequence;  // Keeps equal due times in queueing order
+        uint32_t session;
+        bool operator>(const HeapEntry& other) const {
+            return due_ns != other.due_ns ? due_ns > other.due_ns : sequence > other.sequence;
+        }
+    };
+
+    static uint16_t pairKey(const Session& session) {
+        return static_cast<uint16_t>((session.source << 8) | session.destination);
+    }
+
+    void activate(uint32_t index, uint64_t due_ns);
+    void finish(uint32_t index);
+    void emit(Session& session, FrameBatch& batch, uint16_t channel);
+    void pushControl(const Session& session, bool from_destination, const uint8_t (&data)[8],
+                     FrameBatch& batch, uint16_t channel) const;
+
+    J1939TransportTiming timing_;
+    std::vector<Session> sessions_;
+    std::vector<uint32_t> free_;
+    std::vector<HeapEntry> heap_;  // Min-heap of active sessions by due time
+    // Source/destination pairs with a transfer in progress, and the transfers waiting behind it
+    std::unordered_map<uint16_t, std::deque<uint32_t>> busy_pairs_;
+    size_t waiting_count_{0};
+    uint64_t sequence_{0};
+    uint64_t completed_{0};
+};
+
+} // namespace serial_bus_generator
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "serial_bus_generator/interfaces/frame_sink_interface.hpp"
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace serial_bus_generator {
+
+struct PcapngOptions {
+    uint64_t rotate_bytes{0};                     // Keep each file within this size; 0 = never rotate
+    std::chrono::nanoseconds rotate_interval{0};  // Start a new file after this much frame time; 0 = never
+    size_t buffer_bytes{1 << 20};                 // Bytes gathered before each write
+};
+
+/**
+ * @brief Sink that writes frames as a pcapng capture
+ *
+ * Each file has two interfaces with nanosecond timestamps: J1939 frames on
+ * a LINKTYPE_CAN_SOCKETCAN interface, so Wireshark's J1939 dissector reads
+ * them as extended CAN frames, and ARINC429 words (4 bytes, little-endian)
+ * on a LINKTYPE_USER0 interface. Blocks are built in one buffer while a
+ * background thread writes the previous one, so generation threads do not
+ * wait on the disk. With rotation enabled the files are named
+ * <stem>_00000<ext>, <stem>_00001<ext>, ... and each is a complete capture.
+ */
+class PcapngSink : public IFrameSink {
+public:
+    static constexpr uint16_t LINKTYPE_CAN_SOCKETCAN = 227;
+    static constexpr uint16_t LINKTYPE_USER0 = 147;
+    static constexpr uint32_t CAN_INTERFACE = 0;
+    static constexpr uint32_t ARINC429_INTERFACE = 1;
+    static constexpr uint32_t CAN_EFF_FLAG = 0x80000000;  // Extended (29-bit) identifier
+
+    explicit PcapngSink(const std::string& path, const PcapngOptions& options = PcapngOptions());
+    ~PcapngSink() override;
+
+    PcapngSink(const PcapngSink&) = delete;
+    PcapngSink& operator=(const PcapngSink&) = delete;
+
+    void write(const Frame* frames, size_t count) override;
+    void flush() override;  // Writes out buffered blocks and waits for the disk thread
+    void close();           // Implied by the destructor
+
+    uint64_t getFrameCount() const;
+    size_t getFileCount() const;
+
+    // Name of the index'th file for a base path when rotating
+    static std::string rotatedPath(const std::string& path, size_t index);
+
+private:
+    void appendHeaders();
+    void appendFrame(const Frame& frame);
+    void submit(std::unique_lock<std::mutex>& lock, bool rotate);  // Hands buffer_ to the disk thread
+    void ioLoop();
+    void openFile(const std::string& path);
+    void writeAll(const uint8_t* data, size_t size);
+
+    const std::string path_;
+    const PcapngOptions options_;
+    int fd_{-1};  // Owned by the disk thread while open
+
+    mutable std::mutex mutex_;
+    std::condition_variable pending_ready_;
+    std::condition_variable pending_done_;
+    std::vector<uint8_t> buffer_;   // Filled by producers
+    std::vector<uint8_t> pending_;  // Being written by the disk thread
+    bool has_pending_{false};
+    bool rotate_after_pending_{false};
+    bool closing_{false};
+    bool closed_{false};
+    std::exception_ptr io_error_;
+
+    uint64_t frame_count_{0};
+    uint64_t file_bytes_{0};       // Bytes in the current file, buffered or written
+    uint64_t file_frames_{0};
+    uint64_t file_start_ns_{0};    // Timestamp of the current file's first frame
+    size_t file_count_{1};
+    std::thread io_thread_;
+};
+
+} // namespace serial_bus_generator
@@ -0,0 +1,118 @@
+#pragma once
+
+#include "serial_bus_generator/interfaces/frame_sink_interface.hpp"
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace serial_bus_generator {
+
+/**
+ * @brief What a queued sink does with frames that arrive while its queue is full
+ */
+enum class OverrunPolicy {
+    BLOCK,        // Wait for room; the generation thread stalls with the sink
+    DROP_NEWEST,  // Discard the arriving frames
+    DROP_OLDEST,  // Discard the longest-queued frames to make room
+    COALESCE      // Keep only the latest queued frame per label or PGN, then drop the newest
+};
+
+struct QueuedSinkOptions {
+    OverrunPolicy policy{OverrunPolicy::BLOCK};
+    size_t capacity{16384};  // Queued frames
+};
+
+struct QueuedSinkStats {
+    uint64_t written{0};         // Handed to the wrapped sink
+    uint64_t dropped_newest{0};
+    uint64_t dropped_oldest{0};
+    uint64_t coalesced{0};       // Queued frames replaced by a newer one
+    uint64_t blocked_writes{0};  // Writes that had to wait for room
+    uint64_t failed{0};          // Frames the wrapped sink threw on
+    size_t queue_depth{0};
+    size_t max_queue_depth{0};
+
+    uint64_t dropped() const { return dropped_newest + dropped_oldest + coalesced + failed; }
+};
+
+/**
+ * @brief Sink that decouples a slow sink from the generation thread
+ *
+ * Frames written to it are queued and handed to the wrapped sink by a
+ * thread of its own, in batches, so a stalled file, socket or console only
+ * holds up its own queue. What happens when the queue is full is the
+ * sink's overrun policy, and every frame that is not delivered is counted.
+ * A coalescing queue that fills up drops every queued frame that has a
+ * newer one of the same signal behind it; the frames left keep their
+ * order, so timestamps never go backwards. Signals are ARINC 429 words by
+ * label and J1939 frames by identifier without the priority; J1939
+ * transport protocol frames are never coalesced, since each packet is part
+ * of a larger message.
+ *
+ * Several generators may share one queued sink. flush() waits for the
+ * queue to drain and then flushes the wrapped sink on the queue's thread.
+ */
+class QueuedSink : public IFrameSink {
+public:
+    static constexpr size_t MAX_BATCH = 256;  // Frames per write to the wrapped sink
+
+    explicit QueuedSink(std::shared_ptr<IFrameSink> sink, QueuedSinkOptions options = {});
+    ~QueuedSink() override;
+
+    QueuedSink(const QueuedSink&) = delete;
+    QueuedSink& operator=(const QueuedSink&) = delete;
+
+    void write(const Frame* frames, size_t count) override;
+    void flush() override;
+    void close();  // Delivers what is queued and stops the thread; implied by the destructor
+
+    OverrunPolicy getPolicy() const { return options_.policy; }
+    QueuedSinkStats getStats() const;
+    std::string getLastError() const;  // Of the wrapped sink, empty if it never threw
+
+    static const char* policyName(OverrunPolicy policy);
+    static OverrunPolicy parsePolicy(const std::string& name);  // "block", "drop-newest", ...
+
+private:
+    void run();
+    void push(const Frame& frame, std::unique_lock<std::mutex>& lock, bool& blocked);
+    bool coalesce(uint64_t key);  // Makes room in a full queue for a frame with this key
+    void discard(uint64_t seq);   // Leaves a coalesced frame in its slot for the thread to skip
+    void compact();               // Closes the gaps of discarded frames
+    size_t depth() const { return static_cast<size_t>(head_ - tail_); }  // Including discarded frames
+    size_t queuedFrames() const { return depth() - discarded_; }
+
+    // Coalescing key, or NO_KEY for frames that are always queued
+    static constexpr uint64_t NO_KEY = UINT64_MAX;
+    static uint64_t coalesceKey(const Frame& frame);
+
+    std::shared_ptr<IFrameSink> sink_;
+    const QueuedSinkOptions options_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable not_empty_;
+    std::condition_variable not_full_;
+    std::condition_variable idle_;
+    std::vector<Frame> ring_;  // Twice the capacity when coalescing, so discarded frames can wait for the thread
+    std::vector<bool> discarded_slots_;
+    size_t discarded_{0};  // Discarded frames still in the ring
+    uint64_t head_{0};  // Sequence of the next frame queued
+    uint64_t tail_{0};  // Sequence of the oldest frame still queued
+    std::unordered_map<uint64_t, uint64_t> queued_;  // Coalescing key -> sequence of its latest frame
+    std::vector<uint64_t> superseded_;  // Sequences of frames with a newer one of their signal queued
+    size_t in_flight_{0};  // Taken by the thread, not yet written
+    uint64_t flush_requests_{0};
+    uint64_t flushes_done_{0};
+    bool dirty_{false};  // Written since the wrapped sink was last flushed
+    bool closing_{false};
+    QueuedSinkStats stats_;
+    std::string last_error_;
+    std::thread thread_;
+};
+
+} // namespace serial_bus_generator
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "serial_bus_generator/interfaces/frame_sink_interface.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace serial_bus_generator {
+
+/**
+ * @brief Sink that transmits J1939 frames on a Linux SocketCAN interface
+ *
+ * Each frame goes out as a struct can_frame with its 29-bit identifier and
+ * CAN_EFF_FLAG set. A tick's frames are sent in batches with one
+ * sendmmsg() call each. When the interface's TX queue is full the sink
+ * waits up to the send timeout for room, then drops what is left of the
+ * tick; both cases are counted. Frames of other protocols are ignored.
+ * Works with virtual interfaces (ip link add dev vcan0 type vcan).
+ */
+class SocketCanSink : public IFrameSink {
+public:
+    static constexpr size_t MAX_BATCH = 64;  // Frames per sendmmsg() call
+    static constexpr std::chrono::milliseconds DEFAULT_SEND_TIMEOUT{10};
+    static constexpr size_t CAN_FRAME_SIZE = 16;  // sizeof(struct can_frame)
+
+    // Opens a raw CAN socket bound to the named interface
+    explicit SocketCanSink(const std::string& interface_name,
+                           std::chrono::milliseconds send_timeout = DEFAULT_SEND_TIMEOUT);
+    // Takes ownership of an already connected datagram socket
+    explicit SocketCanSink(int socket_fd, std::chrono::milliseconds send_timeout = DEFAULT_SEND_TIMEOUT);
+    ~SocketCanSink() override;
+
+    SocketCanSink(const SocketCanSink&) = delete;
+    SocketCanSink& operator=(const SocketCanSink&) = delete;
+
+    void write(const Frame* frames, size_t count) override;
+    void flush() override {}  // Frames are sent as they are written
+
+    uint64_t getSentFrames() const { return sent_; }
+    uint64_t getDroppedFrames() const { return dropped_; }
+    uint64_t getBackpressureEvents() const { return backpressure_; }  // Ticks that found the TX queue full
+    uint64_t getSendCalls() const { return send_calls_; }
+
+    // Fills a struct can_frame (CAN_FRAME_SIZE bytes) for a J1939 frame
+    static void toCanFrame(const Frame& frame, uint8_t* out);
+
+private:
+    struct Batch;
+
+    // False once the tick's send timeout has passed; the batch's unsent frames are dropped
+    bool sendBatch(size_t count, std::chrono::steady_clock::time_point& deadline);
+    void dropRest(const Frame* frames, size_t count);
+    void waitForRoom(int error);
+
+    int fd_;
+    const std::chrono::milliseconds send_timeout_;
+    std::unique_ptr<Batch> batch_;
+    std::atomic<uint64_t> sent_{0};
+    std::atomic<uint64_t> dropped_{0};
+    std::atomic<uint64_t> backpressure_{0};
+    std::atomic<uint64_t> send_calls_{0};
+};
+
+} // namespace serial_bus_generator
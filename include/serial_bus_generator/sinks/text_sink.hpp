@@ -0,0 +1,39 @@
+#pragma once
+
+#include "serial_bus_generator/interfaces/frame_sink_interface.hpp"
+#include "serial_bus_generator/messages/text_buffer.hpp"
+#include <cstdio>
+
+namespace serial_bus_generator {
+
+/**
+ * @brief Sink that renders frames as one line of text each
+ *
+ * Lines read "[<protocol>] <message text>" and are collected in a reusable
+ * buffer that is written out in large chunks, so no per-frame allocation
+ * or stream formatting takes place.
+ */
+class TextSink : public IFrameSink {
+public:
+    static constexpr size_t FLUSH_THRESHOLD = 64 * 1024;
+
+    explicit TextSink(std::FILE* out);
+    ~TextSink() override;
+
+    TextSink(const TextSink&) = delete;
+    TextSink& operator=(const TextSink&) = delete;
+
+    void write(const Frame* frames, size_t count) override;
+    void flush() override;
+
+    // Appends the line for one frame, without the newline
+    static void formatFrame(const Frame& frame, TextBuffer& out);
+
+private:
+    void writeOut();
+
+    std::FILE* out_;
+    TextBuffer text_;
+};
+
+} // namespace serial_bus_generator
@@ -0,0 +1,134 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <ostream>
+#include <string>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#else
+#include <chrono>
+#endif
+
+namespace serial_bus_generator {
+
+/**
+ * @brief One recorded trace event
+ *
+ * Scopes are recorded once, when they end, as a complete event with their
+ * start and duration, so a ring that wraps never leaves an unmatched begin
+ * or end behind. Names and details must be string literals.
+ */
+struct TraceEvent {
+    uint64_t start;     // Tracer::now() ticks
+    uint64_t duration;  // 0 for instant events
+    const char* name;
+    const char* detail;    // Optional
+    int64_t value;         // Optional
+    uint16_t channel;      // Optional
+    bool instant;
+};
+
+/**
+ * @brief Process-wide recorder of per-thread trace events
+ *
+ * Each thread that records gets its own ring of events on first use, so
+ * recording takes no lock: a clock read and a store into the thread's
+ * ring. On x86 the clock is the time-stamp counter, which is cheaper to
+ * read than the steady clock; ticks are converted to time against the
+ * steady clock when the trace is written. When a ring is full the oldest
+ * events are overwritten. Rings stay registered after their thread exits
+ * so a run can be dumped after its threads have been joined.
+ *
+ * Instrumentation uses the SBG_TRACE_* macros, which compile to nothing
+ * unless the build defines SBG_ENABLE_TRACING (CMake option of the same
+ * name). Compiled in, recording still only happens while enabled.
+ */
+class Tracer {
+public:
+    static constexpr size_t DEFAULT_EVENTS_PER_THREAD = 16384;
+    static constexpr uint16_t NO_CHANNEL = 0xFFFF;
+    static constexpr int64_t NO_VALUE = std::numeric_limits<int64_t>::min();
+#ifdef SBG_ENABLE_TRACING
+    static constexpr bool COMPILED_IN = true;
+#else
+    static constexpr bool COMPILED_IN = false;
+#endif
+
+    static void setEnabled(bool enabled);
+    static bool isEnabled() { return enabled_.load(std::memory_order_relaxed); }
+
+    // Ring size of threads that start recording afterwards; rounded up to a power of two
+    static void setEventsPerThread(size_t events);
+
+    // Trace clock ticks
+    static uint64_t now() {
+#if defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#else
+        return static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+    }
+
+    static void recordScope(const char* name, uint16_t channel, uint64_t start);
+    static void recordInstant(const char* name, uint16_t channel, const char* detail, int64_t value);
+
+    // The rest only while no traced thread is recording, e.g. after stopping the generators
+    static void clear();
+    static size_t getEventCount();
+    static uint64_t getOverwrittenEvents();
+
+    // Chrome trace event JSON, which Perfetto and chrome://tracing both open
+    static void writeChromeJson(std::ostream& out);
+    static void writeChromeJson(const std::string& path);
+
+private:
+    static std::atomic<bool> enabled_;
+};
+
+/**
+ * @brief Records the enclosing scope as one trace event
+ */
+class TraceScope {
+public:
+    TraceScope(const char* name, uint16_t channel)
+        : name_(name)
+        , channel_(channel)
+        , start_(Tracer::isEnabled() ? Tracer::now() : 0)
+    {}
+
+    ~TraceScope() {
+        if (start_ != 0) {
+            Tracer::recordScope(name_, channel_, start_);
+        }
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    const char* name_;
+    uint16_t channel_;
+    uint64_t start_;
+};
+
+} // namespace serial_bus_generator
+
+#ifdef SBG_ENABLE_TRACING
+#define SBG_TRACE_CONCAT_(a, b) a##b
+#define SBG_TRACE_CONCAT(a, b) SBG_TRACE_CONCAT_(a, b)
+#define SBG_TRACE_SCOPE(name, channel) \
+    ::serial_bus_generator::TraceScope SBG_TRACE_CONCAT(sbg_trace_scope_, __LINE__)(name, channel)
+#define SBG_TRACE_INSTANT(name, channel, detail, value)                                    \
+    do {                                                                                   \
+        if (::serial_bus_generator::Tracer::isEnabled()) {                                 \
+            ::serial_bus_generator::Tracer::recordInstant(name, channel, detail, value);   \
+        }                                                                                  \
+    } while (0)
+#else
+#define SBG_TRACE_SCOPE(name, channel) static_cast<void>(0)
+#define SBG_TRACE_INSTANT(name, channel, detail, value) static_cast<void>(0)
+#endif
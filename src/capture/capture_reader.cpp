@@ -0,0 +1,123 @@
+#include "serial_bus_generator/capture/capture_reader.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <system_error>
+#include <unistd.h>
+
+namespace serial_bus_generator {
+
+CaptureReader::CaptureReader(const std::string& path) {
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        throw std::system_error(errno, std::generic_category(), "Cannot open capture file " + path);
+    }
+
+    struct stat st{};
+    if (::fstat(fd, &st) != 0) {
+        const int error = errno;
+        ::close(fd);
+        throw std::system_error(error, std::generic_category(), "Cannot stat capture file " + path);
+    }
+    size_ = static_cast<size_t>(st.st_size);
+    if (size_ < sizeof(CaptureFileHeader)) {
+        ::close(fd);
+        throw std::runtime_error("Capture file is truncated: " + path);
+    }
+
+    void* mapping = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+    const int map_error = errno;
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        throw std::system_error(map_error, std::generic_category(), "Cannot map capture file " + path);
+    }
+    base_ = static_cast<const uint8_t*>(mapping);
+    header_ = reinterpret_cast<const CaptureFileHeader*>(base_);
+
+    auto fail = [&](const char* reason) {
+        ::munmap(const_cast<uint8_t*>(base_), size_);
+        throw std::runtime_error(std::string(reason) + ": " + path);
+    };
+
+    if (std::memcmp(header_->magic, CAPTURE_MAGIC, sizeof(CAPTURE_MAGIC)) != 0) {
+        fail("Not a capture file");
+    }
+    if (header_->version != CAPTURE_VERSION || header_->record_size != sizeof(Frame)) {
+        fail("Unsupported capture version");
+    }
+    if (header_->index_offset == 0) {
+        fail("Capture file was not closed");
+    }
+    const uint64_t channels_end = sizeof(CaptureFileHeader) +
+        static_cast<uint64_t>(header_->channel_count) * sizeof(CaptureChannelInfo);
+    const uint64_t index_end = header_->index_offset +
+        static_cast<uint64_t>(header_->block_count) * sizeof(CaptureBlockIndex);
+    if (channels_end > header_->data_offset || header_->data_offset > header_->index_offset ||
+        index_end > size_ || header_->index_offset % alignof(CaptureBlockIndex) != 0) {
+        fail("Capture file is truncated");
+    }
+
+    channels_ = reinterpret_cast<const CaptureChannelInfo*>(base_ + sizeof(CaptureFileHeader));
+    index_ = reinterpret_cast<const CaptureBlockIndex*>(base_ + header_->index_offset);
+    for (size_t block = 0; block < header_->block_count; ++block) {
+        const CaptureBlockIndex& entry = index_[block];
+        if (entry.offset < header_->data_offset ||
+            entry.offset + static_cast<uint64_t>(entry.record_count) * sizeof(Frame) > header_->index_offset) {
+            fail("Capture block index is corrupt");
+        }
+    }
+
+    // Records are read front to back
+    ::madvise(const_cast<uint8_t*>(base_), size_, MADV_SEQUENTIAL);
+}
+
+CaptureReader::~CaptureReader() {
+    ::munmap(const_cast<uint8_t*>(base_), size_);
+}
+
+const Frame* CaptureReader::getBlockRecords(size_t block) const {
+    if (block >= getBlockCount()) {
+        throw std::out_of_range("Capture block out of range");
+    }
+    return reinterpret_cast<const Frame*>(base_ + index_[block].offset);
+}
+
+void CaptureReader::prefetchBlocks(size_t first, size_t count) const {
+    advise(first, count, MADV_WILLNEED);
+}
+
+void CaptureReader::releaseBlocks(size_t first, size_t count) const {
+    advise(first, count, MADV_DONTNEED);
+}
+
+void CaptureReader::advise(size_t first, size_t count, int advice) const {
+    const size_t last = std::min(first + count, getBlockCount());
+    if (first >= last) {
+        return;
+    }
+    // Whole pages inside the blocks, so neighbouring blocks are not affected
+    static const size_t page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+    const size_t begin = index_[first].offset;
+    const size_t end = index_[last - 1].offset + index_[last - 1].record_count * sizeof(Frame);
+    const size_t aligned_begin = advice == MADV_DONTNEED ? (begin + page - 1) / page * page : begin / page * page;
+    const size_t aligned_end = advice == MADV_DONTNEED ? end / page * page : std::min((end + page - 1) / page * page, size_);
+    if (aligned_begin < aligned_end) {
+        ::madvise(const_cast<uint8_t*>(base_) + aligned_begin, aligned_end - aligned_begin, advice);
+    }
+}
+
+size_t CaptureReader::findBlock(uint64_t timestamp_ns) const {
+    // max_before_ns never decreases, so the first block whose running
+    // maximum reaches the timestamp is the earliest that can match
+    const CaptureBlockIndex* end = index_ + getBlockCount();
+    const CaptureBlockIndex* it = std::partition_point(index_, end, [timestamp_ns](const CaptureBlockIndex& entry) {
+        return entry.max_before_ns < timestamp_ns;
+    });
+    return static_cast<size_t>(it - index_);
+}
+
+} // namespace serial_bus_generator
@@ -0,0 +1,241 @@
+#include "serial_bus_generator/capture/capture_writer.hpp"
+#include "serial_bus_generator/core/timed_wait.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <limits>
+#include <stdexcept>
+#include <system_error>
+#include <unistd.h>
+
+namespace serial_bus_generator {
+
+CaptureWriter::CaptureWriter(const std::string& path, const std::vector<CaptureChannelInfo>& channels,
+                             size_t block_records)
+    : block_records_(block_records)
+{
+    if (block_records_ == 0 || block_records_ > std::numeric_limits<uint32_t>::max()) {
+        throw std::invalid_argument("Invalid capture block size");
+    }
+
+    fd_ = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd_ < 0) {
+        throw std::system_error(errno, std::generic_category(), "Cannot create capture file " + path);
+    }
+
+    std::memcpy(header_.magic, CAPTURE_MAGIC, sizeof(header_.magic));
+    header_.version = CAPTURE_VERSION;
+    header_.record_size = sizeof(Frame);
+    header_.channel_count = static_cast<uint32_t>(channels.size());
+    header_.data_offset = sizeof(CaptureFileHeader) + channels.size() * sizeof(CaptureChannelInfo);
+    header_.first_ns = std::numeric_limits<uint64_t>::max();
+
+    try {
+        writeAll(&header_, sizeof(header_));
+        writeAll(channels.data(), channels.size() * sizeof(CaptureChannelInfo));
+    } catch (...) {
+        ::close(fd_);
+        throw;
+    }
+
+    current_.reserve(block_records_);
+    for (size_t i = 1; i < BLOCK_POOL; ++i) {
+        free_.emplace_back();
+        free_.back().reserve(block_records_);
+    }
+    io_thread_ = std::thread(&CaptureWriter::ioLoop, this);
+}
+
+CaptureWriter::~CaptureWriter() {
+    try {
+        close();
+    } catch (...) {
+        // Destructors must not throw; call close() to see write errors
+    }
+}
+
+void CaptureWriter::write(const Frame* frames, size_t count) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (closed_) {
+        throw std::logic_error("Capture writer is closed");
+    }
+    rethrowIoError();
+
+    while (count > 0) {
+        const size_t n = std::min(count, block_records_ - current_.size());
+        current_.insert(current_.end(), frames, frames + n);
+        record_count_ += n;
+        frames += n;
+        count -= n;
+
+        if (current_.size() == block_records_) {
+            // Wait for the disk thread to hand back a block
+            waitUntil(block_free_, lock, [this] { return !free_.empty() || io_error_; });
+            rethrowIoError();
+            // Another writer may have submitted it while this one waited
+            if (current_.size() == block_records_) {
+                submitCurrent();
+            }
+        }
+    }
+}
+
+void CaptureWriter::flush() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (closed_) {
+        return;
+    }
+    if (!current_.empty()) {
+        waitUntil(block_free_, lock, [this] { return !free_.empty() || io_error_; });
+        rethrowIoError();
+        if (!current_.empty()) {
+            submitCurrent();
+        }
+    }
+    waitUntil(block_free_, lock, [this] { return (full_.empty() && in_flight_ == 0) || io_error_; });
+    rethrowIoError();
+}
+
+void CaptureWriter::close() {
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (closed_) {
+            return;
+        }
+        closed_ = true;
+        if (!current_.empty() && !io_error_) {
+            waitUntil(block_free_, lock, [this] { return !free_.empty() || io_error_; });
+            if (!io_error_ && !current_.empty()) {
+                submitCurrent();
+            }
+        }
+        closing_ = true;
+        block_ready_.notify_one();
+    }
+    io_thread_.join();
+
+    std::exception_ptr error = io_error_;
+    if (!error) {
+        try {
+            // Each block learns the earliest timestamp at or after it so
+            // readers can stop scanning a time range early
+            uint64_t min_after = std::numeric_limits<uint64_t>::max();
+            for (auto it = index_.rbegin(); it != index_.rend(); ++it) {
+                min_after = std::min(min_after, it->min_ns);
+                it->min_after_ns = min_after;
+            }
+
+            header_.index_offset = file_offset_;
+            header_.block_count = static_cast<uint32_t>(index_.size());
+            header_.record_count = record_count_;
+            if (record_count_ == 0) {
+                header_.first_ns = 0;
+            }
+            writeAll(index_.data(), index_.size() * sizeof(CaptureBlockIndex));
+            if (::pwrite(fd_, &header_, sizeof(header_), 0) != static_cast<ssize_t>(sizeof(header_))) {
+                throw std::system_error(errno, std::generic_category(), "Capture header write failed");
+            }
+        } catch (...) {
+            error = std::current_exception();
+        }
+    }
+
+    ::close(fd_);
+    fd_ = -1;
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+uint64_t CaptureWriter::getRecordCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return record_count_;
+}
+
+CaptureChannelInfo CaptureWriter::makeChannelInfo(uint16_t channel, MessageType type,
+                                                  uint32_t rate_hz, const std::string& name) {
+    CaptureChannelInfo info{};
+    info.channel = channel;
+    info.type = type;
+    info.rate_hz = rate_hz;
+    std::strncpy(info.name, name.c_str(), sizeof(info.name) - 1);
+    return info;
+}
+
+void CaptureWriter::submitCurrent() {
+    full_.push_back(std::move(current_));
+    current_ = std::move(free_.back());
+    free_.pop_back();
+    current_.clear();
+    block_ready_.notify_one();
+}
+
+void CaptureWriter::rethrowIoError() {
+    if (io_error_) {
+        std::rethrow_exception(io_error_);
+    }
+}
+
+void CaptureWriter::ioLoop() {
+    uint64_t max_before = 0;
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        waitUntil(block_ready_, lock, [this] { return !full_.empty() || closing_; });
+        if (full_.empty()) {
+            return;
+        }
+        std::vector<Frame> block = std::move(full_.front());
+        full_.pop_front();
+        ++in_flight_;
+        lock.unlock();
+
+        CaptureBlockIndex entry{};
+        entry.offset = file_offset_;
+        entry.record_count = static_cast<uint32_t>(block.size());
+        entry.min_ns = std::numeric_limits<uint64_t>::max();
+        for (const Frame& frame : block) {
+            entry.min_ns = std::min(entry.min_ns, frame.timestamp_ns);
+            entry.max_ns = std::max(entry.max_ns, frame.timestamp_ns);
+        }
+        max_before = std::max(max_before, entry.max_ns);
+        entry.max_before_ns = max_before;
+
+        std::exception_ptr error;
+        try {
+            writeAll(block.data(), block.size() * sizeof(Frame));
+            index_.push_back(entry);
+            header_.first_ns = std::min(header_.first_ns, entry.min_ns);
+            header_.last_ns = max_before;
+        } catch (...) {
+            error = std::current_exception();
+        }
+
+        lock.lock();
+        --in_flight_;
+        if (error && !io_error_) {
+            io_error_ = error;
+        }
+        free_.push_back(std::move(block));
+        block_free_.notify_all();
+    }
+}
+
+void CaptureWriter::writeAll(const void* data, size_t size) {
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    while (size > 0) {
+        const ssize_t written = ::write(fd_, bytes, size);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw std::system_error(errno, std::generic_category(), "Capture write failed");
+        }
+        bytes += written;
+        size -= static_cast<size_t>(written);
+        file_offset_ += static_cast<uint64_t>(written);
+    }
+}
+
+} // namespace serial_bus_generator
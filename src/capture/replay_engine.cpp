@@ -0,0 +1,177 @@
+#include "serial_bus_generator/capture/replay_engine.hpp"
+#include "serial_bus_generator/core/deadline_scheduler.hpp"
+#include <stdexcept>
+
+namespace serial_bus_generator {
+
+ReplayEngine::ReplayEngine(const std::string& path, const ReplayOptions& options)
+    : reader_(path)
+    , options_(options)
+{
+    if (options_.speed != 0.0 && (options_.speed < MIN_SPEED || options_.speed > MAX_SPEED)) {
+        throw std::invalid_argument("Replay speed must be between 0.1x and 100x, or 0");
+    }
+    if (options_.begin_ns >= options_.end_ns) {
+        throw std::invalid_argument("Empty replay time range");
+    }
+}
+
+ReplayEngine::~ReplayEngine() {
+    stop();
+}
+
+void ReplayEngine::addSink(std::shared_ptr<IFrameSink> sink) {
+    if (!sink) {
+        throw std::invalid_argument("Null sink");
+    }
+    if (state_ == GeneratorState::RUNNING) {
+        throw std::logic_error("Cannot attach a sink while running");
+    }
+    sinks_.push_back(std::move(sink));
+}
+
+void ReplayEngine::start() {
+    if (state_ == GeneratorState::RUNNING || replay_thread_.joinable()) {
+        return;
+    }
+    state_ = GeneratorState::RUNNING;
+    running_ = true;
+    replay_thread_ = std::thread([this] {
+        replay();
+    });
+}
+
+void ReplayEngine::stop() {
+    if (state_ == GeneratorState::STOPPED && !replay_thread_.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(wake_mutex_);
+        running_ = false;
+        wake_.notify_all();
+    }
+    if (replay_thread_.joinable()) {
+        replay_thread_.join();
+    }
+    state_ = GeneratorState::STOPPED;
+    for (auto& sink : sinks_) {
+        sink->flush();
+    }
+}
+
+void ReplayEngine::run() {
+    if (state_ == GeneratorState::RUNNING) {
+        throw std::logic_error("Replay is already running");
+    }
+    state_ = GeneratorState::RUNNING;
+    running_ = true;
+    replay();
+    for (auto& sink : sinks_) {
+        sink->flush();
+    }
+}
+
+void ReplayEngine::replay() {
+    using Clock = DeadlineScheduler::Clock;
+
+    try {
+        const bool paced = options_.speed != 0.0;
+        const size_t block_count = reader_.getBlockCount();
+        FrameBatch batch(MAX_BATCH);
+        Clock::time_point origin{};
+        Clock::time_point batch_due{};
+        uint64_t base_ns = 0;
+        uint64_t wall_origin_ns = 0;
+        bool have_base = false;
+
+        size_t block = reader_.findBlock(options_.begin_ns);
+        reader_.prefetchBlocks(block, options_.lookahead_blocks + 1);
+
+        for (; block < block_count && running_; ++block) {
+            const CaptureBlockIndex& entry = reader_.getBlock(block);
+            if (entry.min_after_ns >= options_.end_ns) {
+                break;
+            }
+            reader_.prefetchBlocks(block + options_.lookahead_blocks, 1);
+
+            if (entry.max_ns >= options_.begin_ns && entry.min_ns < options_.end_ns) {
+                const Frame* records = reader_.getBlockRecords(block);
+                for (uint32_t i = 0; i < entry.record_count && running_; ++i) {
+                    const uint64_t ts = records[i].timestamp_ns;
+                    if (ts < options_.begin_ns || ts >= options_.end_ns) {
+                        continue;
+                    }
+                    if (!have_base) {
+                        // The first replayed frame defines time zero
+                        have_base = true;
+                        base_ns = ts;
+                        origin = Clock::now();
+                        wall_origin_ns = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                            std::chrono::system_clock::now().time_since_epoch()).count());
+                    }
+
+                    Clock::time_point due = origin;
+                    if (paced && ts > base_ns) {
+                        const double offset = static_cast<double>(ts - base_ns) / options_.speed;
+                        due += std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double, std::nano>(offset));
+                    }
+                    if (!batch.empty() && (due > batch_due + options_.batch_window || batch.size() == MAX_BATCH)) {
+                        emit(batch, batch_due, paced);
+                    }
+                    if (batch.empty()) {
+                        batch_due = due;
+                    }
+                    batch.push(records[i]);
+                    if (options_.restamp) {
+                        batch[batch.size() - 1].timestamp_ns = wall_origin_ns + (paced
+                            ? static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(due - origin).count())
+                            : (ts > base_ns ? ts - base_ns : 0));
+                    }
+                }
+            }
+
+            // Done with this block; keep the resident set to the lookahead window
+            reader_.releaseBlocks(block, 1);
+        }
+        if (!batch.empty() && running_) {
+            emit(batch, batch_due, paced);
+        }
+        state_ = GeneratorState::STOPPED;
+    } catch (const std::exception& e) {
+        std::lock_guard<std::mutex> lock(last_error_mutex_);
+        last_error_ = e.what();
+        state_ = GeneratorState::ERROR;
+    }
+    running_ = false;
+}
+
+void ReplayEngine::emit(FrameBatch& batch, std::chrono::steady_clock::time_point due, bool paced) {
+    if (paced) {
+        // Recorded gaps can be long at low speeds: sleep where stop() can
+        // wake us, then spin the last stretch as live generation does
+        {
+            std::unique_lock<std::mutex> lock(wake_mutex_);
+            wake_.wait_until(lock, due - DeadlineScheduler::DEFAULT_SPIN_THRESHOLD, [this] { return !running_; });
+        }
+        if (!running_) {
+            batch.clear();
+            return;
+        }
+        DeadlineScheduler::sleepUntil(due, DeadlineScheduler::DEFAULT_SPIN_THRESHOLD);
+        if (DeadlineScheduler::Clock::now() > due + LATE_THRESHOLD) {
+            ++late_batches_;
+        }
+    }
+    for (auto& sink : sinks_) {
+        sink->write(batch.data(), batch.size());
+    }
+    replayed_ += batch.size();
+    batch.clear();
+}
+
+std::string ReplayEngine::getLastError() const {
+    std::lock_guard<std::mutex> lock(last_error_mutex_);
+    return last_error_;
+}
+
+} // namespace serial_bus_generator
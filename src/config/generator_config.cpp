@@ -0,0 +1,535 @@
+#include "serial_bus_generator/config/generator_config.hpp"
+#include "serial_bus_generator/core/data_generator.hpp"
+#include "serial_bus_generator/core/transmit_schedule.hpp"
+#include "serial_bus_generator/protocols/arinc429/arinc429_fleet.hpp"
+#include "serial_bus_generator/protocols/arinc429/arinc429_message.hpp"
+#include "serial_bus_generator/protocols/canj1939/canj1939_message.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace serial_bus_generator {
+
+namespace {
+
+struct SignalName {
+    const char* name;
+    uint32_t key;
+};
+
+// Signals the generators can fill
+constexpr SignalName ARINC429_SIGNALS[] = {
+    {"LATITUDE", static_cast<uint32_t>(ARINC429Label::LATITUDE)},
+    {"LONGITUDE", static_cast<uint32_t>(ARINC429Label::LONGITUDE)},
+    {"ALTITUDE", static_cast<uint32_t>(ARINC429Label::ALTITUDE)},
+    {"GROUND_SPEED", static_cast<uint32_t>(ARINC429Label::GROUND_SPEED)},
+    {"TRACK_HEADING", static_cast<uint32_t>(ARINC429Label::TRACK_HEADING)},
+    {"VERTICAL_SPEED", static_cast<uint32_t>(ARINC429Label::VERTICAL_SPEED)},
+    {"EQUIPMENT_STATUS", static_cast<uint32_t>(ARINC429Label::EQUIPMENT_STATUS)},
+};
+
+constexpr SignalName J1939_SIGNALS[] = {
+    {"ENGINE_SPEED", static_cast<uint32_t>(CANJ1939PGN::ENGINE_SPEED)},
+    {"ENGINE_TEMPERATURE", static_cast<uint32_t>(CANJ1939PGN::ENGINE_TEMPERATURE)},
+    {"ENGINE_HOURS", static_cast<uint32_t>(CANJ1939PGN::ENGINE_HOURS)},
+    {"DM1", static_cast<uint32_t>(CANJ1939PGN::DM1)},
+    {"ENGINE_CONFIG", static_cast<uint32_t>(CANJ1939PGN::ENGINE_CONFIG)},
+    {"COMPONENT_ID", static_cast<uint32_t>(CANJ1939PGN::COMPONENT_ID)},
+};
+
+struct FaultName {
+    const char* name;
+    FaultKind kind;
+};
+
+constexpr FaultName FAULT_KINDS[] = {
+    {"DROP", FaultKind::DROP},
+    {"PARITY_ERROR", FaultKind::PARITY_ERROR},
+    {"SSM_FAILURE", FaultKind::SSM_FAILURE},
+    {"NO_COMPUTED_DATA", FaultKind::NO_COMPUTED_DATA},
+    {"BAD_LENGTH", FaultKind::BAD_LENGTH},
+};
+
+bool isMultiPacket(uint32_t pgn) {
+    return pgn == static_cast<uint32_t>(CANJ1939PGN::DM1) ||
+           pgn == static_cast<uint32_t>(CANJ1939PGN::ENGINE_CONFIG) ||
+           pgn == static_cast<uint32_t>(CANJ1939PGN::COMPONENT_ID);
+}
+
+std::string trim(const std::string& text) {
+    const size_t first = text.find_first_not_of(" \t\r");
+    if (first == std::string::npos) {
+        return std::string();
+    }
+    const size_t last = text.find_last_not_of(" \t\r");
+    return text.substr(first, last - first + 1);
+}
+
+std::vector<std::string> splitWords(const std::string& text) {
+    std::istringstream in(text);
+    std::vector<std::string> words;
+    std::string word;
+    while (in >> word) {
+        words.push_back(word);
+    }
+    return words;
+}
+
+/**
+ * @brief Line-by-line compiler state; every error names the current line
+ */
+class Compiler {
+public:
+    explicit Compiler(const std::string& source) : source_(source) {}
+
+    ScenarioPlan run(std::istream& in);
+
+private:
+    [[noreturn]] void fail(const std::string& message) const {
+        throw std::invalid_argument(source_ + ":" + std::to_string(line_) + ": " + message);
+    }
+
+    void section(const std::string& header);
+    void setting(const std::string& key, const std::string& value);
+    void finishChannel();
+
+    uint64_t parseUnsigned(const std::string& text, uint64_t max, const char* what) const;
+    double parseNumber(const std::string& text, const char* what) const;
+    std::chrono::nanoseconds parseDuration(const std::string& text) const;
+    GeoPoint parsePoint(const std::string& text) const;
+    uint32_t signalKey(const std::string& name) const;
+
+    std::string source_;
+    size_t line_{0};
+    ScenarioPlan plan_;
+    bool in_scenario_{false};
+    ChannelPlan* channel_{nullptr};
+    size_t channel_line_{0};
+    bool has_protocol_{false};
+    bool has_channel_{false};
+};
+
+ScenarioPlan Compiler::run(std::istream& in) {
+    std::string text;
+    while (std::getline(in, text)) {
+        ++line_;
+        const size_t comment = text.find_first_of("#;");
+        if (comment != std::string::npos) {
+            text.erase(comment);
+        }
+        text = trim(text);
+        if (text.empty()) {
+            continue;
+        }
+        if (text.front() == '[') {
+            if (text.back() != ']') {
+                fail("Unterminated section header");
+            }
+            section(trim(text.substr(1, text.size() - 2)));
+            continue;
+        }
+        const size_t equals = text.find('=');
+        if (equals == std::string::npos) {
+            fail("Expected 'key = value'");
+        }
+        setting(trim(text.substr(0, equals)), trim(text.substr(equals + 1)));
+    }
+    finishChannel();
+
+    line_ = 0;
+    if (plan_.channels.empty()) {
+        throw std::invalid_argument(source_ + ": Scenario has no channels");
+    }
+    return std::move(plan_);
+}
+
+void Compiler::section(const std::string& header) {
+    finishChannel();
+    in_scenario_ = false;
+    channel_ = nullptr;
+
+    const std::vector<std::string> words = splitWords(header);
+    if (words.size() == 1 && words[0] == "scenario") {
+        in_scenario_ = true;
+        return;
+    }
+    if (words.size() != 2 || words[0] != "channel") {
+        fail("Unknown section '" + header + "'");
+    }
+    if (plan_.findChannel(words[1])) {
+        fail("Duplicate channel '" + words[1] + "'");
+    }
+    plan_.channels.emplace_back();
+    channel_ = &plan_.channels.back();
+    channel_->name = words[1];
+    channel_line_ = line_;
+    has_protocol_ = false;
+    has_channel_ = false;
+}
+
+void Compiler::setting(const std::string& key, const std::string& value) {
+    if (in_scenario_) {
+        if (key == "name") {
+            plan_.name = value;
+        } else if (key == "seed") {
+            plan_.seed = parseUnsigned(value, UINT64_MAX, "seed");
+            plan_.has_seed = true;
+        } else {
+            fail("Unknown scenario setting '" + key + "'");
+        }
+        return;
+    }
+    if (!channel_) {
+        fail("Setting outside of a section");
+    }
+
+    if (key == "protocol") {
+        if (!channel_->signals.empty()) {
+            fail("Protocol must come before signals");
+        }
+        if (value == "ARINC429") {
+            channel_->protocol = MessageType::ARINC429;
+        } else if (value == "CANJ1939") {
+            channel_->protocol = MessageType::CANJ1939;
+        } else {
+            fail("Unknown protocol '" + value + "'");
+        }
+        has_protocol_ = true;
+    } else if (key == "channel") {
+        channel_->channel = static_cast<uint16_t>(parseUnsigned(value, UINT16_MAX, "channel"));
+        has_channel_ = true;
+    } else if (key == "rate") {
+        channel_->rate = static_cast<uint32_t>(parseUnsigned(value, DataGenerator::MAX_RATE, "rate"));
+        if (channel_->rate == 0) {
+            fail("Rate must be at least 1 Hz");
+        }
+    } else if (key == "fleet") {
+        channel_->fleet_size = parseUnsigned(value, ARINC429Fleet::MAX_AIRCRAFT, "fleet");
+    } else if (key == "route") {
+        const size_t arrow = value.find("->");
+        if (arrow == std::string::npos) {
+            fail("Route must be 'lat,lon -> lat,lon'");
+        }
+        channel_->origin = parsePoint(trim(value.substr(0, arrow)));
+        channel_->destination = parsePoint(trim(value.substr(arrow + 2)));
+        channel_->has_route = true;
+    } else if (key == "rpm_jitter") {
+        channel_->rpm_jitter = static_cast<float>(parseNumber(value, "rpm_jitter"));
+    } else if (key == "temperature_drift") {
+        channel_->temperature_drift = static_cast<float>(parseNumber(value, "temperature_drift"));
+    } else if (key == "signal") {
+        if (!has_protocol_) {
+            fail("Protocol must come before signals");
+        }
+        const std::vector<std::string> words = splitWords(value);
+        if (words.size() < 2 || words.size() > 3) {
+            fail("Signal must be 'NAME period [phase]'");
+        }
+        SignalPlan signal;
+        signal.key = signalKey(words[0]);
+        signal.period = parseDuration(words[1]);
+        signal.phase = words.size() == 3 ? parseDuration(words[2]) : std::chrono::nanoseconds(0);
+        if (signal.period.count() <= 0) {
+            fail("Signal period must be positive");
+        }
+        for (const SignalPlan& other : channel_->signals) {
+            if (other.key == signal.key) {
+                fail("Signal '" + words[0] + "' is already scheduled");
+            }
+        }
+        channel_->signals.push_back(signal);
+    } else if (key == "fault") {
+        const std::vector<std::string> words = splitWords(value);
+        if (words.size() != 4) {
+            fail("Fault must be 'SIGNAL KIND start duration'");
+        }
+        FaultPlan fault;
+        fault.key = signalKey(words[0]);
+        const bool scheduled = std::any_of(channel_->signals.begin(), channel_->signals.end(),
+            [&fault](const SignalPlan& signal) { return signal.key == fault.key; });
+        if (!scheduled) {
+            fail("Fault targets '" + words[0] + "', which is not scheduled on this channel");
+        }
+        const FaultName* kind = std::find_if(std::begin(FAULT_KINDS), std::end(FAULT_KINDS),
+            [&words](const FaultName& entry) { return words[1] == entry.name; });
+        if (kind == std::end(FAULT_KINDS)) {
+            fail("Unknown fault kind '" + words[1] + "'");
+        }
+        fault.kind = kind->kind;
+        const bool arinc = channel_->protocol == MessageType::ARINC429;
+        if (fault.kind == FaultKind::BAD_LENGTH && (arinc || isMultiPacket(fault.key))) {
+            fail("BAD_LENGTH only applies to single-frame J1939 PGNs");
+        }
+        if (!arinc && fault.kind != FaultKind::DROP && fault.kind != FaultKind::BAD_LENGTH) {
+            fail("Fault kind '" + words[1] + "' only applies to ARINC429");
+        }
+        fault.start = parseDuration(words[2]);
+        fault.end = fault.start + parseDuration(words[3]);
+        if (fault.end <= fault.start) {
+            fail("Fault duration must be positive");
+        }
+        channel_->faults.push_back(fault);
+    } else {
+        fail("Unknown channel setting '" + key + "'");
+    }
+}
+
+void Compiler::finishChannel() {
+    if (!channel_) {
+        return;
+    }
+    const size_t line = line_;
+    line_ = channel_line_;  // Errors below are about the whole section
+    if (!has_protocol_) {
+        fail("Channel '" + channel_->name + "' has no protocol");
+    }
+    if (!has_channel_) {
+        fail("Channel '" + channel_->name + "' has no channel number");
+    }
+    if (channel_->signals.empty()) {
+        fail("Channel '" + channel_->name + "' has no signals");
+    }
+    if (channel_->protocol != MessageType::ARINC429 && (channel_->fleet_size > 0 || channel_->has_route)) {
+        fail("Fleets and routes only apply to ARINC429 channels");
+    }
+    if (channel_->fleet_size > ARINC429Fleet::MAX_AIRCRAFT - channel_->channel) {
+        fail("Fleet does not fit in the channel range");
+    }
+    if (channel_->has_route) {
+        try {
+            FlightTrajectory(channel_->origin, channel_->destination, FlightProfile{1.0, 1.0, 1.0, 1.0, 1.0}, 1);
+        } catch (const std::invalid_argument& e) {
+            fail(std::string("Bad route: ") + e.what());
+        }
+    }
+
+    // A fleet occupies one channel per aircraft
+    const auto last = [](const ChannelPlan& plan) {
+        return static_cast<size_t>(plan.channel) + std::max<size_t>(plan.fleet_size, 1) - 1;
+    };
+    for (const ChannelPlan& other : plan_.channels) {
+        if (&other != channel_ && other.channel <= last(*channel_) && channel_->channel <= last(other)) {
+            fail("Channel '" + channel_->name + "' overlaps the channels of '" + other.name + "'");
+        }
+    }
+
+    std::stable_sort(channel_->faults.begin(), channel_->faults.end(),
+        [](const FaultPlan& a, const FaultPlan& b) { return a.start < b.start; });
+    channel_ = nullptr;
+    line_ = line;
+}
+
+uint64_t Compiler::parseUnsigned(const std::string& text, uint64_t max, const char* what) const {
+    char* end = nullptr;
+    errno = 0;
+    const unsigned long long value = std::strtoull(text.c_str(), &end, 10);
+    if (text.empty() || text[0] == '-' || *end != '\0' || errno == ERANGE || value > max) {
+        fail(std::string("Bad ") + what + " '" + text + "'");
+    }
+    return value;
+}
+
+double Compiler::parseNumber(const std::string& text, const char* what) const {
+    char* end = nullptr;
+    const double value = std::strtod(text.c_str(), &end);
+    if (text.empty() || *end != '\0' || !std::isfinite(value) || value < 0.0) {
+        fail(std::string("Bad ") + what + " '" + text + "'");
+    }
+    return value;
+}
+
+std::chrono::nanoseconds Compiler::parseDuration(const std::string& text) const {
+    char* end = nullptr;
+    const double value = std::strtod(text.c_str(), &end);
+    const std::string unit(end);
+    double scale;
+    if (unit == "ns") {
+        scale = 1.0;
+    } else if (unit == "us") {
+        scale = 1e3;
+    } else if (unit == "ms") {
+        scale = 1e6;
+    } else if (unit == "s") {
+        scale = 1e9;
+    } else {
+        fail("Duration '" + text + "' needs a unit of ns, us, ms or s");
+    }
+    if (end == text.c_str() || !std::isfinite(value) || value < 0.0 || value * scale > 1e18) {
+        fail("Bad duration '" + text + "'");
+    }
+    return std::chrono::nanoseconds(static_cast<int64_t>(std::llround(value * scale)));
+}
+
+GeoPoint Compiler::parsePoint(const std::string& text) const {
+    const size_t comma = text.find(',');
+    char* end = nullptr;
+    GeoPoint point{0.0, 0.0};
+    if (comma != std::string::npos) {
+        const std::string latitude = trim(text.substr(0, comma));
+        const std::string longitude = trim(text.substr(comma + 1));
+        point.latitude = std::strtod(latitude.c_str(), &end);
+        const bool latitude_ok = !latitude.empty() && *end == '\0';
+        point.longitude = std::strtod(longitude.c_str(), &end);
+        if (latitude_ok && !longitude.empty() && *end == '\0' &&
+            std::fabs(point.latitude) <= 90.0 && std::fabs(point.longitude) <= 180.0) {
+            return point;
+        }
+    }
+    fail("Bad coordinates '" + text + "'");
+}
+
+uint32_t Compiler::signalKey(const std::string& name) const {
+    if (channel_->protocol == MessageType::ARINC429) {
+        for (const SignalName& signal : ARINC429_SIGNALS) {
+            if (name == signal.name) {
+                return signal.key;
+            }
+        }
+        fail("Unknown ARINC429 signal '" + name + "'");
+    }
+    for (const SignalName& signal : J1939_SIGNALS) {
+        if (name == signal.name) {
+            return signal.key;
+        }
+    }
+    fail("Unknown J1939 signal '" + name + "'");
+}
+
+bool sameChannels(const ScenarioPlan& a, const ScenarioPlan& b) {
+    if (a.channels.size() != b.channels.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.channels.size(); ++i) {
+        const ChannelPlan& x = a.channels[i];
+        const ChannelPlan& y = b.channels[i];
+        if (x.name != y.name || x.protocol != y.protocol || x.channel != y.channel ||
+            x.fleet_size != y.fleet_size) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+ScenarioPlan ScenarioPlan::compile(std::istream& in, const std::string& source) {
+    return Compiler(source).run(in);
+}
+
+ScenarioPlan ScenarioPlan::load(const std::string& path) {
+    std::ifstream in(path);
+    if (!in) {
+        throw std::runtime_error("Cannot open scenario " + path);
+    }
+    return compile(in, path);
+}
+
+const ChannelPlan* ScenarioPlan::findChannel(const std::string& name) const {
+    for (const ChannelPlan& channel : channels) {
+        if (channel.name == name) {
+            return &channel;
+        }
+    }
+    return nullptr;
+}
+
+void loadSignals(const std::vector<SignalPlan>& signals, TransmitSchedule& schedule, bool running) {
+    if (!running) {
+        schedule.clear();
+        for (const SignalPlan& signal : signals) {
+            schedule.addEntry(signal.key, signal.period, signal.phase);
+        }
+        return;
+    }
+
+    // Keep the phase of signals already on the wheel; dropped ones go quiet
+    for (size_t entry = 0; entry < schedule.size(); ++entry) {
+        schedule.setEnabled(entry, false);
+    }
+    for (const SignalPlan& signal : signals) {
+        const size_t entry = schedule.findEntry(signal.key);
+        if (entry == schedule.size()) {
+            schedule.addEntry(signal.key, signal.period, signal.phase);
+        } else {
+            schedule.setPeriod(entry, signal.period);
+            schedule.setEnabled(entry, true);
+        }
+    }
+}
+
+ScenarioLoader::ScenarioLoader(std::string path)
+    : path_(std::move(path))
+    , plan_(std::make_shared<const ScenarioPlan>(ScenarioPlan::load(path_)))
+    , modified_(std::filesystem::last_write_time(path_))
+{}
+
+std::shared_ptr<const ScenarioPlan> ScenarioLoader::getPlan() const {
+    return std::atomic_load(&plan_);
+}
+
+bool ScenarioLoader::reloadIfChanged() {
+    std::error_code error;
+    const auto modified = std::filesystem::last_write_time(path_, error);
+    if (error || modified == modified_) {
+        return false;  // A file being replaced may briefly be missing
+    }
+    modified_ = modified;
+
+    try {
+        auto plan = std::make_shared<const ScenarioPlan>(ScenarioPlan::load(path_));
+        if (!sameChannels(*plan, *getPlan())) {
+            last_error_ = path_ + ": Channels cannot change while running; keeping the current plan";
+            return false;
+        }
+        std::atomic_store(&plan_, std::shared_ptr<const ScenarioPlan>(std::move(plan)));
+    } catch (const std::exception& e) {
+        last_error_ = e.what();
+        return false;
+    }
+    last_error_.clear();
+    ++version_;
+    return true;
+}
+
+void FaultSchedule::assign(const std::vector<FaultPlan>& faults) {
+    faults_ = faults;
+    next_ = 0;
+    active_.clear();
+    advance(now_);
+}
+
+void FaultSchedule::restart() {
+    next_ = 0;
+    active_.clear();
+    now_ = std::chrono::nanoseconds(0);
+    advance(now_);
+}
+
+void FaultSchedule::advance(std::chrono::nanoseconds now) {
+    now_ = now;
+    while (next_ < faults_.size() && faults_[next_].start <= now) {
+        if (faults_[next_].end > now) {
+            active_.push_back(faults_[next_]);
+        }
+        ++next_;
+    }
+    if (!active_.empty()) {
+        active_.erase(std::remove_if(active_.begin(), active_.end(),
+            [now](const FaultPlan& fault) { return fault.end <= now; }), active_.end());
+    }
+}
+
+const FaultPlan* FaultSchedule::find(uint32_t key) const {
+    for (const FaultPlan& fault : active_) {
+        if (fault.key == key) {
+            return &fault;
+        }
+    }
+    return nullptr;
+}
+
+} // namespace serial_bus_generator
@@ -0,0 +1,213 @@
+#include "serial_bus_generator/core/channel_runtime.hpp"
+#include "serial_bus_generator/trace/tracer.hpp"
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace serial_bus_generator {
+
+using Clock = DeadlineScheduler::Clock;
+
+ChannelRuntime::ChannelRuntime(size_t worker_count, bool pin_workers) {
+    if (worker_count == 0) {
+        worker_count = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    workers_.reserve(worker_count);
+    for (size_t i = 0; i < worker_count; ++i) {
+        workers_.push_back(std::make_unique<Worker>());
+    }
+    for (size_t i = 0; i < worker_count; ++i) {
+        workers_[i]->thread = std::thread(&ChannelRuntime::workerLoop, this, i);
+        if (pin_workers) {
+            pinWorker(i);
+        }
+    }
+}
+
+ChannelRuntime::~ChannelRuntime() {
+    stopAll();
+
+    shutdown_ = true;
+    for (auto& worker : workers_) {
+        {
+            std::lock_guard<std::mutex> lock(worker->mutex);
+        }
+        worker->wake.notify_all();
+    }
+    for (auto& worker : workers_) {
+        if (worker->thread.joinable()) {
+            worker->thread.join();
+        }
+    }
+}
+
+DataGenerator& ChannelRuntime::addChannel(std::unique_ptr<DataGenerator> generator) {
+    if (!generator) {
+        throw std::invalid_argument("Null generator");
+    }
+    if (generator->getState() == GeneratorState::RUNNING || generator->runtime_ != nullptr) {
+        throw std::logic_error("Generator must be stopped and not hosted elsewhere");
+    }
+
+    std::lock_guard<std::mutex> lock(channels_mutex_);
+    auto channel = std::make_unique<Channel>();
+    channel->generator = std::move(generator);
+    channel->generator->runtime_ = this;
+    channel->generator->runtime_slot_ = channels_.size();
+    channel->generator->setChannel(static_cast<uint16_t>(channels_.size()));
+    channels_.push_back(std::move(channel));
+    return *channels_.back()->generator;
+}
+
+size_t ChannelRuntime::getChannelCount() const {
+    std::lock_guard<std::mutex> lock(channels_mutex_);
+    return channels_.size();
+}
+
+DataGenerator& ChannelRuntime::getChannel(size_t channel) {
+    std::lock_guard<std::mutex> lock(channels_mutex_);
+    if (channel >= channels_.size()) {
+        throw std::out_of_range("Invalid channel");
+    }
+    return *channels_[channel]->generator;
+}
+
+void ChannelRuntime::startAll() {
+    for (size_t i = 0; i < getChannelCount(); ++i) {
+        getChannel(i).start();
+    }
+}
+
+void ChannelRuntime::stopAll() {
+    for (size_t i = 0; i < getChannelCount(); ++i) {
+        getChannel(i).stop();
+    }
+}
+
+void ChannelRuntime::activate(size_t slot) {
+    Channel* channel;
+    {
+        std::lock_guard<std::mutex> lock(channels_mutex_);
+        channel = channels_.at(slot).get();
+    }
+
+    const uint64_t epoch = ++channel->epoch;
+    Worker& worker = *workers_[next_worker_++ % workers_.size()];
+    push(worker, Entry{channel->generator->scheduler_.nextDeadline(), channel, epoch});
+    worker.wake.notify_one();
+}
+
+void ChannelRuntime::deactivate(size_t slot) {
+    Channel* channel;
+    {
+        std::lock_guard<std::mutex> lock(channels_mutex_);
+        channel = channels_.at(slot).get();
+    }
+
+    // Invalidate queued entries, then wait out a tick that may be in flight
+    ++channel->epoch;
+    std::lock_guard<std::mutex> lock(channel->tick_mutex);
+}
+
+void ChannelRuntime::workerLoop(size_t index) {
+    Worker& self = *workers_[index];
+
+    while (!shutdown_) {
+        auto now = Clock::now();
+        Entry entry;
+        if (popDue(self, now, entry) || steal(index, now, entry)) {
+            runEntry(index, entry);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(self.mutex);
+        if (shutdown_) {
+            break;
+        }
+
+        auto wake_at = now + STEAL_INTERVAL;
+        if (!self.queue.empty()) {
+            const auto deadline = self.queue.front().deadline;
+            if (deadline - now <= DeadlineScheduler::DEFAULT_SPIN_THRESHOLD) {
+                lock.unlock();
+                SBG_TRACE_SCOPE("wait", Tracer::NO_CHANNEL);
+                DeadlineScheduler::sleepUntil(deadline, DeadlineScheduler::DEFAULT_SPIN_THRESHOLD);
+                continue;
+            }
+            wake_at = std::min(wake_at, deadline - std::chrono::duration_cast<Clock::duration>(
+                DeadlineScheduler::DEFAULT_SPIN_THRESHOLD));
+        }
+        SBG_TRACE_SCOPE("wait", Tracer::NO_CHANNEL);
+        self.wake.wait_until(lock, wake_at);
+    }
+}
+
+bool ChannelRuntime::popDue(Worker& worker, Clock::time_point now, Entry& entry) {
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    if (worker.queue.empty() || worker.queue.front().deadline > now) {
+        return false;
+    }
+    std::pop_heap(worker.queue.begin(), worker.queue.end(), std::greater<Entry>());
+    entry = worker.queue.back();
+    worker.queue.pop_back();
+    return true;
+}
+
+bool ChannelRuntime::steal(size_t thief, Clock::time_point now, Entry& entry) {
+    for (size_t i = 1; i < workers_.size(); ++i) {
+        Worker& victim = *workers_[(thief + i) % workers_.size()];
+        std::unique_lock<std::mutex> lock(victim.mutex, std::try_to_lock);
+        if (!lock.owns_lock() || victim.queue.empty() || victim.queue.front().deadline > now) {
+            continue;
+        }
+        std::pop_heap(victim.queue.begin(), victim.queue.end(), std::greater<Entry>());
+        entry = victim.queue.back();
+        victim.queue.pop_back();
+        return true;
+    }
+    return false;
+}
+
+void ChannelRuntime::runEntry(size_t worker, const Entry& entry) {
+    Channel& channel = *entry.channel;
+    std::lock_guard<std::mutex> lock(channel.tick_mutex);
+    if (entry.epoch != channel.epoch || !channel.generator->running_) {
+        return;  // Stale entry from before a stop()
+    }
+
+    if (!channel.generator->runTick() || entry.epoch != channel.epoch) {
+        return;
+    }
+
+    // Requeue locally so a stolen channel migrates to the thief. Virtual-clock
+    // channels are due again immediately and share the worker with the rest.
+    const auto deadline = channel.generator->clock_mode_ == ClockMode::VIRTUAL
+        ? Clock::now() : channel.generator->scheduler_.nextDeadline();
+    push(*workers_[worker], Entry{deadline, &channel, entry.epoch});
+}
+
+void ChannelRuntime::push(Worker& worker, const Entry& entry) {
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    worker.queue.push_back(entry);
+    std::push_heap(worker.queue.begin(), worker.queue.end(), std::greater<Entry>());
+}
+
+void ChannelRuntime::pinWorker(size_t index) {
+#ifdef __linux__
+    const unsigned cpus = std::max(1u, std::thread::hardware_concurrency());
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(index % cpus, &set);
+    pthread_setaffinity_np(workers_[index]->thread.native_handle(), sizeof(set), &set);
+#else
+    (void)index;
+#endif
+}
+
+} // namespace serial_bus_generator
\ No newline at end of file
@@ -1,14 +1,24 @@
 #include "serial_bus_generator/core/data_generator.hpp"
+#include "serial_bus_generator/core/channel_runtime.hpp"
+#include "serial_bus_generator/trace/tracer.hpp"
+#include <random>
 #include <thread>
 #include <stdexcept>
 
 namespace serial_bus_generator {
 
 DataGenerator::DataGenerator()
-    : state_(GeneratorState::STOPPED)
+    : frames_(std::make_unique<SpscRing<Frame>>(DEFAULT_FRAME_BUFFER))
+    , epoch_ns_(std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::system_clock::now().time_since_epoch()).count())
+    , state_(GeneratorState::STOPPED)
     , rate_(100)  // Default 100Hz
     , running_(false)
-{}
+    , scheduler_(100)
+{
+    std::random_device entropy;
+    setSeed((static_cast<uint64_t>(entropy()) << 32) | entropy());
+}
 
 DataGenerator::~DataGenerator() {
     stop();
@@ -19,23 +29,39 @@ void DataGenerator::start() {
         return;
     }
 
+    if (generation_thread_.joinable()) {
+        generation_thread_.join();  // Left over from an error exit
+    }
+
     running_ = true;
     state_ = GeneratorState::RUNNING;
-    generation_thread_ = std::thread(&DataGenerator::startGeneration, this);
+    if (runtime_) {
+        prepareGeneration();
+        resetTimeline();
+        runtime_->activate(runtime_slot_);
+    } else {
+        generation_thread_ = std::thread(&DataGenerator::startGeneration, this);
+    }
 }
 
 
 void DataGenerator::stop() {
-    if (state_ == GeneratorState::STOPPED) {
+    // A finished virtual run is already STOPPED but its thread still needs joining
+    if (state_ == GeneratorState::STOPPED && !generation_thread_.joinable()) {
         return;
     }
 
     running_ = false;
-    if (generation_thread_.joinable()) {
+    if (runtime_) {
+        runtime_->deactivate(runtime_slot_);
+    } else if (generation_thread_.joinable()) {
         generation_thread_.join();
     }
     state_ = GeneratorState::STOPPED;
     stopGeneration();
+    for (auto& sink : sinks_) {
+        sink->flush();
+    }
 }
 
 
@@ -51,30 +77,224 @@ GeneratorState DataGenerator::getState() const {
 }
 
 void DataGenerator::startGeneration() {
+    prepareGeneration();
+    resetTimeline();
+
     while (running_) {
-        try {
-            auto messages = generateMessages(std::chrono::milliseconds(1000 / rate_));
-            processMessages(std::move(messages));
-            
-            std::this_thread::sleep_for(std::chrono::milliseconds(1000 / rate_));
-        } catch (const std::exception& e) {
-            state_ = GeneratorState::ERROR;
+        if (clock_mode_ == ClockMode::REALTIME) {
+            SBG_TRACE_SCOPE("wait", channel_);
+            scheduler_.sleepUntilDeadline();
+        }
+        if (!runTick()) {
+            break;
+        }
+    }
+}
+
+void DataGenerator::resetTimeline() {
+    scheduler_.setRate(rate_);
+    scheduler_.start(DeadlineScheduler::Clock::now());
+    epoch_ns_ = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    if (clock_mode_ == ClockMode::VIRTUAL && virtual_epoch_ns_ != 0) {
+        epoch_ns_ = virtual_epoch_ns_;
+    }
+    elapsed_ns_ = 0;
+    simulated_time_ = std::chrono::milliseconds(0);
+}
+
+bool DataGenerator::runTick() {
+    SBG_TRACE_SCOPE("tick", channel_);
+    try {
+        // Feed the whole-millisecond progress of the ideal timeline so the
+        // sum of all durations stays exact at sub-millisecond periods
+        auto target = std::chrono::duration_cast<std::chrono::milliseconds>(scheduler_.elapsed());
+        if (plan_pending_.exchange(false)) {
+            applyPlan(*std::atomic_load(&pending_plan_));
+        }
+        const bool realtime = clock_mode_ == ClockMode::REALTIME;
+        const auto deadline = scheduler_.nextDeadline();
+        const auto wakeup = DeadlineScheduler::Clock::now();
+        if (realtime) {
+            stats_.recordLateness(wakeup - deadline);
+            wakeup_lateness_.record(wakeup - deadline);
+            SBG_TRACE_INSTANT("wakeup", channel_, nullptr, (wakeup - deadline).count());
+        }
+        tick_frames_.clear();
+        generateFrames(target - simulated_time_, tick_frames_);
+        generate_duration_.record(DeadlineScheduler::Clock::now() - wakeup);
+        simulated_time_ = target;
+        processFrames(tick_frames_);
+        stats_.addTick();
+
+        // A new rate applies from the deadline after this tick
+        scheduler_.setRate(rate_);
+        if (realtime) {
+            const auto now = DeadlineScheduler::Clock::now();
+            // Frames are stamped with the deadline, so this is timestamp-to-sink
+            if (!tick_frames_.empty()) {
+                sink_latency_.record(now - deadline);
+            }
+            stats_.addMissedDeadlines(scheduler_.advance(now));
+        } else {
+            scheduler_.advance();
+        }
+        elapsed_ns_ = scheduler_.elapsed().count();
+
+        if (clock_mode_ == ClockMode::VIRTUAL && virtual_duration_.count() > 0 &&
+            scheduler_.elapsed() > virtual_duration_) {
             running_ = false;
-            handleError(e.what());
+            state_ = GeneratorState::STOPPED;
+            return false;
+        }
+        return true;
+    } catch (const std::exception& e) {
+        stats_.addEncodeError();
+        state_ = GeneratorState::ERROR;
+        running_ = false;
+        handleError(e.what());
+        return false;
+    }
+}
+
+void DataGenerator::setClockMode(ClockMode mode) {
+    if (state_ == GeneratorState::RUNNING) {
+        throw std::logic_error("Cannot change the clock mode while running");
+    }
+    clock_mode_ = mode;
+}
+
+void DataGenerator::setVirtualDuration(std::chrono::nanoseconds duration) {
+    if (state_ == GeneratorState::RUNNING) {
+        throw std::logic_error("Cannot change the virtual duration while running");
+    }
+    virtual_duration_ = duration;
+}
+
+void DataGenerator::setVirtualEpoch(uint64_t epoch_ns) {
+    if (state_ == GeneratorState::RUNNING) {
+        throw std::logic_error("Cannot change the virtual epoch while running");
+    }
+    virtual_epoch_ns_ = epoch_ns;
+}
+
+void DataGenerator::setSeed(uint64_t seed) {
+    if (state_ == GeneratorState::RUNNING) {
+        throw std::logic_error("Cannot change the seed while running");
+    }
+    rng_ = CounterRng(seed);
+}
+
+void DataGenerator::setPlan(std::shared_ptr<const ChannelPlan> plan) {
+    if (!plan) {
+        throw std::invalid_argument("Null plan");
+    }
+    if (state_ != GeneratorState::RUNNING) {
+        plan_pending_ = false;  // Superseded
+        setRate(plan->rate);
+        setChannel(plan->channel);
+        applyPlan(*plan);
+        return;
+    }
+    if (plan->channel != channel_) {
+        throw std::logic_error("Cannot change the channel while running");
+    }
+    setRate(plan->rate);
+    std::atomic_store(&pending_plan_, std::move(plan));
+    plan_pending_ = true;
+}
+
+void DataGenerator::applyPlan(const ChannelPlan& /*plan*/) {
+    throw std::logic_error("Generator does not run scenario plans");
+}
+
+std::chrono::nanoseconds DataGenerator::getElapsedTime() const {
+    return std::chrono::nanoseconds(elapsed_ns_.load());
+}
+
+void DataGenerator::addSink(std::shared_ptr<IFrameSink> sink) {
+    if (!sink) {
+        throw std::invalid_argument("Null sink");
+    }
+    if (state_ == GeneratorState::RUNNING) {
+        throw std::logic_error("Cannot attach a sink while running");
+    }
+    sinks_.push_back(std::move(sink));
+}
+
+void DataGenerator::clearSinks() {
+    if (state_ == GeneratorState::RUNNING) {
+        throw std::logic_error("Cannot detach sinks while running");
+    }
+    sinks_.clear();
+}
+
+size_t DataGenerator::drainFrames(Frame* out, size_t max_frames) {
+    return frames_->tryPop(out, max_frames);
+}
+
+void DataGenerator::setFrameBufferCapacity(size_t capacity) {
+    if (state_ == GeneratorState::RUNNING) {
+        throw std::logic_error("Cannot resize the frame buffer while running");
+    }
+    frames_ = std::make_unique<SpscRing<Frame>>(capacity);
+}
+
+void DataGenerator::publishFrames(const Frame* frames, size_t count) {
+    size_t pushed = frames_->tryPush(frames, count);
+    while (pushed < count) {
+        if (clock_mode_ == ClockMode::REALTIME || !running_) {
+            stats_.addDroppedFrames(count - pushed);  // Keep what is queued so the consumer still sees an in-order stream
+            return;
         }
+        // Simulated time can wait for the consumer instead of losing data
+        std::this_thread::yield();
+        pushed += frames_->tryPush(frames + pushed, count - pushed);
     }
 }
 
+uint64_t DataGenerator::currentTimestamp() const {
+    return epoch_ns_ + static_cast<uint64_t>(scheduler_.elapsed().count());
+}
+
 void DataGenerator::stopGeneration() {
     running_ = false;
 }
 
 void DataGenerator::handleError(const std::string& error) {
+    std::lock_guard<std::mutex> lock(last_error_mutex_);
     last_error_ = error;
 }
 
-void DataGenerator::processMessages(std::vector<std::unique_ptr<IMessage>>&& messages) {
-    message_count_ += messages.size();
+std::string DataGenerator::getLastError() const {
+    std::lock_guard<std::mutex> lock(last_error_mutex_);
+    return last_error_;
+}
+
+LatencyStats DataGenerator::getLatencyStats() const {
+    return LatencyStats{wakeup_lateness_.snapshot(), generate_duration_.snapshot(), sink_latency_.snapshot()};
+}
+
+GeneratorStats DataGenerator::getStats() const {
+    GeneratorStats stats;
+    stats_.snapshot(stats);
+    stats.channel = channel_;
+    stats.queue_depth = frames_->size();
+    stats.queue_capacity = frames_->capacity();
+    stats.elapsed = getElapsedTime();
+    return stats;
+}
+
+void DataGenerator::processFrames(const FrameBatch& frames) {
+    {
+        SBG_TRACE_SCOPE("publish", channel_);
+        publishFrames(frames.data(), frames.size());
+    }
+    for (auto& sink : sinks_) {
+        SBG_TRACE_SCOPE("sink write", channel_);
+        sink->write(frames.data(), frames.size());
+    }
+    stats_.addFrames(frames.data(), frames.size());
 }
 
 } // namespace serial_bus_generator
\ No newline at end of file
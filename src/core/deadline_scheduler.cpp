@@ -0,0 +1,113 @@
+#include "serial_bus_generator/core/deadline_scheduler.hpp"
+#include <stdexcept>
+#include <thread>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+namespace serial_bus_generator {
+
+namespace {
+
+constexpr int64_t NANOS_PER_SECOND = 1000000000;
+
+inline void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+    _mm_pause();
+#endif
+}
+
+} // namespace
+
+DeadlineScheduler::DeadlineScheduler(uint32_t rate)
+    : rate_(rate)
+    , origin_(Clock::now())
+{
+    if (rate == 0) {
+        throw std::invalid_argument("Invalid rate specified");
+    }
+}
+
+void DeadlineScheduler::start(Clock::time_point origin) {
+    origin_ = origin;
+    tick_ = 0;
+    elapsed_base_ = std::chrono::nanoseconds(0);
+}
+
+void DeadlineScheduler::setRate(uint32_t rate) {
+    if (rate == 0) {
+        throw std::invalid_argument("Invalid rate specified");
+    }
+    if (rate == rate_) {
+        return;
+    }
+
+    // Rebase on the pending deadline so it is not moved by the change
+    const auto offset = offsetOf(tick_);
+    origin_ += std::chrono::duration_cast<Clock::duration>(offset);
+    elapsed_base_ += offset;
+    tick_ = 0;
+    rate_ = rate;
+}
+
+DeadlineScheduler::Clock::time_point DeadlineScheduler::nextDeadline() const {
+    return origin_ + std::chrono::duration_cast<Clock::duration>(offsetOf(tick_));
+}
+
+std::chrono::nanoseconds DeadlineScheduler::elapsed() const {
+    return elapsed_base_ + offsetOf(tick_);
+}
+
+void DeadlineScheduler::advance() {
+    ++tick_;
+}
+
+uint64_t DeadlineScheduler::advance(Clock::time_point now) {
+    ++tick_;
+
+    const int64_t since_origin = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        now - origin_).count();
+    if (since_origin <= 0) {
+        return 0;
+    }
+
+    // Latest tick whose deadline is not after 'now'
+    const uint64_t ns = static_cast<uint64_t>(since_origin);
+    const uint64_t latest = (ns / NANOS_PER_SECOND) * rate_ +
+                            ((ns % NANOS_PER_SECOND) * rate_) / NANOS_PER_SECOND;
+    if (latest <= tick_) {
+        return 0;
+    }
+
+    const uint64_t missed = latest - tick_;
+    tick_ = latest;
+    return missed;
+}
+
+void DeadlineScheduler::sleepUntilDeadline() const {
+    sleepUntil(nextDeadline(), spin_threshold_);
+}
+
+void DeadlineScheduler::sleepUntil(Clock::time_point deadline,
+                                   std::chrono::nanoseconds spin_threshold) {
+    auto now = Clock::now();
+    if (deadline - now > spin_threshold) {
+        std::this_thread::sleep_until(deadline - spin_threshold);
+        now = Clock::now();
+    }
+    while (now < deadline) {
+        cpuRelax();
+        now = Clock::now();
+    }
+}
+
+std::chrono::nanoseconds DeadlineScheduler::offsetOf(uint64_t tick) const {
+    // Split to keep tick * 1e9 from overflowing on long runs
+    const uint64_t seconds = tick / rate_;
+    const uint64_t remainder = tick % rate_;
+    return std::chrono::nanoseconds(seconds * NANOS_PER_SECOND +
+                                    (remainder * NANOS_PER_SECOND) / rate_);
+}
+
+} // namespace serial_bus_generator
@@ -0,0 +1,79 @@
+#include "serial_bus_generator/core/timing_wheel.hpp"
+#include <stdexcept>
+
+namespace serial_bus_generator {
+
+TimingWheel::TimingWheel() {
+    reset();
+}
+
+void TimingWheel::reset() {
+    for (auto& level : slots_) {
+        level.fill(NONE);
+    }
+    for (auto& node : nodes_) {
+        node = Node{};
+    }
+    now_ = 0;
+    pending_ = 0;
+}
+
+void TimingWheel::schedule(uint32_t id, uint64_t expiry) {
+    if (id == NONE) {
+        throw std::invalid_argument("Invalid timer id");
+    }
+    if (id >= nodes_.size()) {
+        nodes_.resize(static_cast<size_t>(id) + 1);
+    }
+    if (nodes_[id].armed) {
+        throw std::logic_error("Timer is already pending");
+    }
+
+    nodes_[id].expiry = expiry < now_ ? now_ : expiry;
+    nodes_[id].armed = true;
+    ++pending_;
+    insert(id);
+}
+
+void TimingWheel::insert(uint32_t id) {
+    const uint64_t expiry = nodes_[id].expiry;
+
+    // Use the finest level whose current revolution still contains the expiry;
+    // anything beyond the top level's range waits there and is re-inserted
+    unsigned level = 0;
+    while (level + 1 < LEVELS &&
+           (expiry >> ((level + 1) * SLOT_BITS)) != (now_ >> ((level + 1) * SLOT_BITS))) {
+        ++level;
+    }
+
+    const unsigned slot = static_cast<unsigned>((expiry >> (level * SLOT_BITS)) & (SLOTS - 1));
+    nodes_[id].next = slots_[level][slot];
+    slots_[level][slot] = id;
+}
+
+void TimingWheel::cascade() {
+    // At a level boundary, redistribute the slot that now becomes current;
+    // coarser levels first so their timers can fall through in the same tick
+    for (unsigned level = LEVELS - 1; level > 0; --level) {
+        const uint64_t mask = (uint64_t{1} << (level * SLOT_BITS)) - 1;
+        if ((now_ & mask) != 0) {
+            continue;
+        }
+
+        const unsigned slot = static_cast<unsigned>((now_ >> (level * SLOT_BITS)) & (SLOTS - 1));
+        uint32_t id = detach(level, slot);
+        while (id != NONE) {
+            const uint32_t next = nodes_[id].next;
+            insert(id);
+            id = next;
+        }
+    }
+}
+
+uint32_t TimingWheel::detach(unsigned level, unsigned slot) {
+    const uint32_t head = slots_[level][slot];
+    slots_[level][slot] = NONE;
+    return head;
+}
+
+} // namespace serial_bus_generator
@@ -0,0 +1,95 @@
+#include "serial_bus_generator/core/transmit_schedule.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace serial_bus_generator {
+
+TransmitSchedule::TransmitSchedule(std::chrono::nanoseconds resolution)
+    : resolution_(resolution)
+{
+    if (resolution.count() <= 0) {
+        throw std::invalid_argument("Invalid schedule resolution");
+    }
+}
+
+size_t TransmitSchedule::addEntry(uint32_t key, std::chrono::nanoseconds period,
+                                  std::chrono::nanoseconds phase) {
+    if (period.count() <= 0 || phase.count() < 0) {
+        throw std::invalid_argument("Invalid transmit period");
+    }
+
+    const size_t index = entries_.size();
+    entries_.push_back({key, std::max<uint64_t>(1, toTicks(period)), toTicks(phase), true});
+    wheel_.schedule(static_cast<uint32_t>(index), wheel_.now() + entries_.back().phase_ticks);
+    return index;
+}
+
+void TransmitSchedule::setPeriod(size_t entry, std::chrono::nanoseconds period) {
+    if (entry >= entries_.size() || period.count() <= 0) {
+        throw std::invalid_argument("Invalid transmit period");
+    }
+    // Takes effect from the entry's next transmission
+    entries_[entry].period_ticks = std::max<uint64_t>(1, toTicks(period));
+}
+
+void TransmitSchedule::setEnabled(size_t entry, bool enabled) {
+    if (entry >= entries_.size()) {
+        throw std::invalid_argument("Invalid transmit entry");
+    }
+    entries_[entry].enabled = enabled;
+}
+
+void TransmitSchedule::clear() {
+    entries_.clear();
+    wheel_.reset();
+    now_ = std::chrono::nanoseconds(0);
+}
+
+void TransmitSchedule::reset() {
+    wheel_.reset();
+    now_ = std::chrono::nanoseconds(0);
+    for (size_t i = 0; i < entries_.size(); ++i) {
+        wheel_.schedule(static_cast<uint32_t>(i), entries_[i].phase_ticks);
+    }
+}
+
+size_t TransmitSchedule::findEntry(uint32_t key) const {
+    for (size_t i = 0; i < entries_.size(); ++i) {
+        if (entries_[i].key == key) {
+            return i;
+        }
+    }
+    return entries_.size();
+}
+
+std::chrono::nanoseconds TransmitSchedule::getPeriod(size_t entry) const {
+    return resolution_ * entries_[entry].period_ticks;
+}
+
+const std::vector<uint32_t>& TransmitSchedule::advance(std::chrono::nanoseconds delta) {
+    due_.clear();
+    now_ += delta;
+    const uint64_t target = toTicks(now_);
+
+    wheel_.advanceTo(target, [this, target](uint32_t id, uint64_t expiry) {
+        const Entry& entry = entries_[id];
+        if (entry.enabled) {
+            due_.push_back(entry.key);
+        }
+
+        // Coalesce occurrences that fall inside this step onto the grid point after it
+        uint64_t next = expiry + entry.period_ticks;
+        if (next <= target) {
+            next += ((target - next) / entry.period_ticks + 1) * entry.period_ticks;
+        }
+        wheel_.schedule(id, next);
+    });
+
+    return due_;
+}
+
+uint64_t TransmitSchedule::toTicks(std::chrono::nanoseconds duration) const {
+    return static_cast<uint64_t>(duration.count() / resolution_.count());
+}
+
+} // namespace serial_bus_generator
\ No newline at end of file
@@ -0,0 +1,135 @@
+#include "serial_bus_generator/decode/stream_decoder.hpp"
+#include "serial_bus_generator/protocols/arinc429/arinc429_label_traits.hpp"
+#include "serial_bus_generator/protocols/canj1939/canj1939_message.hpp"
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+namespace serial_bus_generator {
+
+namespace {
+
+constexpr uint32_t SSM_SHIFT = 29;
+constexpr uint8_t INVALID_MASK = static_cast<uint8_t>(~DECODE_SSM_NOT_NORMAL);
+
+} // namespace
+
+StreamDecoder::StreamDecoder()
+    : StreamDecoder(nullptr)
+{}
+
+StreamDecoder::StreamDecoder(Consumer consumer, ARINC429BatchCodec::Kernel kernel)
+    : consumer_(std::move(consumer))
+    , codec_(kernel)
+{}
+
+size_t StreamDecoder::decodeWords(const uint32_t* words, size_t count, float* values, uint8_t* status) {
+    size_t invalid = 0;
+    for (size_t offset = 0; offset < count; offset += CHUNK) {
+        const size_t n = std::min(CHUNK, count - offset);
+        const uint32_t* chunk = words + offset;
+
+        // status doubles as the parity result: 1 = valid
+        stats_.unknown_labels += codec_.decode(chunk, values + offset, n);
+        stats_.parity_errors += codec_.verifyParity(chunk, status + offset, n);
+
+        for (size_t i = 0; i < n; ++i) {
+            uint8_t flags = status[offset + i] ? DECODE_OK : DECODE_BAD_PARITY;
+            if (values[offset + i] != values[offset + i]) {
+                flags |= DECODE_UNKNOWN_LABEL;
+            }
+            if ((chunk[i] >> SSM_SHIFT) & 0x03) {
+                flags |= DECODE_SSM_NOT_NORMAL;
+                ++stats_.ssm_not_normal;
+            }
+            status[offset + i] = flags;
+            invalid += (flags & INVALID_MASK) != 0;
+        }
+    }
+    stats_.arinc429_words += count;
+    stats_.frames += count;
+    stats_.invalid += invalid;
+    return invalid;
+}
+
+size_t StreamDecoder::decode(const Frame* frames, size_t count, DecodedSample* out) {
+    constexpr float NOT_DECODED = std::numeric_limits<float>::quiet_NaN();
+    size_t invalid = 0;
+
+    for (size_t offset = 0; offset < count; offset += CHUNK) {
+        const size_t n = std::min(CHUNK, count - offset);
+        size_t words = 0;
+        size_t j1939_invalid = 0;
+
+        for (size_t i = 0; i < n; ++i) {
+            const Frame& frame = frames[offset + i];
+            DecodedSample& sample = out[offset + i];
+            sample.timestamp_ns = frame.timestamp_ns;
+            sample.channel = frame.channel;
+            sample.type = frame.type;
+
+            if (frame.type == MessageType::ARINC429) {
+                // Gathered for the vector pass below
+                words_[words] = frame.id;
+                word_index_[words] = static_cast<uint32_t>(offset + i);
+                ++words;
+                continue;
+            }
+
+            ++stats_.j1939_frames;
+            const CANJ1939PGN pgn = CANJ1939Message::pgnFromIdentifier(frame.id);
+            sample.key = static_cast<uint32_t>(pgn);
+            sample.status = DECODE_OK;
+            sample.value = NOT_DECODED;
+            if (frame.dlc != 8) {
+                sample.status |= DECODE_BAD_LENGTH;
+                ++stats_.bad_lengths;
+            }
+            if (!CANJ1939Message::isValidPGN(pgn)) {
+                sample.status |= DECODE_UNKNOWN_PGN;
+                ++stats_.unknown_pgns;
+            }
+            if (sample.status == DECODE_OK) {
+                sample.value = CANJ1939Message::decodeValue(pgn, frame.data);
+            } else {
+                ++j1939_invalid;
+            }
+        }
+        stats_.frames += n - words;
+        stats_.invalid += j1939_invalid;
+        invalid += j1939_invalid;
+
+        if (words > 0) {
+            invalid += decodeWords(words_, words, values_, status_);
+            for (size_t k = 0; k < words; ++k) {
+                const Frame& frame = frames[word_index_[k]];
+                DecodedSample& sample = out[word_index_[k]];
+                const ARINC429LabelCodec* codec = findWordCodec(frame.id);
+                sample.key = codec ? static_cast<uint32_t>(codec->spec->label) : (frame.id & 0xFF);
+                sample.value = values_[k];
+                sample.status = status_[k];
+                if (frame.dlc != 4) {
+                    sample.status |= DECODE_BAD_LENGTH;
+                    ++stats_.bad_lengths;
+                    if ((status_[k] & INVALID_MASK) == 0) {
+                        ++invalid;
+                        ++stats_.invalid;
+                    }
+                }
+            }
+        }
+    }
+    return invalid;
+}
+
+void StreamDecoder::write(const Frame* frames, size_t count) {
+    for (size_t offset = 0; offset < count; offset += CHUNK) {
+        const size_t n = std::min(CHUNK, count - offset);
+        decode(frames + offset, n, samples_);
+        if (consumer_) {
+            consumer_(samples_, n);
+        }
+    }
+}
+
+} // namespace serial_bus_generator
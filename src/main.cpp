@@ -1,17 +1,325 @@
+#include "serial_bus_generator/capture/capture_writer.hpp"
+#include "serial_bus_generator/capture/replay_engine.hpp"
+#include "serial_bus_generator/config/generator_config.hpp"
+#include "serial_bus_generator/core/channel_runtime.hpp"
 #include "serial_bus_generator/core/data_generator.hpp"
+#include "serial_bus_generator/decode/stream_decoder.hpp"
+#include "serial_bus_generator/metrics/prometheus_exporter.hpp"
 #include "serial_bus_generator/protocols/arinc429/arinc429_generator.hpp"
 #include "serial_bus_generator/protocols/canj1939/canj1939_generator.hpp"
+#include "serial_bus_generator/sinks/pcapng_sink.hpp"
+#include "serial_bus_generator/sinks/queued_sink.hpp"
+#include "serial_bus_generator/sinks/socketcan_sink.hpp"
+#include "serial_bus_generator/sinks/text_sink.hpp"
+#include "serial_bus_generator/trace/tracer.hpp"
+#include <algorithm>
+#include <csignal>
 #include <memory>
 #include <iostream>
 #include <cstring>
+#include <vector>
+
+// Set by Ctrl+C or SIGTERM so runs shut down cleanly and print their statistics
+volatile std::sig_atomic_t interrupted = 0;
+
+void handle_interrupt(int) {
+    interrupted = 1;
+}
+
+// Prints the decoder's findings; true if every frame was valid
+bool report_verification(const serial_bus_generator::StreamDecoder& decoder) {
+    const auto& stats = decoder.getStats();
+    std::cerr << "Verified " << stats.frames << " frames (" << stats.arinc429_words << " ARINC429, "
+              << stats.j1939_frames << " J1939): " << stats.invalid << " invalid, "
+              << stats.parity_errors << " parity, " << stats.unknown_labels << " unknown labels, "
+              << stats.unknown_pgns << " unknown PGNs, " << stats.bad_lengths << " bad lengths, "
+              << stats.ssm_not_normal << " non-normal SSM\n";
+    return stats.invalid == 0;
+}
+
+// Prints the percentiles of a generator's tick latencies; real-time ticks only
+// record lateness and timestamp-to-sink latency
+void report_latency(const serial_bus_generator::DataGenerator& generator, const std::string& prefix) {
+    const serial_bus_generator::LatencyStats latency = generator.getLatencyStats();
+    std::cerr << prefix << "Wakeup lateness:   " << latency.wakeup_lateness.summary() << "\n"
+              << prefix << "Generate duration: " << latency.generate_duration.summary() << "\n"
+              << prefix << "Timestamp to sink: " << latency.sink_latency.summary() << "\n";
+}
+
+// Queues in front of the file and network sinks, so a stalled one drops
+// frames by its overrun policy instead of holding up generation
+struct SinkQueues {
+    bool enabled{false};  // Sinks are written directly unless --sink-policy is given
+    serial_bus_generator::QueuedSinkOptions options;
+    std::vector<std::pair<std::string, std::shared_ptr<serial_bus_generator::QueuedSink>>> queues;
+
+    std::shared_ptr<serial_bus_generator::IFrameSink> wrap(std::shared_ptr<serial_bus_generator::IFrameSink> sink,
+                                                           const std::string& name) {
+        if (!enabled) {
+            return sink;
+        }
+        auto queue = std::make_shared<serial_bus_generator::QueuedSink>(std::move(sink), options);
+        queues.emplace_back(name, queue);
+        return queue;
+    }
+
+    void report() const {
+        for (const auto& [name, queue] : queues) {
+            const serial_bus_generator::QueuedSinkStats stats = queue->getStats();
+            std::cerr << name << " queue (" << serial_bus_generator::QueuedSink::policyName(queue->getPolicy())
+                      << "): " << stats.written << " written, " << stats.dropped_newest << " dropped newest, "
+                      << stats.dropped_oldest << " dropped oldest, " << stats.coalesced << " coalesced, "
+                      << stats.failed << " failed, " << stats.blocked_writes << " blocked writes, max depth "
+                      << stats.max_queue_depth << "\n";
+            if (!queue->getLastError().empty()) {
+                std::cerr << name << " error: " << queue->getLastError() << "\n";
+            }
+        }
+    }
+};
+
+// Adds a capture channel entry for each aircraft of a fleet, which flies on
+// consecutive channels from the first; a fleet size of 0 is a single aircraft
+void add_capture_channels(std::vector<serial_bus_generator::CaptureChannelInfo>& channels, uint16_t first,
+                          size_t fleet_size, serial_bus_generator::MessageType type, uint32_t rate,
+                          const std::string& name) {
+    for (size_t i = 0; i < std::max<size_t>(fleet_size, 1); ++i) {
+        channels.push_back(serial_bus_generator::CaptureWriter::makeChannelInfo(
+            static_cast<uint16_t>(first + i), type, rate, name));
+    }
+}
+
+// Dumps the events traced during the run, if a trace file was requested
+void write_trace(const std::string& path) {
+    using serial_bus_generator::Tracer;
+    if (path.empty()) {
+        return;
+    }
+    Tracer::setEnabled(false);
+    Tracer::writeChromeJson(path);
+    std::cerr << "Trace: " << Tracer::getEventCount() << " events written to " << path << " ("
+              << Tracer::getOverwrittenEvents() << " overwritten)\n";
+}
+
+// Runs every channel of a scenario file, reloading it when it changes
+int run_scenario(const std::string& path, bool has_seed, uint64_t seed, double virtual_seconds,
+                 const std::string& capture_path, const std::string& pcapng_path,
+                 const serial_bus_generator::PcapngOptions& pcapng_options,
+                 const std::string& can_interface, const std::string& metrics_target,
+                 const std::string& trace_path, SinkQueues& sink_queues, bool verify) {
+    using namespace serial_bus_generator;
+
+    ScenarioLoader loader(path);
+    std::shared_ptr<const ScenarioPlan> plan = loader.getPlan();
+    std::cout << "Scenario: " << (plan->name.empty() ? path : plan->name) << ", "
+              << plan->channels.size() << " channels\n";
+
+    // One worker runs every channel, so the shared sinks see one writer at a time
+    ChannelRuntime runtime(1);
+    std::vector<CaptureChannelInfo> capture_channels;
+    for (const ChannelPlan& channel : plan->channels) {
+        std::unique_ptr<DataGenerator> generator;
+        if (channel.protocol == MessageType::ARINC429) {
+            generator = std::make_unique<ARINC429Generator>();
+        } else {
+            generator = std::make_unique<CANJ1939Generator>();
+        }
+        // Room for a second of every aircraft's labels
+        generator->setFrameBufferCapacity(std::max(DataGenerator::DEFAULT_FRAME_BUFFER,
+                                                   channel.fleet_size * 64));
+        runtime.addChannel(std::move(generator));
+        add_capture_channels(capture_channels, channel.channel, channel.fleet_size, channel.protocol,
+                             channel.rate, channel.name);
+    }
+
+    // --seed overrides the scenario's; either way every channel shares one
+    // seed, and channels draw distinct streams from it
+    if (!has_seed) {
+        seed = plan->has_seed ? plan->seed : runtime.getChannel(0).getSeed();
+    }
+    std::cerr << "Seed: " << seed << "\n";
+
+    std::shared_ptr<CaptureWriter> capture;
+    if (!capture_path.empty()) {
+        capture = std::make_shared<CaptureWriter>(capture_path, capture_channels);
+    }
+    std::shared_ptr<PcapngSink> pcapng;
+    if (!pcapng_path.empty()) {
+        pcapng = std::make_shared<PcapngSink>(pcapng_path, pcapng_options);
+    }
+    std::shared_ptr<SocketCanSink> can;
+    if (!can_interface.empty()) {
+        can = std::make_shared<SocketCanSink>(can_interface);
+    }
+    std::shared_ptr<IFrameSink> capture_sink = capture ? sink_queues.wrap(capture, "Capture") : nullptr;
+    std::shared_ptr<IFrameSink> pcapng_sink = pcapng ? sink_queues.wrap(pcapng, "pcapng") : nullptr;
+    std::shared_ptr<IFrameSink> can_sink = can ? sink_queues.wrap(can, "CAN") : nullptr;
+    auto decoder = std::make_shared<StreamDecoder>();
+
+    for (size_t i = 0; i < runtime.getChannelCount(); ++i) {
+        DataGenerator& generator = runtime.getChannel(i);
+        generator.setSeed(seed);
+        generator.setPlan(std::shared_ptr<const ChannelPlan>(plan, &plan->channels[i]));
+        if (virtual_seconds > 0.0) {
+            generator.setClockMode(ClockMode::VIRTUAL);
+            generator.setVirtualDuration(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::duration<double>(virtual_seconds)));
+        }
+        if (capture_sink) {
+            generator.addSink(capture_sink);
+        }
+        if (pcapng_sink) {
+            generator.addSink(pcapng_sink);
+        }
+        if (can_sink) {
+            generator.addSink(can_sink);
+        }
+        if (verify) {
+            generator.addSink(decoder);
+        }
+    }
+    std::unique_ptr<PrometheusExporter> metrics;
+    if (!metrics_target.empty()) {
+        metrics = std::make_unique<PrometheusExporter>(metrics_target);
+        for (size_t i = 0; i < runtime.getChannelCount(); ++i) {
+            metrics->addGenerator(runtime.getChannel(i));
+        }
+    }
+    runtime.startAll();
+    if (metrics) {
+        metrics->start();
+    }
+    std::cout << "Scenario running (Ctrl+C to stop); edit " << path << " to change it\n\n";
+    std::cout.flush();
+
+    TextSink console(stdout);
+    std::vector<Frame> frames(4096);
+    auto next_check = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+    std::string reported_error;
+    for (;;) {
+        size_t drained = 0;
+        bool running = false;
+        for (size_t i = 0; i < runtime.getChannelCount(); ++i) {
+            DataGenerator& generator = runtime.getChannel(i);
+            running = running || generator.getState() == GeneratorState::RUNNING;
+            const size_t count = generator.drainFrames(frames.data(), frames.size());
+            console.write(frames.data(), count);
+            drained += count;
+        }
+        console.flush();
+
+        if (std::chrono::steady_clock::now() >= next_check) {
+            next_check += std::chrono::seconds(1);
+            if (loader.reloadIfChanged()) {
+                plan = loader.getPlan();
+                for (size_t i = 0; i < runtime.getChannelCount(); ++i) {
+                    runtime.getChannel(i).setPlan(std::shared_ptr<const ChannelPlan>(plan, &plan->channels[i]));
+                }
+                std::cerr << "Reloaded " << path << " (version " << loader.getVersion() << ")\n";
+            } else if (loader.getLastError() != reported_error) {
+                reported_error = loader.getLastError();
+                std::cerr << "Scenario not reloaded: " << reported_error << "\n";
+            }
+        }
+
+        if (interrupted) {
+            break;
+        }
+        if (drained == 0) {
+            if (!running) {
+                break;  // Every channel finished or failed, and everything is drained
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+    }
+    runtime.stopAll();
+    if (metrics) {
+        metrics->stop();
+    }
+    for (size_t i = 0; i < runtime.getChannelCount(); ++i) {
+        report_latency(runtime.getChannel(i), plan->channels[i].name + ": ");
+    }
+    write_trace(trace_path);
+    if (capture) {
+        capture->close();
+    }
+    if (pcapng) {
+        pcapng->close();
+    }
+    sink_queues.report();
+    if (can) {
+        std::cerr << "CAN: " << can->getSentFrames() << " sent, " << can->getDroppedFrames()
+                  << " dropped, " << can->getBackpressureEvents() << " TX queue stalls\n";
+    }
+    if (verify && !report_verification(*decoder)) {
+        return 2;
+    }
+    return 0;
+}
 
 void print_usage() {
-    std::cout << "Usage: serial_bus_generator --protocol <ARINC429|CANJ1939> --rate <Hz>\n";
+    std::cout << "Usage: serial_bus_generator --protocol <ARINC429|CANJ1939> --rate <Hz>"
+                 " [--fleet <aircraft>]\n"
+                 "       [--seed <n>] [--virtual <seconds>] [--capture <file>]\n"
+                 "       [--pcapng <file> [--rotate-mb <MiB>] [--rotate-s <seconds>]]\n"
+                 "       [--can <interface>]\n"
+                 "       [--metrics <file|unix:path>] [--trace <file>]\n"
+                 "       [--sink-policy <policy> [--sink-queue <frames>]] [--verify]\n"
+                 "       serial_bus_generator --scenario <file> [--seed <n>] [--virtual <seconds>]\n"
+                 "       [--capture ...] [--pcapng ...] [--can ...] [--metrics ...] [--trace ...]\n"
+                 "       [--sink-policy ...] [--verify]\n"
+                 "       serial_bus_generator --replay <file> [--speed <x>] [--pcapng ...] [--can ...]\n"
+                 "       [--sink-policy ...] [--verify]\n"
+              << "  --fleet    Simulate this many ARINC429 aircraft, one channel each\n"
+              << "  --seed     Seed for all simulated randomness; the same seed, protocol\n"
+              << "             and options reproduce a run exactly (default: random)\n"
+              << "  --virtual  Run on a simulated clock as fast as possible for the given\n"
+              << "             simulated duration, then exit\n"
+              << "  --scenario Run the channels, signals, routes and faults of a scenario\n"
+              << "             file, reloading it whenever it changes\n"
+              << "  --capture  Also record every frame to an indexed capture file\n"
+              << "  --pcapng   Also write every frame to a pcapng file for Wireshark,\n"
+              << "             optionally rotating files by size or by frame time\n"
+              << "  --can      Also transmit J1939 frames on a SocketCAN interface (e.g. vcan0)\n"
+              << "  --metrics  Export generator statistics in the Prometheus text format,\n"
+              << "             rewriting a file every second or serving scrapes on a\n"
+              << "             unix:<path> socket\n"
+              << "  --trace    Record the generation pipeline and write it as Chrome trace\n"
+              << "             JSON for Perfetto (needs a build with SBG_ENABLE_TRACING)\n"
+              << "  --sink-policy\n"
+              << "             Give the capture, pcapng and CAN sinks a queue and thread each,\n"
+              << "             so a stalled one cannot hold up generation; when its queue is\n"
+              << "             full it will block, drop-newest, drop-oldest or coalesce (keep\n"
+              << "             the latest frame per label or PGN)\n"
+              << "             Virtual runs outpace any sink, so use block there to keep\n"
+              << "             every frame\n"
+              << "  --sink-queue\n"
+              << "             Frames each sink queue holds (default 16384)\n"
+              << "  --replay   Replay a capture file instead of generating traffic\n"
+              << "  --speed    Replay speed, 0.1 to 100 times the recorded timing;\n"
+              << "             0 replays as fast as possible (default 1)\n"
+              << "  --verify   Decode and validate every frame; exit with status 2 if any\n"
+              << "             frame is invalid\n";
 }
 
 int main(int argc, char* argv[]) {
     std::string protocol = "ARINC429";  // Default
     uint32_t rate = 100;  // Default 100Hz
+    double virtual_seconds = 0.0;  // 0 = real time
+    size_t fleet_size = 0;  // 0 = single aircraft
+    uint64_t seed = 0;
+    bool has_seed = false;  // Random seed unless given
+    std::string capture_path;
+    std::string pcapng_path;
+    serial_bus_generator::PcapngOptions pcapng_options;
+    std::string can_interface;
+    std::string metrics_target;
+    std::string trace_path;
+    std::string scenario_path;
+    std::string replay_path;
+    serial_bus_generator::ReplayOptions replay_options;
+    SinkQueues sink_queues;
+    bool verify = false;
 
     for (int i = 1; i < argc; i++) {
         if (strcmp(argv[i], "--protocol") == 0 && i + 1 < argc) {
@@ -20,17 +328,137 @@ int main(int argc, char* argv[]) {
         } else if (strcmp(argv[i], "--rate") == 0 && i + 1 < argc) {
             rate = std::stoul(argv[++i]);
             std::cout << "Rate: " << rate << "\n";
+        } else if (strcmp(argv[i], "--fleet") == 0 && i + 1 < argc) {
+            fleet_size = std::stoul(argv[++i]);
+            std::cout << "Fleet: " << fleet_size << " aircraft\n";
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = std::stoull(argv[++i]);
+            has_seed = true;
+        } else if (strcmp(argv[i], "--virtual") == 0 && i + 1 < argc) {
+            virtual_seconds = std::stod(argv[++i]);
+            std::cout << "Virtual duration: " << virtual_seconds << " s\n";
+        } else if (strcmp(argv[i], "--capture") == 0 && i + 1 < argc) {
+            capture_path = argv[++i];
+            std::cout << "Capture file: " << capture_path << "\n";
+        } else if (strcmp(argv[i], "--pcapng") == 0 && i + 1 < argc) {
+            pcapng_path = argv[++i];
+            std::cout << "pcapng file: " << pcapng_path << "\n";
+        } else if (strcmp(argv[i], "--rotate-mb") == 0 && i + 1 < argc) {
+            pcapng_options.rotate_bytes = std::stoull(argv[++i]) << 20;
+        } else if (strcmp(argv[i], "--rotate-s") == 0 && i + 1 < argc) {
+            pcapng_options.rotate_interval = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::duration<double>(std::stod(argv[++i])));
+        } else if (strcmp(argv[i], "--can") == 0 && i + 1 < argc) {
+            can_interface = argv[++i];
+            std::cout << "CAN interface: " << can_interface << "\n";
+        } else if (strcmp(argv[i], "--metrics") == 0 && i + 1 < argc) {
+            metrics_target = argv[++i];
+            std::cout << "Metrics: " << metrics_target << "\n";
+        } else if (strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+            trace_path = argv[++i];
+            std::cout << "Trace file: " << trace_path << "\n";
+        } else if (strcmp(argv[i], "--sink-policy") == 0 && i + 1 < argc) {
+            try {
+                sink_queues.options.policy = serial_bus_generator::QueuedSink::parsePolicy(argv[++i]);
+            } catch (const std::exception& e) {
+                std::cerr << e.what() << "\n";
+                print_usage();
+                return 1;
+            }
+            sink_queues.enabled = true;
+            std::cout << "Sink policy: " << argv[i] << "\n";
+        } else if (strcmp(argv[i], "--sink-queue") == 0 && i + 1 < argc) {
+            sink_queues.options.capacity = std::stoul(argv[++i]);
+        } else if (strcmp(argv[i], "--scenario") == 0 && i + 1 < argc) {
+            scenario_path = argv[++i];
+            std::cout << "Scenario file: " << scenario_path << "\n";
+        } else if (strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+            replay_path = argv[++i];
+            std::cout << "Replay file: " << replay_path << "\n";
+        } else if (strcmp(argv[i], "--speed") == 0 && i + 1 < argc) {
+            replay_options.speed = std::stod(argv[++i]);
+            std::cout << "Replay speed: " << replay_options.speed << "\n";
+        } else if (strcmp(argv[i], "--verify") == 0) {
+            verify = true;
         } else if (strcmp(argv[i], "--help") == 0) {
             print_usage();
             return 0;
         }
     }
 
-    std::unique_ptr<serial_bus_generator::IGenerator> generator;
+    if (!replay_path.empty()) {
+        if (!capture_path.empty()) {
+            std::cerr << "Error: --capture cannot be combined with --replay\n";
+            print_usage();
+            return 1;
+        }
+        try {
+            serial_bus_generator::ReplayEngine replay(replay_path, replay_options);
+            replay.addSink(std::make_shared<serial_bus_generator::TextSink>(stdout));
+            if (!pcapng_path.empty()) {
+                replay.addSink(sink_queues.wrap(
+                    std::make_shared<serial_bus_generator::PcapngSink>(pcapng_path, pcapng_options), "pcapng"));
+            }
+            if (!can_interface.empty()) {
+                replay.addSink(sink_queues.wrap(
+                    std::make_shared<serial_bus_generator::SocketCanSink>(can_interface), "CAN"));
+            }
+            auto decoder = std::make_shared<serial_bus_generator::StreamDecoder>();
+            if (verify) {
+                replay.addSink(decoder);
+            }
+            replay.run();
+            if (replay.getState() == serial_bus_generator::GeneratorState::ERROR) {
+                std::cerr << "Error: " << replay.getLastError() << "\n";
+                return 1;
+            }
+            std::cerr << "Replayed " << replay.getReplayedFrames() << " frames, "
+                      << replay.getLateBatches() << " late batches\n";
+            sink_queues.report();
+            if (verify && !report_verification(*decoder)) {
+                return 2;
+            }
+        } catch (const std::exception& e) {
+            std::cerr << "Error: " << e.what() << "\n";
+            return 1;
+        }
+        return 0;
+    }
+
+    // Generation runs until interrupted; replay keeps the default handlers
+    // since it runs on this thread
+    std::signal(SIGINT, handle_interrupt);
+    std::signal(SIGTERM, handle_interrupt);
+
+    if (!trace_path.empty()) {
+        if (!serial_bus_generator::Tracer::COMPILED_IN) {
+            std::cerr << "Warning: tracing is not compiled in; rebuild with -DSBG_ENABLE_TRACING=ON\n";
+        }
+        serial_bus_generator::Tracer::setEnabled(true);
+    }
+
+    if (!scenario_path.empty()) {
+        try {
+            return run_scenario(scenario_path, has_seed, seed, virtual_seconds, capture_path, pcapng_path,
+                                pcapng_options, can_interface, metrics_target, trace_path, sink_queues, verify);
+        } catch (const std::exception& e) {
+            std::cerr << "Error: " << e.what() << "\n";
+            return 1;
+        }
+    }
+
+    std::unique_ptr<serial_bus_generator::DataGenerator> generator;
 
     try {
         if (protocol == "ARINC429") {
-            generator = std::make_unique<serial_bus_generator::ARINC429Generator>();
+            auto arinc = std::make_unique<serial_bus_generator::ARINC429Generator>();
+            if (fleet_size > 0) {
+                arinc->setFleetSize(fleet_size);
+                // Room for a second of every aircraft's labels
+                arinc->setFrameBufferCapacity(std::max(serial_bus_generator::DataGenerator::DEFAULT_FRAME_BUFFER,
+                                                       fleet_size * 64));
+            }
+            generator = std::move(arinc);
         } else if (protocol == "CANJ1939") {
             generator = std::make_unique<serial_bus_generator::CANJ1939Generator>();
         } else {
@@ -40,18 +468,97 @@ int main(int argc, char* argv[]) {
         }
 
         generator->setRate(rate);
+        if (has_seed) {
+            generator->setSeed(seed);
+        }
+        // Reported so any run can be reproduced with --seed
+        std::cerr << "Seed: " << generator->getSeed() << "\n";
+        if (virtual_seconds > 0.0) {
+            generator->setClockMode(serial_bus_generator::ClockMode::VIRTUAL);
+            generator->setVirtualDuration(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::duration<double>(virtual_seconds)));
+        }
+        std::shared_ptr<serial_bus_generator::CaptureWriter> capture;
+        if (!capture_path.empty()) {
+            const auto type = protocol == "ARINC429" ? serial_bus_generator::MessageType::ARINC429
+                                                     : serial_bus_generator::MessageType::CANJ1939;
+            std::vector<serial_bus_generator::CaptureChannelInfo> channels;
+            add_capture_channels(channels, generator->getChannel(),
+                                 type == serial_bus_generator::MessageType::ARINC429 ? fleet_size : 0,
+                                 type, rate, protocol);
+            capture = std::make_shared<serial_bus_generator::CaptureWriter>(capture_path, channels);
+            generator->addSink(sink_queues.wrap(capture, "Capture"));
+        }
+        std::shared_ptr<serial_bus_generator::PcapngSink> pcapng;
+        if (!pcapng_path.empty()) {
+            pcapng = std::make_shared<serial_bus_generator::PcapngSink>(pcapng_path, pcapng_options);
+            generator->addSink(sink_queues.wrap(pcapng, "pcapng"));
+        }
+        std::shared_ptr<serial_bus_generator::SocketCanSink> can;
+        if (!can_interface.empty()) {
+            can = std::make_shared<serial_bus_generator::SocketCanSink>(can_interface);
+            generator->addSink(sink_queues.wrap(can, "CAN"));
+        }
+        auto decoder = std::make_shared<serial_bus_generator::StreamDecoder>();
+        if (verify) {
+            generator->addSink(decoder);
+        }
+        std::unique_ptr<serial_bus_generator::PrometheusExporter> metrics;
+        if (!metrics_target.empty()) {
+            metrics = std::make_unique<serial_bus_generator::PrometheusExporter>(metrics_target);
+            metrics->addGenerator(*generator);
+        }
         generator->start();
+        if (metrics) {
+            metrics->start();
+        }
 
         // Run until interrupted
         std::cout << "Generator running (Ctrl+C to stop)...\n";
         std::cout << "Generating " << protocol << " messages at " << rate << " Hz\n\n";
         
-        while (generator->getState() == serial_bus_generator::GeneratorState::RUNNING) {
-            auto message = generator->getLastMessage();
-            if (!message.empty()) {
-                std::cout << "[" << protocol << "] " << message << std::endl;
+        std::cout.flush();
+        serial_bus_generator::TextSink console(stdout);
+        std::vector<serial_bus_generator::Frame> frames(4096);
+        for (;;) {
+            // Drain every queued frame so nothing between polls is lost
+            size_t count = generator->drainFrames(frames.data(), frames.size());
+            console.write(frames.data(), count);
+            console.flush();
+            if (interrupted) {
+                break;
+            }
+            if (count == 0) {
+                if (generator->getState() != serial_bus_generator::GeneratorState::RUNNING) {
+                    break;  // Finished virtual run or error, and everything is drained
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
             }
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));  // Poll every 100ms
+        }
+        const bool failed = generator->getState() == serial_bus_generator::GeneratorState::ERROR;
+        generator->stop();
+        if (metrics) {
+            metrics->stop();
+        }
+        report_latency(*generator, "");
+        write_trace(trace_path);
+        if (failed) {
+            std::cerr << "Error: " << generator->getLastError() << "\n";
+            return 1;
+        }
+        if (capture) {
+            capture->close();
+        }
+        if (pcapng) {
+            pcapng->close();
+        }
+        sink_queues.report();
+        if (can) {
+            std::cerr << "CAN: " << can->getSentFrames() << " sent, " << can->getDroppedFrames()
+                      << " dropped, " << can->getBackpressureEvents() << " TX queue stalls\n";
+        }
+        if (verify && !report_verification(*decoder)) {
+            return 2;
         }
 
     } catch (const std::exception& e) {
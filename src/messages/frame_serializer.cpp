@@ -0,0 +1,55 @@
+#include "serial_bus_generator/messages/frame_serializer.hpp"
+
+namespace serial_bus_generator {
+
+size_t serializedSize(const Frame& frame) {
+    switch (frame.type) {
+        case MessageType::ARINC429:
+            return ARINC429_WIRE_SIZE;
+        case MessageType::CANJ1939:
+            return CANJ1939_WIRE_SIZE;
+    }
+    throw MessageValidationError("Unknown frame type");
+}
+
+size_t serializeFrame(const Frame& frame, uint8_t* out, size_t capacity) {
+    const size_t size = serializedSize(frame);
+    if (capacity < size) {
+        return 0;
+    }
+
+    if (frame.type == MessageType::ARINC429) {
+        out[0] = (frame.id >> 0) & 0xFF;   // Label
+        out[1] = (frame.id >> 8) & 0xFF;   // Data LSB
+        out[2] = (frame.id >> 16) & 0xFF;  // Data MSB
+        out[3] = (frame.id >> 24) & 0xFF;  // SSM and Parity
+    } else {
+        const uint32_t pgn = (frame.id >> 8) & 0x3FFFF;
+        out[0] = pgn & 0xFF;
+        out[1] = (pgn >> 8) & 0xFF;
+        out[2] = (pgn >> 16) & 0xFF;
+        for (size_t i = 0; i < 5; ++i) {
+            out[i + 3] = frame.data[i];
+        }
+    }
+    return size;
+}
+
+size_t serializeFrames(const Frame* frames, size_t count, uint8_t* out, size_t capacity,
+                       size_t* consumed) {
+    size_t written = 0;
+    size_t i = 0;
+    for (; i < count; ++i) {
+        const size_t size = serializeFrame(frames[i], out + written, capacity - written);
+        if (size == 0) {
+            break;
+        }
+        written += size;
+    }
+    if (consumed) {
+        *consumed = i;
+    }
+    return written;
+}
+
+} // namespace serial_bus_generator
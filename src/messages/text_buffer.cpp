@@ -0,0 +1,60 @@
+#include "serial_bus_generator/messages/text_buffer.hpp"
+#include <charconv>
+#include <cstring>
+
+namespace serial_bus_generator {
+
+TextBuffer::TextBuffer(size_t capacity)
+    : buffer_(capacity > 0 ? capacity : 1)
+{}
+
+char* TextBuffer::reserve(size_t count) {
+    if (buffer_.size() - size_ < count) {
+        size_t capacity = buffer_.size() * 2;
+        while (capacity - size_ < count) {
+            capacity *= 2;
+        }
+        buffer_.resize(capacity);
+    }
+    return buffer_.data() + size_;
+}
+
+void TextBuffer::append(std::string_view text) {
+    std::memcpy(reserve(text.size()), text.data(), text.size());
+    size_ += text.size();
+}
+
+void TextBuffer::append(char c) {
+    *reserve(1) = c;
+    ++size_;
+}
+
+void TextBuffer::appendInt(int64_t value) {
+    char* first = reserve(20);
+    size_ = std::to_chars(first, first + 20, value).ptr - buffer_.data();
+}
+
+void TextBuffer::appendHex(uint64_t value) {
+    char* first = reserve(16);
+    char* last = std::to_chars(first, first + 16, value, 16).ptr;
+    for (char* c = first; c != last; ++c) {
+        if (*c >= 'a') *c -= 'a' - 'A';
+    }
+    size_ = last - buffer_.data();
+}
+
+void TextBuffer::appendFixed(double value, int precision) {
+    // Most values fit in 64 characters; huge ones retry with more room
+    size_t room = 64;
+    for (;;) {
+        char* first = reserve(room);
+        auto result = std::to_chars(first, first + room, value, std::chars_format::fixed, precision);
+        if (result.ec == std::errc()) {
+            size_ = result.ptr - buffer_.data();
+            return;
+        }
+        room *= 4;
+    }
+}
+
+} // namespace serial_bus_generator
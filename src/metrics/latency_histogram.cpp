@@ -0,0 +1,97 @@
+#include "serial_bus_generator/metrics/latency_histogram.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+namespace serial_bus_generator {
+
+namespace {
+
+// Three significant digits in the largest unit that keeps the value at or above 1
+std::string formatDuration(std::chrono::nanoseconds duration) {
+    const double ns = static_cast<double>(duration.count());
+    const char* unit = "ns";
+    double value = ns;
+    if (ns >= 1e9) {
+        value = ns / 1e9;
+        unit = "s";
+    } else if (ns >= 1e6) {
+        value = ns / 1e6;
+        unit = "ms";
+    } else if (ns >= 1e3) {
+        value = ns / 1e3;
+        unit = "us";
+    }
+    char text[32];
+    std::snprintf(text, sizeof(text), "%.3g%s", value, unit);
+    return text;
+}
+
+} // namespace
+
+LatencyHistogram::LatencyHistogram() {
+    for (auto& bucket : buckets_) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+}
+
+uint64_t LatencyHistogram::bucketLowest(size_t index) {
+    if (index < SUB_BUCKETS) {
+        return index;
+    }
+    const unsigned shift = static_cast<unsigned>(index / (SUB_BUCKETS / 2)) - 1;
+    return (index % (SUB_BUCKETS / 2) + SUB_BUCKETS / 2) << shift;
+}
+
+uint64_t LatencyHistogram::bucketHighest(size_t index) {
+    if (index < SUB_BUCKETS) {
+        return index;
+    }
+    const unsigned shift = static_cast<unsigned>(index / (SUB_BUCKETS / 2)) - 1;
+    return bucketLowest(index) + (uint64_t{1} << shift) - 1;
+}
+
+HistogramSnapshot LatencyHistogram::snapshot() const {
+    HistogramSnapshot snapshot;
+    snapshot.buckets.resize(BUCKET_COUNT);
+    for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+        snapshot.buckets[i] = buckets_[i].load(std::memory_order_relaxed);
+        snapshot.count += snapshot.buckets[i];  // Consistent with the buckets, unlike count_
+    }
+    snapshot.max = std::chrono::nanoseconds(max_ns_.load(std::memory_order_relaxed));
+    snapshot.total = std::chrono::nanoseconds(total_ns_.load(std::memory_order_relaxed));
+    return snapshot;
+}
+
+std::chrono::nanoseconds HistogramSnapshot::percentile(double percent) const {
+    if (count == 0) {
+        return std::chrono::nanoseconds(0);
+    }
+    const double clamped = std::min(std::max(percent, 0.0), 100.0);
+    const uint64_t rank = std::max<uint64_t>(
+        1, static_cast<uint64_t>(std::ceil(clamped / 100.0 * static_cast<double>(count))));
+    uint64_t seen = 0;
+    for (size_t i = 0; i < buckets.size(); ++i) {
+        seen += buckets[i];
+        if (seen >= rank) {
+            const auto highest = static_cast<int64_t>(LatencyHistogram::bucketHighest(i));
+            return std::min(std::chrono::nanoseconds(highest), max);
+        }
+    }
+    return max;
+}
+
+std::chrono::nanoseconds HistogramSnapshot::mean() const {
+    return count == 0 ? std::chrono::nanoseconds(0) : total / static_cast<int64_t>(count);
+}
+
+std::string HistogramSnapshot::summary() const {
+    if (count == 0) {
+        return "no samples";
+    }
+    return "p50 " + formatDuration(percentile(50.0)) + " p99 " + formatDuration(percentile(99.0)) +
+           " p99.9 " + formatDuration(percentile(99.9)) + " max " + formatDuration(max) +
+           " (n=" + std::to_string(count) + ")";
+}
+
+} // namespace serial_bus_generator
@@ -0,0 +1,306 @@
+#include "serial_bus_generator/metrics/prometheus_exporter.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <system_error>
+
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace serial_bus_generator {
+
+namespace {
+
+constexpr int REQUEST_TIMEOUT_MS = 100;  // Per read of a scrape request
+constexpr int ACCEPT_POLL_MS = 50;       // How often an idle accept loop checks for stop()
+constexpr size_t MAX_REQUEST = 4096;
+
+const char* protocolName(MessageType type) {
+    return type == MessageType::ARINC429 ? "ARINC429" : "CANJ1939";
+}
+
+double toSeconds(std::chrono::nanoseconds duration) {
+    return std::chrono::duration<double>(duration).count();
+}
+
+void writeHeader(std::ostream& out, const char* name, const char* type, const char* help) {
+    out << "# HELP " << name << ' ' << help << "\n# TYPE " << name << ' ' << type << '\n';
+}
+
+// Reads until the end of the request headers, the size limit or a timeout;
+// the request itself does not matter since there is only one resource
+void readRequest(int fd) {
+    char buffer[MAX_REQUEST];
+    size_t received = 0;
+    while (received < sizeof(buffer)) {
+        pollfd ready{fd, POLLIN, 0};
+        if (::poll(&ready, 1, REQUEST_TIMEOUT_MS) <= 0) {
+            return;
+        }
+        const ssize_t count = ::recv(fd, buffer + received, sizeof(buffer) - received, 0);
+        if (count <= 0) {
+            return;
+        }
+        received += static_cast<size_t>(count);
+        if (std::search(buffer, buffer + received, "\r\n\r\n", "\r\n\r\n" + 4) != buffer + received) {
+            return;
+        }
+    }
+}
+
+bool sendAll(int fd, const std::string& data) {
+    size_t sent = 0;
+    while (sent < data.size()) {
+        const ssize_t count = ::send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+        if (count < 0 && errno == EINTR) {
+            continue;
+        }
+        if (count <= 0) {
+            return false;
+        }
+        sent += static_cast<size_t>(count);
+    }
+    return true;
+}
+
+} // namespace
+
+PrometheusExporter::PrometheusExporter(std::string target, std::chrono::milliseconds interval)
+    : target_(std::move(target))
+    , interval_(interval)
+    , serve_socket_(target_.rfind(SOCKET_PREFIX, 0) == 0)
+{
+    if (target_.empty() || (serve_socket_ && target_.size() == std::strlen(SOCKET_PREFIX))) {
+        throw std::invalid_argument("Empty metrics target");
+    }
+    if (interval_.count() <= 0) {
+        throw std::invalid_argument("Invalid metrics interval");
+    }
+}
+
+PrometheusExporter::~PrometheusExporter() {
+    try {
+        stop();
+    } catch (...) {
+        // The final export is best effort on destruction
+    }
+}
+
+void PrometheusExporter::addGenerator(const IGenerator& generator) {
+    if (running_) {
+        throw std::logic_error("Cannot add a generator while running");
+    }
+    generators_.push_back(&generator);
+}
+
+void PrometheusExporter::start() {
+    if (running_) {
+        return;
+    }
+    if (serve_socket_) {
+        const std::string path = target_.substr(std::strlen(SOCKET_PREFIX));
+        sockaddr_un address{};
+        if (path.size() >= sizeof(address.sun_path)) {
+            throw std::invalid_argument("Metrics socket path is too long");
+        }
+        address.sun_family = AF_UNIX;
+        std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+
+        listen_fd_ = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (listen_fd_ < 0) {
+            throw std::system_error(errno, std::generic_category(), "Cannot open metrics socket");
+        }
+        ::unlink(path.c_str());  // Left over from a previous run
+        if (::bind(listen_fd_, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+            ::listen(listen_fd_, 8) != 0) {
+            const int error = errno;
+            ::close(listen_fd_);
+            listen_fd_ = -1;
+            throw std::system_error(error, std::generic_category(), "Cannot listen on " + path);
+        }
+    }
+    running_ = true;
+    thread_ = std::thread(serve_socket_ ? &PrometheusExporter::serveLoop : &PrometheusExporter::exportLoop, this);
+}
+
+void PrometheusExporter::stop() {
+    if (!running_) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(wake_mutex_);
+        running_ = false;
+    }
+    wake_.notify_all();
+    thread_.join();
+
+    if (serve_socket_) {
+        ::close(listen_fd_);
+        listen_fd_ = -1;
+        ::unlink(target_.substr(std::strlen(SOCKET_PREFIX)).c_str());
+    } else {
+        exportNow();  // Final counters of the run
+    }
+}
+
+void PrometheusExporter::exportNow() {
+    if (serve_socket_) {
+        throw std::logic_error("Socket targets are scraped, not written");
+    }
+    writeFile(render());
+    ++exports_;
+}
+
+void PrometheusExporter::exportLoop() {
+    auto next = std::chrono::steady_clock::now();
+    std::unique_lock<std::mutex> lock(wake_mutex_);
+    while (running_) {
+        lock.unlock();
+        try {
+            exportNow();
+        } catch (const std::exception& e) {
+            setError(e.what());
+        }
+        lock.lock();
+
+        next += interval_;
+        wake_.wait_until(lock, next, [this] { return !running_; });
+    }
+}
+
+void PrometheusExporter::serveLoop() {
+    while (running_) {
+        pollfd ready{listen_fd_, POLLIN, 0};
+        const int count = ::poll(&ready, 1, ACCEPT_POLL_MS);
+        if (count <= 0) {
+            continue;  // Timeout or signal; check for stop
+        }
+        const int client = ::accept4(listen_fd_, nullptr, nullptr, SOCK_CLOEXEC);
+        if (client < 0) {
+            continue;
+        }
+        readRequest(client);
+        const std::string body = render();
+        std::ostringstream response;
+        response << "HTTP/1.0 200 OK\r\n"
+                 << "Content-Type: text/plain; version=0.0.4\r\n"
+                 << "Content-Length: " << body.size() << "\r\n\r\n"
+                 << body;
+        if (sendAll(client, response.str())) {
+            ++exports_;
+        } else {
+            setError("Metrics client disconnected: " + std::string(std::strerror(errno)));
+        }
+        ::close(client);
+    }
+}
+
+void PrometheusExporter::writeFile(const std::string& text) {
+    const std::string temporary = target_ + ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        file << text;
+        if (!file.flush()) {
+            throw std::runtime_error("Cannot write metrics file " + temporary);
+        }
+    }
+    if (std::rename(temporary.c_str(), target_.c_str()) != 0) {
+        throw std::system_error(errno, std::generic_category(), "Cannot replace metrics file " + target_);
+    }
+}
+
+void PrometheusExporter::setError(const std::string& error) {
+    std::lock_guard<std::mutex> lock(error_mutex_);
+    last_error_ = error;
+}
+
+std::string PrometheusExporter::getLastError() const {
+    std::lock_guard<std::mutex> lock(error_mutex_);
+    return last_error_;
+}
+
+std::string PrometheusExporter::render() {
+    std::vector<GeneratorStats> stats;
+    stats.reserve(generators_.size());
+    for (const IGenerator* generator : generators_) {
+        stats.push_back(generator->getStats());
+    }
+
+    std::lock_guard<std::mutex> lock(render_mutex_);
+    const auto now = std::chrono::steady_clock::now();
+    const double interval = last_frames_.empty() ? 0.0 : toSeconds(now - last_render_);
+    auto rate = [interval](uint64_t current, uint64_t previous) {
+        return interval > 0.0 && current >= previous ? static_cast<double>(current - previous) / interval : 0.0;
+    };
+
+    std::ostringstream out;
+    out << std::setprecision(9);
+    auto family = [&](const char* name, const char* type, const char* help, auto value) {
+        writeHeader(out, name, type, help);
+        for (size_t i = 0; i < stats.size(); ++i) {
+            out << name << "{channel=\"" << stats[i].channel << "\"} " << value(i, stats[i]) << '\n';
+        }
+    };
+
+    last_frames_.resize(stats.size(), 0);
+    family("sbg_frames_total", "counter", "Frames generated.",
+           [](size_t, const GeneratorStats& s) { return s.frames; });
+    family("sbg_frames_per_second", "gauge", "Frames generated per second since the previous export.",
+           [&](size_t i, const GeneratorStats& s) { return rate(s.frames, last_frames_[i]); });
+    family("sbg_ticks_total", "counter", "Generation ticks run.",
+           [](size_t, const GeneratorStats& s) { return s.ticks; });
+    family("sbg_missed_deadlines_total", "counter", "Tick deadlines skipped because they could no longer be met.",
+           [](size_t, const GeneratorStats& s) { return s.missed_deadlines; });
+    family("sbg_dropped_frames_total", "counter", "Frames dropped because the output queue was full.",
+           [](size_t, const GeneratorStats& s) { return s.dropped_frames; });
+    family("sbg_encode_errors_total", "counter", "Ticks that failed to generate their frames.",
+           [](size_t, const GeneratorStats& s) { return s.encode_errors; });
+    family("sbg_queue_depth", "gauge", "Frames waiting in the output queue.",
+           [](size_t, const GeneratorStats& s) { return s.queue_depth; });
+    family("sbg_queue_capacity", "gauge", "Capacity of the output queue in frames.",
+           [](size_t, const GeneratorStats& s) { return s.queue_capacity; });
+    family("sbg_tick_lateness_seconds", "gauge", "How late the most recent real-time tick started.",
+           [](size_t, const GeneratorStats& s) { return toSeconds(s.last_lateness); });
+    family("sbg_tick_lateness_max_seconds", "gauge", "Latest start of any real-time tick.",
+           [](size_t, const GeneratorStats& s) { return toSeconds(s.max_lateness); });
+    family("sbg_tick_lateness_seconds_total", "counter", "Sum of the lateness of every real-time tick.",
+           [](size_t, const GeneratorStats& s) { return toSeconds(s.total_lateness); });
+
+    auto signals = [&](const char* name, const char* type, const char* help, auto value) {
+        writeHeader(out, name, type, help);
+        for (size_t i = 0; i < stats.size(); ++i) {
+            for (const SignalStats& signal : stats[i].signals) {
+                out << name << "{channel=\"" << stats[i].channel << "\",protocol=\""
+                    << protocolName(signal.type) << "\",signal=\"" << signal.key << "\"} "
+                    << value(i, signal) << '\n';
+            }
+        }
+    };
+    signals("sbg_signal_frames_total", "counter", "Frames generated per ARINC429 label or J1939 PGN.",
+            [](size_t, const SignalStats& s) { return s.frames; });
+    signals("sbg_signal_frames_per_second", "gauge",
+            "Frames per second per ARINC429 label or J1939 PGN since the previous export.",
+            [&](size_t i, const SignalStats& s) {
+                auto it = last_signal_frames_.find(SignalKey{i, s.type, s.key});
+                return rate(s.frames, it != last_signal_frames_.end() ? it->second : 0);
+            });
+
+    // New baseline
+    last_render_ = now;
+    for (size_t i = 0; i < stats.size(); ++i) {
+        last_frames_[i] = stats[i].frames;
+        for (const SignalStats& signal : stats[i].signals) {
+            last_signal_frames_[SignalKey{i, signal.type, signal.key}] = signal.frames;
+        }
+    }
+    return out.str();
+}
+
+} // namespace serial_bus_generator
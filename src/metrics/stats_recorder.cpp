@@ -0,0 +1,89 @@
+#include "serial_bus_generator/metrics/stats_recorder.hpp"
+#include "serial_bus_generator/protocols/arinc429/arinc429_label_traits.hpp"
+#include "serial_bus_generator/protocols/canj1939/canj1939_message.hpp"
+#include <algorithm>
+
+namespace serial_bus_generator {
+
+StatsRecorder::StatsRecorder() {
+    for (auto& counter : arinc429_frames_) {
+        counter.store(0, std::memory_order_relaxed);
+    }
+}
+
+void StatsRecorder::recordLateness(std::chrono::nanoseconds lateness) {
+    const int64_t ns = std::max<int64_t>(lateness.count(), 0);
+    last_lateness_ns_.store(ns, std::memory_order_relaxed);
+    if (ns > max_lateness_ns_.load(std::memory_order_relaxed)) {
+        max_lateness_ns_.store(ns, std::memory_order_relaxed);
+    }
+    total_lateness_ns_.store(total_lateness_ns_.load(std::memory_order_relaxed) + ns,
+                             std::memory_order_relaxed);
+}
+
+static_assert(StatsRecorder::MAX_J1939_KEYS == 64, "The J1939 hash takes the top 6 bits");
+
+void StatsRecorder::addJ1939Frame(uint32_t key) {
+    // Fibonacci hashing spreads the few PGNs a channel sends over the table
+    const size_t index = (key * 0x9E3779B9u) >> 26;
+    for (size_t probe = 0; probe < MAX_J1939_KEYS; ++probe) {
+        J1939Slot& slot = j1939_frames_[(index + probe) & (MAX_J1939_KEYS - 1)];
+        const uint32_t slot_key = slot.key.load(std::memory_order_relaxed);
+        if (slot_key == key) {
+            bump(slot.frames, 1);
+            return;
+        }
+        if (slot_key == EMPTY_KEY) {
+            slot.frames.store(1, std::memory_order_relaxed);
+            slot.key.store(key, std::memory_order_release);
+            return;
+        }
+    }
+    // Table full: the frame still counts towards the total
+}
+
+void StatsRecorder::snapshot(GeneratorStats& stats) const {
+    stats.frames = frames_.load(std::memory_order_relaxed);
+    stats.ticks = ticks_.load(std::memory_order_relaxed);
+    stats.missed_deadlines = missed_deadlines_.load(std::memory_order_relaxed);
+    stats.dropped_frames = dropped_frames_.load(std::memory_order_relaxed);
+    stats.encode_errors = encode_errors_.load(std::memory_order_relaxed);
+    stats.last_lateness = std::chrono::nanoseconds(last_lateness_ns_.load(std::memory_order_relaxed));
+    stats.max_lateness = std::chrono::nanoseconds(max_lateness_ns_.load(std::memory_order_relaxed));
+    stats.total_lateness = std::chrono::nanoseconds(total_lateness_ns_.load(std::memory_order_relaxed));
+
+    stats.signals.clear();
+    for (uint32_t field = 0; field < arinc429_frames_.size(); ++field) {
+        const uint64_t frames = arinc429_frames_[field].load(std::memory_order_relaxed);
+        if (frames == 0) {
+            continue;
+        }
+        const ARINC429LabelCodec* codec = findWordCodec(field);
+        const uint32_t key = codec ? static_cast<uint32_t>(codec->spec->label) : field;
+        stats.signals.push_back(SignalStats{MessageType::ARINC429, key, frames});
+    }
+
+    // PDU1 identifiers addressed to different nodes fold into one PGN
+    const size_t arinc429_count = stats.signals.size();
+    for (const J1939Slot& slot : j1939_frames_) {
+        const uint32_t raw = slot.key.load(std::memory_order_acquire);
+        if (raw == EMPTY_KEY) {
+            continue;
+        }
+        const uint64_t frames = slot.frames.load(std::memory_order_relaxed);
+        const uint32_t pgn = static_cast<uint32_t>(CANJ1939Message::pgnFromIdentifier(raw << 8));
+        auto it = std::find_if(stats.signals.begin() + arinc429_count, stats.signals.end(),
+                               [pgn](const SignalStats& signal) { return signal.key == pgn; });
+        if (it != stats.signals.end()) {
+            it->frames += frames;
+        } else {
+            stats.signals.push_back(SignalStats{MessageType::CANJ1939, pgn, frames});
+        }
+    }
+    std::sort(stats.signals.begin(), stats.signals.end(),
+              [](const SignalStats& a, const SignalStats& b) {
+                  return a.type != b.type ? a.type < b.type : a.key < b.key;
+              });
+}
+
+} // namespace serial_bus_generator
@@ -0,0 +1,421 @@
+#include "serial_bus_generator/protocols/arinc429/arinc429_codec.hpp"
+#include "serial_bus_generator/protocols/arinc429/arinc429_label_traits.hpp"
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define SBG_X86_KERNELS 1
+#endif
+
+namespace serial_bus_generator {
+
+namespace {
+
+// Lane parameters derived from the label database, indexed by the 8-bit
+// label field. The vector kernels apply the same clamp, scale, truncation
+// and mask as ARINC429LabelTraits so their words and values match it.
+struct CodecTables {
+    int32_t known[256];          // All ones for a supported label field
+    int32_t vector[256];         // All ones where the vector kernels apply (not BCD)
+    int32_t sign_bit[256];       // ARINC429_SIGN_BIT for signed labels
+    int32_t magnitude_mask[256];
+    float encode_scale[256];
+    float decode_scale[256];
+    float min_value[256];
+    float max_value[256];
+};
+
+CodecTables makeTables() {
+    CodecTables tables{};
+    for (int i = 0; i < 256; ++i) {
+        tables.vector[i] = -1;  // Unsupported fields decode to NaN without scalar help
+    }
+
+    for (const ARINC429LabelSpec& spec : ARINC429_LABEL_SPECS) {
+        const size_t index = static_cast<uint16_t>(spec.label) & 0xFF;
+        tables.known[index] = -1;
+        tables.vector[index] = spec.format == ARINC429Format::BCD ? 0 : -1;
+        tables.sign_bit[index] = spec.is_signed ? ARINC429_SIGN_BIT : 0;
+        tables.magnitude_mask[index] = static_cast<int32_t>((1u << spec.bits) - 1);
+        tables.encode_scale[index] = 1.0f / spec.resolution;
+        tables.decode_scale[index] = spec.resolution;
+        tables.min_value[index] = spec.min_value;
+        tables.max_value[index] = spec.max_value;
+    }
+    return tables;
+}
+
+const CodecTables& tables() {
+    static const CodecTables instance = makeTables();
+    return instance;
+}
+
+inline uint32_t foldParity(uint32_t word) {
+    word ^= word >> 16;
+    word ^= word >> 8;
+    word ^= word >> 4;
+    word ^= word >> 2;
+    word ^= word >> 1;
+    return word & 1;
+}
+
+inline uint32_t encodeScalar(ARINC429Label label, float value, ARINC429SSM ssm) {
+    const ARINC429LabelCodec& codec = ARINC429_LABEL_DISPATCH[static_cast<uint16_t>(label) & 0xFF];
+    uint32_t word = static_cast<uint16_t>(label) & 0xFF;
+    word |= (codec.encode(value) & ARINC429_DATA_MASK) << 8;
+    word |= (static_cast<uint32_t>(ssm) & 0x03) << 29;
+    word |= (foldParity(word) ^ 1) << 31;  // Odd parity
+    return word;
+}
+
+inline float decodeScalar(uint32_t word) {
+    const ARINC429LabelCodec& codec = ARINC429_LABEL_DISPATCH[word & 0xFF];
+    if (!codec.spec) {
+        return std::numeric_limits<float>::quiet_NaN();
+    }
+    return codec.decode((word >> 8) & ARINC429_DATA_MASK);
+}
+
+void encodeBlockScalar(const ARINC429Label* labels, const float* values,
+                       const ARINC429SSM* ssms, uint32_t* words, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        words[i] = encodeScalar(labels[i], values[i], ssms[i]);
+    }
+}
+
+size_t decodeBlockScalar(const uint32_t* words, float* values, size_t count) {
+    size_t unknown = 0;
+    for (size_t i = 0; i < count; ++i) {
+        values[i] = decodeScalar(words[i]);
+        unknown += ARINC429_LABEL_DISPATCH[words[i] & 0xFF].spec ? 0 : 1;
+    }
+    return unknown;
+}
+
+size_t parityBlockScalar(const uint32_t* words, uint8_t* valid, size_t count) {
+    size_t failed = 0;
+    for (size_t i = 0; i < count; ++i) {
+        valid[i] = static_cast<uint8_t>(foldParity(words[i]));  // Odd across all 32 bits
+        failed += valid[i] ^ 1;
+    }
+    return failed;
+}
+
+#ifdef SBG_X86_KERNELS
+
+__attribute__((target("avx2")))
+inline __m256i foldParity8(__m256i w) {
+    w = _mm256_xor_si256(w, _mm256_srli_epi32(w, 16));
+    w = _mm256_xor_si256(w, _mm256_srli_epi32(w, 8));
+    w = _mm256_xor_si256(w, _mm256_srli_epi32(w, 4));
+    w = _mm256_xor_si256(w, _mm256_srli_epi32(w, 2));
+    w = _mm256_xor_si256(w, _mm256_srli_epi32(w, 1));
+    return _mm256_and_si256(w, _mm256_set1_epi32(1));
+}
+
+__attribute__((target("avx2")))
+void encodeAvx2(const CodecTables& t, const ARINC429Label* labels, const float* values,
+                const ARINC429SSM* ssms, uint32_t* words, size_t count) {
+    const __m256i label_mask = _mm256_set1_epi32(0xFF);
+    const __m256i ssm_mask = _mm256_set1_epi32(0x03);
+    const __m256i one = _mm256_set1_epi32(1);
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256 abs_mask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m256i label = _mm256_cvtepu16_epi32(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(labels + i)));
+        const __m256i index = _mm256_and_si256(label, label_mask);
+        if (_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_i32gather_epi32(t.vector, index, 4))) != 0xFF) {
+            encodeBlockScalar(labels + i, values + i, ssms + i, words + i, 8);  // BCD lanes
+            continue;
+        }
+        const __m256i sign_bit = _mm256_i32gather_epi32(t.sign_bit, index, 4);
+        const __m256i magnitude_mask = _mm256_i32gather_epi32(t.magnitude_mask, index, 4);
+
+        // Clamp; a NaN takes the upper bound as std::fmin does
+        __m256 value = _mm256_min_ps(_mm256_loadu_ps(values + i), _mm256_i32gather_ps(t.max_value, index, 4));
+        value = _mm256_max_ps(value, _mm256_i32gather_ps(t.min_value, index, 4));
+
+        const __m256 is_signed = _mm256_castsi256_ps(_mm256_cmpgt_epi32(sign_bit, zero));
+        const __m256 magnitude_f = _mm256_blendv_ps(value, _mm256_and_ps(value, abs_mask), is_signed);
+        const __m256i magnitude = _mm256_and_si256(
+            _mm256_cvttps_epi32(_mm256_mul_ps(magnitude_f, _mm256_i32gather_ps(t.encode_scale, index, 4))),
+            magnitude_mask);
+
+        // Sign only for a non-zero magnitude
+        const __m256i negative = _mm256_andnot_si256(_mm256_cmpeq_epi32(magnitude, zero),
+                                                     _mm256_srai_epi32(_mm256_castps_si256(value), 31));
+        const __m256i field = _mm256_or_si256(magnitude, _mm256_and_si256(negative, sign_bit));
+
+        const __m256i ssm = _mm256_cvtepu8_epi32(
+            _mm_loadl_epi64(reinterpret_cast<const __m128i*>(ssms + i)));
+        __m256i word = _mm256_or_si256(index, _mm256_slli_epi32(field, 8));
+        word = _mm256_or_si256(word, _mm256_slli_epi32(_mm256_and_si256(ssm, ssm_mask), 29));
+        word = _mm256_or_si256(word, _mm256_slli_epi32(_mm256_xor_si256(foldParity8(word), one), 31));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(words + i), word);
+    }
+    encodeBlockScalar(labels + i, values + i, ssms + i, words + i, count - i);
+}
+
+__attribute__((target("avx2")))
+size_t decodeAvx2(const CodecTables& t, const uint32_t* words, float* values, size_t count) {
+    const __m256i label_mask = _mm256_set1_epi32(0xFF);
+    const __m256i data_mask = _mm256_set1_epi32(ARINC429_DATA_MASK);
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256 sign_flip = _mm256_set1_ps(-0.0f);
+    const __m256 nan = _mm256_set1_ps(std::numeric_limits<float>::quiet_NaN());
+
+    size_t unknown = 0;
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m256i word = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words + i));
+        const __m256i index = _mm256_and_si256(word, label_mask);
+        if (_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_i32gather_epi32(t.vector, index, 4))) != 0xFF) {
+            unknown += decodeBlockScalar(words + i, values + i, 8);  // BCD lanes
+            continue;
+        }
+        const __m256 known = _mm256_castsi256_ps(_mm256_i32gather_epi32(t.known, index, 4));
+        const __m256i sign_bit = _mm256_i32gather_epi32(t.sign_bit, index, 4);
+        const __m256i magnitude_mask = _mm256_i32gather_epi32(t.magnitude_mask, index, 4);
+
+        const __m256i field = _mm256_and_si256(_mm256_srli_epi32(word, 8), data_mask);
+        __m256 value = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_and_si256(field, magnitude_mask)),
+                                     _mm256_i32gather_ps(t.decode_scale, index, 4));
+        const __m256 negative = _mm256_castsi256_ps(_mm256_cmpgt_epi32(_mm256_and_si256(field, sign_bit), zero));
+        value = _mm256_xor_ps(value, _mm256_and_ps(negative, sign_flip));
+        value = _mm256_blendv_ps(nan, value, known);
+
+        _mm256_storeu_ps(values + i, value);
+        unknown += 8 - __builtin_popcount(_mm256_movemask_ps(known));
+    }
+    return unknown + decodeBlockScalar(words + i, values + i, count - i);
+}
+
+__attribute__((target("avx2")))
+size_t parityAvx2(const uint32_t* words, uint8_t* valid, size_t count) {
+    size_t failed = 0;
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m256i word = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words + i));
+        const __m256i odd = foldParity8(word);
+        // Narrow the 0/1 lanes to bytes
+        const __m128i packed16 = _mm_packus_epi32(_mm256_castsi256_si128(odd),
+                                                  _mm256_extracti128_si256(odd, 1));
+        const __m128i packed8 = _mm_packus_epi16(packed16, packed16);
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(valid + i), packed8);
+        failed += 8 - __builtin_popcount(_mm256_movemask_ps(
+            _mm256_castsi256_ps(_mm256_slli_epi32(odd, 31))));
+    }
+    return failed + parityBlockScalar(words + i, valid + i, count - i);
+}
+
+__attribute__((target("sse4.1")))
+inline __m128i foldParity4(__m128i w) {
+    w = _mm_xor_si128(w, _mm_srli_epi32(w, 16));
+    w = _mm_xor_si128(w, _mm_srli_epi32(w, 8));
+    w = _mm_xor_si128(w, _mm_srli_epi32(w, 4));
+    w = _mm_xor_si128(w, _mm_srli_epi32(w, 2));
+    w = _mm_xor_si128(w, _mm_srli_epi32(w, 1));
+    return _mm_and_si128(w, _mm_set1_epi32(1));
+}
+
+// SSE4.1 has no gather; lanes are assembled from scalar table loads
+#define SBG_LANES(table, i0, i1, i2, i3) table[i0], table[i1], table[i2], table[i3]
+
+__attribute__((target("sse4.1")))
+void encodeSse41(const CodecTables& t, const ARINC429Label* labels, const float* values,
+                 const ARINC429SSM* ssms, uint32_t* words, size_t count) {
+    const __m128i ssm_mask = _mm_set1_epi32(0x03);
+    const __m128i one = _mm_set1_epi32(1);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128 abs_mask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const size_t i0 = static_cast<uint16_t>(labels[i]) & 0xFF;
+        const size_t i1 = static_cast<uint16_t>(labels[i + 1]) & 0xFF;
+        const size_t i2 = static_cast<uint16_t>(labels[i + 2]) & 0xFF;
+        const size_t i3 = static_cast<uint16_t>(labels[i + 3]) & 0xFF;
+        if (!(t.vector[i0] & t.vector[i1] & t.vector[i2] & t.vector[i3])) {
+            encodeBlockScalar(labels + i, values + i, ssms + i, words + i, 4);  // BCD lanes
+            continue;
+        }
+        const __m128i index = _mm_setr_epi32(i0, i1, i2, i3);
+        const __m128i sign_bit = _mm_setr_epi32(SBG_LANES(t.sign_bit, i0, i1, i2, i3));
+        const __m128i magnitude_mask = _mm_setr_epi32(SBG_LANES(t.magnitude_mask, i0, i1, i2, i3));
+
+        // Clamp; a NaN takes the upper bound as std::fmin does
+        __m128 value = _mm_min_ps(_mm_loadu_ps(values + i), _mm_setr_ps(SBG_LANES(t.max_value, i0, i1, i2, i3)));
+        value = _mm_max_ps(value, _mm_setr_ps(SBG_LANES(t.min_value, i0, i1, i2, i3)));
+
+        const __m128 is_signed = _mm_castsi128_ps(_mm_cmpgt_epi32(sign_bit, zero));
+        const __m128 magnitude_f = _mm_blendv_ps(value, _mm_and_ps(value, abs_mask), is_signed);
+        const __m128i magnitude = _mm_and_si128(
+            _mm_cvttps_epi32(_mm_mul_ps(magnitude_f, _mm_setr_ps(SBG_LANES(t.encode_scale, i0, i1, i2, i3)))),
+            magnitude_mask);
+
+        // Sign only for a non-zero magnitude
+        const __m128i negative = _mm_andnot_si128(_mm_cmpeq_epi32(magnitude, zero),
+                                                  _mm_srai_epi32(_mm_castps_si128(value), 31));
+        const __m128i field = _mm_or_si128(magnitude, _mm_and_si128(negative, sign_bit));
+
+        int32_t ssm_bytes;
+        static_assert(sizeof(ARINC429SSM) == 1, "SSM is loaded as bytes");
+        std::memcpy(&ssm_bytes, ssms + i, sizeof(ssm_bytes));
+        const __m128i ssm = _mm_cvtepu8_epi32(_mm_cvtsi32_si128(ssm_bytes));
+        __m128i word = _mm_or_si128(index, _mm_slli_epi32(field, 8));
+        word = _mm_or_si128(word, _mm_slli_epi32(_mm_and_si128(ssm, ssm_mask), 29));
+        word = _mm_or_si128(word, _mm_slli_epi32(_mm_xor_si128(foldParity4(word), one), 31));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(words + i), word);
+    }
+    encodeBlockScalar(labels + i, values + i, ssms + i, words + i, count - i);
+}
+
+__attribute__((target("sse4.1")))
+size_t decodeSse41(const CodecTables& t, const uint32_t* words, float* values, size_t count) {
+    const __m128i data_mask = _mm_set1_epi32(ARINC429_DATA_MASK);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128 sign_flip = _mm_set1_ps(-0.0f);
+    const __m128 nan = _mm_set1_ps(std::numeric_limits<float>::quiet_NaN());
+
+    size_t unknown = 0;
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const size_t i0 = words[i] & 0xFF, i1 = words[i + 1] & 0xFF;
+        const size_t i2 = words[i + 2] & 0xFF, i3 = words[i + 3] & 0xFF;
+        if (!(t.vector[i0] & t.vector[i1] & t.vector[i2] & t.vector[i3])) {
+            unknown += decodeBlockScalar(words + i, values + i, 4);  // BCD lanes
+            continue;
+        }
+        const __m128 known = _mm_castsi128_ps(_mm_setr_epi32(SBG_LANES(t.known, i0, i1, i2, i3)));
+        const __m128i sign_bit = _mm_setr_epi32(SBG_LANES(t.sign_bit, i0, i1, i2, i3));
+        const __m128i magnitude_mask = _mm_setr_epi32(SBG_LANES(t.magnitude_mask, i0, i1, i2, i3));
+
+        const __m128i word = _mm_loadu_si128(reinterpret_cast<const __m128i*>(words + i));
+        const __m128i field = _mm_and_si128(_mm_srli_epi32(word, 8), data_mask);
+        __m128 value = _mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(field, magnitude_mask)),
+                                  _mm_setr_ps(SBG_LANES(t.decode_scale, i0, i1, i2, i3)));
+        const __m128 negative = _mm_castsi128_ps(_mm_cmpgt_epi32(_mm_and_si128(field, sign_bit), zero));
+        value = _mm_xor_ps(value, _mm_and_ps(negative, sign_flip));
+        value = _mm_blendv_ps(nan, value, known);
+
+        _mm_storeu_ps(values + i, value);
+        unknown += 4 - __builtin_popcount(_mm_movemask_ps(known));
+    }
+    return unknown + decodeBlockScalar(words + i, values + i, count - i);
+}
+
+#undef SBG_LANES
+
+__attribute__((target("sse4.1")))
+size_t paritySse41(const uint32_t* words, uint8_t* valid, size_t count) {
+    size_t failed = 0;
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m128i word = _mm_loadu_si128(reinterpret_cast<const __m128i*>(words + i));
+        const __m128i odd = foldParity4(word);
+        const __m128i packed16 = _mm_packus_epi32(odd, odd);
+        const int32_t packed8 = _mm_cvtsi128_si32(_mm_packus_epi16(packed16, packed16));
+        std::memcpy(valid + i, &packed8, sizeof(packed8));
+        failed += 4 - __builtin_popcount(_mm_movemask_ps(_mm_castsi128_ps(_mm_slli_epi32(odd, 31))));
+    }
+    return failed + parityBlockScalar(words + i, valid + i, count - i);
+}
+
+#endif  // SBG_X86_KERNELS
+
+} // namespace
+
+ARINC429BatchCodec::ARINC429BatchCodec()
+    : kernel_(bestKernel())
+{}
+
+ARINC429BatchCodec::ARINC429BatchCodec(Kernel kernel)
+    : kernel_(kernel)
+{
+    if (!isSupported(kernel)) {
+        throw std::invalid_argument("Codec kernel is not supported on this CPU");
+    }
+}
+
+bool ARINC429BatchCodec::isSupported(Kernel kernel) {
+    switch (kernel) {
+        case Kernel::SCALAR:
+            return true;
+#ifdef SBG_X86_KERNELS
+        case Kernel::SSE41:
+            return __builtin_cpu_supports("sse4.1");
+        case Kernel::AVX2:
+            return __builtin_cpu_supports("avx2");
+#endif
+        default:
+            return false;
+    }
+}
+
+ARINC429BatchCodec::Kernel ARINC429BatchCodec::bestKernel() {
+    if (isSupported(Kernel::AVX2)) {
+        return Kernel::AVX2;
+    }
+    if (isSupported(Kernel::SSE41)) {
+        return Kernel::SSE41;
+    }
+    return Kernel::SCALAR;
+}
+
+void ARINC429BatchCodec::encode(const ARINC429Label* labels, const float* values,
+                                const ARINC429SSM* ssms, uint32_t* words, size_t count) const {
+    [[maybe_unused]] const CodecTables& t = tables();
+    for (size_t i = 0; i < count; ++i) {
+        if (!findLabelCodec(labels[i])) {
+            throw MessageValidationError("Invalid ARINC429 label");
+        }
+    }
+
+    switch (kernel_) {
+#ifdef SBG_X86_KERNELS
+        case Kernel::AVX2:
+            encodeAvx2(t, labels, values, ssms, words, count);
+            return;
+        case Kernel::SSE41:
+            encodeSse41(t, labels, values, ssms, words, count);
+            return;
+#endif
+        default:
+            encodeBlockScalar(labels, values, ssms, words, count);
+            return;
+    }
+}
+
+size_t ARINC429BatchCodec::decode(const uint32_t* words, float* values, size_t count) const {
+    [[maybe_unused]] const CodecTables& t = tables();
+    switch (kernel_) {
+#ifdef SBG_X86_KERNELS
+        case Kernel::AVX2:
+            return decodeAvx2(t, words, values, count);
+        case Kernel::SSE41:
+            return decodeSse41(t, words, values, count);
+#endif
+        default:
+            return decodeBlockScalar(words, values, count);
+    }
+}
+
+size_t ARINC429BatchCodec::verifyParity(const uint32_t* words, uint8_t* valid, size_t count) const {
+    switch (kernel_) {
+#ifdef SBG_X86_KERNELS
+        case Kernel::AVX2:
+            return parityAvx2(words, valid, count);
+        case Kernel::SSE41:
+            return paritySse41(words, valid, count);
+#endif
+        default:
+            return parityBlockScalar(words, valid, count);
+    }
+}
+
+} // namespace serial_bus_generator
\ No newline at end of file
@@ -0,0 +1,202 @@
+#include "serial_bus_generator/protocols/arinc429/arinc429_fleet.hpp"
+#include "serial_bus_generator/trace/tracer.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+namespace serial_bus_generator {
+
+namespace {
+
+constexpr double TURNAROUND_TIME = ARINC429Generator::TURNAROUND_TIME;
+
+// Keeps jittered end points on the globe for routes near a pole or the antimeridian
+GeoPoint jitterPoint(const GeoPoint& point, double latitude, double longitude) {
+    return {std::max(-90.0, std::min(90.0, point.latitude + latitude)),
+            std::remainder(point.longitude + longitude, 360.0)};
+}
+
+} // namespace
+
+ARINC429Fleet::ARINC429Fleet(size_t aircraft, const CounterRng& rng, uint16_t channel,
+                             const GeoPoint& start, const GeoPoint& end)
+    : latitude_(aircraft)
+    , longitude_(aircraft)
+    , altitude_(aircraft)
+    , ground_speed_(aircraft)
+    , track_(aircraft)
+    , latitude_rate_(aircraft)
+    , longitude_rate_(aircraft)
+    , climb_rate_(aircraft)
+    , acceleration_(aircraft)
+    , track_rate_(aircraft)
+    , segment_left_(aircraft)
+    , segment_(aircraft)
+    , phase_(aircraft)
+    , origin_(aircraft)
+    , destination_(aircraft)
+    , labels_(aircraft)
+    , values_(aircraft)
+    , ssms_(aircraft, ARINC429SSM::NORMAL_OPERATION)
+    , words_(aircraft)
+{
+    if (aircraft == 0 || aircraft > MAX_AIRCRAFT) {
+        throw std::invalid_argument("Fleet size must be 1 to 65536 aircraft");
+    }
+
+    const auto jitter = [](uint32_t bits) {
+        return static_cast<double>(CounterRng::toRange(bits, -ROUTE_SPREAD, ROUTE_SPREAD));
+    };
+
+    trajectories_.reserve(aircraft);
+    for (size_t i = 0; i < aircraft; ++i) {
+        const CounterRng::Block route = rng(channel, static_cast<uint32_t>(i), 0, 0);
+        const CounterRng::Block cycle = rng(channel, static_cast<uint32_t>(i), 0, 1);
+        origin_[i] = jitterPoint(start, jitter(route[0]), jitter(route[1]));
+        destination_[i] = jitterPoint(end, jitter(route[2]), jitter(route[3]));
+        if (i & 1) {
+            std::swap(origin_[i], destination_[i]);  // Half the fleet flies the return leg
+        }
+
+        // Begin at a random point of the flight and turnaround cycle
+        trajectories_.emplace_back(origin_[i], destination_[i], ARINC429Generator::flightProfile(),
+                                   ROUTE_SEGMENTS);
+        const FlightTrajectory& trajectory = trajectories_.back();
+        const double offset = CounterRng::toUnit(cycle[0]) * (trajectory.getDuration() + TURNAROUND_TIME);
+        const size_t segment = trajectory.findSegment(offset);
+        enterSegment(i, segment, segment < trajectory.getSegmentCount()
+            ? offset - trajectory.getSegment(segment).start_time
+            : offset - trajectory.getDuration());
+    }
+}
+
+void ARINC429Fleet::enterSegment(size_t i, size_t segment, double elapsed) {
+    const FlightTrajectory& trajectory = trajectories_[i];
+    while (segment < trajectory.getSegmentCount() && elapsed >= trajectory.getSegment(segment).duration) {
+        elapsed -= trajectory.getSegment(segment).duration;
+        ++segment;
+    }
+    segment_[i] = static_cast<uint32_t>(segment);
+
+    if (segment == trajectory.getSegmentCount()) {
+        latitude_[i] = trajectory.getDestination().latitude;
+        longitude_[i] = trajectory.getDestination().longitude;
+        altitude_[i] = 0.0;
+        ground_speed_[i] = 0.0;
+        latitude_rate_[i] = 0.0;
+        longitude_rate_[i] = 0.0;
+        climb_rate_[i] = 0.0;
+        acceleration_[i] = 0.0;
+        track_rate_[i] = 0.0;  // Parked facing the way it arrived
+        segment_left_[i] = TURNAROUND_TIME - elapsed;
+        phase_[i] = FlightPhase::STOPPED;
+        return;
+    }
+
+    const FlightTrajectory::Segment& current = trajectory.getSegment(segment);
+    const FlightTrajectory::State state = FlightTrajectory::advanceWithin(current, elapsed);
+    latitude_[i] = state.latitude;
+    longitude_[i] = state.longitude;
+    altitude_[i] = state.altitude;
+    ground_speed_[i] = state.ground_speed;
+    track_[i] = state.track;
+    latitude_rate_[i] = current.latitude_rate;
+    longitude_rate_[i] = current.longitude_rate;
+    climb_rate_[i] = current.climb_rate;
+    acceleration_[i] = current.acceleration;
+    track_rate_[i] = current.track_rate;
+    segment_left_[i] = current.duration - elapsed;
+    phase_[i] = state.phase;
+}
+
+void ARINC429Fleet::startFlight(size_t i, double elapsed) {
+    std::swap(origin_[i], destination_[i]);
+    trajectories_[i] = FlightTrajectory(origin_[i], destination_[i], ARINC429Generator::flightProfile(),
+                                        ROUTE_SEGMENTS);
+    enterSegment(i, 0, elapsed);
+}
+
+void ARINC429Fleet::update(std::chrono::nanoseconds delta_time) {
+    const double dt = std::chrono::duration<double>(delta_time).count();
+    const size_t count = size();
+
+    // Every aircraft moves at its current segment's rates, so this loop
+    // has no branches and vectorizes across aircraft
+    double* __restrict latitude = latitude_.data();
+    double* __restrict longitude = longitude_.data();
+    double* __restrict altitude = altitude_.data();
+    double* __restrict ground_speed = ground_speed_.data();
+    double* __restrict track = track_.data();
+    double* __restrict segment_left = segment_left_.data();
+    const double* __restrict latitude_rate = latitude_rate_.data();
+    const double* __restrict longitude_rate = longitude_rate_.data();
+    const double* __restrict climb_rate = climb_rate_.data();
+    const double* __restrict acceleration = acceleration_.data();
+    const double* __restrict track_rate = track_rate_.data();
+    for (size_t i = 0; i < count; ++i) {
+        latitude[i] += latitude_rate[i] * dt;
+        const double lon = longitude[i] + longitude_rate[i] * dt;
+        longitude[i] = lon >= 180.0 ? lon - 360.0 : (lon < -180.0 ? lon + 360.0 : lon);
+        altitude[i] = std::max(0.0, altitude[i] + climb_rate[i] * dt);
+        ground_speed[i] = std::max(0.0, ground_speed[i] + acceleration[i] * dt);
+        const double heading = track[i] + track_rate[i] * dt;
+        track[i] = heading >= 360.0 ? heading - 360.0 : (heading < 0.0 ? heading + 360.0 : heading);
+        segment_left[i] -= dt;
+    }
+
+    // Segments last minutes, so this branch is rarely taken
+    for (size_t i = 0; i < count; ++i) {
+        if (segment_left[i] <= 0.0) {
+            const double overshoot = -segment_left[i];
+            if (phase_[i] == FlightPhase::STOPPED) {
+                startFlight(i, overshoot);
+            } else {
+                enterSegment(i, segment_[i] + 1, overshoot);
+            }
+            // The value is the aircraft; its channel is only known to appendLabel()
+            SBG_TRACE_INSTANT("phase", Tracer::NO_CHANNEL, flightPhaseName(phase_[i]), static_cast<int64_t>(i));
+        }
+    }
+}
+
+void ARINC429Fleet::appendLabel(ARINC429Label label, uint64_t timestamp_ns, uint16_t first_channel,
+                                FrameBatch& batch) {
+    const double* source;
+    double scale = 1.0;
+    switch (label) {
+        case ARINC429Label::LATITUDE: source = latitude_.data(); break;
+        case ARINC429Label::LONGITUDE: source = longitude_.data(); break;
+        case ARINC429Label::GROUND_SPEED: source = ground_speed_.data(); break;
+        case ARINC429Label::ALTITUDE: source = altitude_.data(); break;
+        case ARINC429Label::TRACK_HEADING: source = track_.data(); break;
+        case ARINC429Label::VERTICAL_SPEED: source = climb_rate_.data(); scale = 60.0; break;
+        case ARINC429Label::EQUIPMENT_STATUS: source = nullptr; break;
+        default:
+            throw std::invalid_argument("No generator for ARINC429 label");
+    }
+
+    const size_t count = size();
+    if (label == ARINC429Label::TRACK_HEADING) {
+        // BNR track is signed: 180 to 360 degrees go out as -180 to 0
+        for (size_t i = 0; i < count; ++i) {
+            values_[i] = static_cast<float>(source[i] > 180.0 ? source[i] - 360.0 : source[i]);
+        }
+    } else if (source) {
+        for (size_t i = 0; i < count; ++i) {
+            values_[i] = static_cast<float>(source[i] * scale);
+        }
+    } else {
+        std::fill(values_.begin(), values_.end(), 1.0f);
+    }
+    std::fill(labels_.begin(), labels_.end(), label);
+    codec_.encode(labels_.data(), values_.data(), ssms_.data(), words_.data(), count);
+
+    for (size_t i = 0; i < count; ++i) {
+        Frame frame = ARINC429Message::makeFrame(words_[i], timestamp_ns);
+        frame.channel = static_cast<uint16_t>(first_channel + i);
+        batch.push(frame);
+    }
+}
+
+} // namespace serial_bus_generator
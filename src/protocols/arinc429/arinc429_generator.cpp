@@ -1,189 +1,305 @@
 #include "serial_bus_generator/protocols/arinc429/arinc429_generator.hpp"
-#include <cmath>
+#include "serial_bus_generator/protocols/arinc429/arinc429_fleet.hpp"
+#include "serial_bus_generator/trace/tracer.hpp"
+#include <bitset>
+#include <stdexcept>
 
 namespace serial_bus_generator {
 
+using namespace std::chrono_literals;
+
+namespace {
+
+constexpr uint32_t PARITY_BIT = 1u << 31;
+constexpr uint32_t SSM_MASK = 0x3u << 29;
+
+// Replaces the SSM and keeps the word's parity odd
+uint32_t withSSM(uint32_t word, ARINC429SSM ssm) {
+    const uint32_t changed = (word ^ (static_cast<uint32_t>(ssm) << 29)) & SSM_MASK;
+    word ^= changed;
+    if (std::bitset<32>(changed).count() & 1) {
+        word ^= PARITY_BIT;
+    }
+    return word;
+}
+
+// Corrupts an encoded word the way a failing transmitter would
+void injectFault(FaultKind kind, Frame& frame) {
+    uint32_t word = frame.id;
+    switch (kind) {
+        case FaultKind::PARITY_ERROR:
+            word ^= PARITY_BIT;
+            break;
+        case FaultKind::SSM_FAILURE:
+            word = withSSM(word, ARINC429SSM::FAILURE_WARNING);
+            break;
+        case FaultKind::NO_COMPUTED_DATA:
+            word = withSSM(word, ARINC429SSM::NO_COMPUTED_DATA);
+            break;
+        default:
+            return;
+    }
+    const uint16_t channel = frame.channel;
+    frame = ARINC429Message::makeFrame(word, frame.timestamp_ns);
+    frame.channel = channel;
+}
+
+} // namespace
+
 ARINC429Generator::ARINC429Generator()
-    : rng_(std::random_device{}())
-    , status_dist_(0.0f, 1.0f)
+    : trajectory_(START_POINT, END_POINT, flightProfile())
+    , cursor_(trajectory_)
 {
-    flight_state_.latitude = START_POINT.latitude;
-    flight_state_.longitude = START_POINT.longitude;
-    flight_state_.altitude = 0.0;
-    flight_state_.ground_speed = 0.0;
-    flight_state_.vertical_speed = 0.0;
-    calculateInitialTrack();
-}
-
-void ARINC429Generator::calculateInitialTrack() {
-    // Calculate initial bearing between start and end points
-    double lat1 = START_POINT.latitude * M_PI / 180.0;
-    double lat2 = END_POINT.latitude * M_PI / 180.0;
-    double dLon = (END_POINT.longitude - START_POINT.longitude) * M_PI / 180.0;
-
-    double y = sin(dLon) * cos(lat2);
-    double x = cos(lat1) * sin(lat2) - sin(lat1) * cos(lat2) * cos(dLon);
-    double initial_bearing = atan2(y, x);
-    
-    // Convert from radians to degrees
-    flight_state_.track = fmod((initial_bearing * 180.0 / M_PI + 360.0), 360.0);
-}
-
-void ARINC429Generator::startGeneration() {
-    last_updates_.clear();
-    current_phase_ = FlightPhase::TAKEOFF;
-    phase_start_time_ = std::chrono::steady_clock::now();
-    DataGenerator::startGeneration();
+    // Typical refresh intervals, staggered so labels do not burst on one tick
+    schedule_.addEntry(static_cast<uint32_t>(ARINC429Label::LATITUDE), 200ms, 0ms);
+    schedule_.addEntry(static_cast<uint32_t>(ARINC429Label::LONGITUDE), 200ms, 5ms);
+    schedule_.addEntry(static_cast<uint32_t>(ARINC429Label::GROUND_SPEED), 100ms, 10ms);
+    schedule_.addEntry(static_cast<uint32_t>(ARINC429Label::ALTITUDE), 50ms, 15ms);
+    schedule_.addEntry(static_cast<uint32_t>(ARINC429Label::EQUIPMENT_STATUS), 1000ms, 20ms);
 }
 
-std::vector<std::unique_ptr<IMessage>> ARINC429Generator::generateMessages(std::chrono::milliseconds delta_time) {
-    updateFlightState(delta_time);
-    
-    std::vector<std::unique_ptr<IMessage>> messages;
-    messages.push_back(generateLatitudeMessage());
-    messages.push_back(generateLongitudeMessage());
-    messages.push_back(generateSpeedMessage());
-    messages.push_back(generateAltitudeMessage());
-    return messages;
+ARINC429Generator::~ARINC429Generator() {
+    // Join the generation thread while the overrides it calls still exist
+    stop();
 }
 
-void ARINC429Generator::updateFlightState(std::chrono::milliseconds delta_time) {
-    auto now = std::chrono::steady_clock::now();
-    double phase_elapsed = std::chrono::duration<double>(now - phase_start_time_).count();
-    
-    if (phase_elapsed > PHASE_DURATION) {
-        transitionToNextPhase();
-        return;
+void ARINC429Generator::setLabelPeriod(ARINC429Label label, std::chrono::nanoseconds period) {
+    if (getState() == GeneratorState::RUNNING) {
+        throw std::logic_error("Cannot change label periods while running");
     }
+    size_t entry = schedule_.findEntry(static_cast<uint32_t>(label));
+    if (entry == schedule_.size()) {
+        throw std::invalid_argument("Label is not scheduled");
+    }
+    schedule_.setPeriod(entry, period);
+}
 
-    double delta_seconds = delta_time.count() / 1000.0;
-    
-    // Calculate position changes based on speed and track
-    // Convert speed from knots to degrees per second (approximate at given latitude)
-    const double KNOTS_TO_DEGREES_PER_SECOND = 1.0 / 3600.0;  // rough approximation
-    double distance = flight_state_.ground_speed * delta_seconds * KNOTS_TO_DEGREES_PER_SECOND;
-    
-    // Calculate lat/lon changes based on track angle
-    double track_rad = flight_state_.track * M_PI / 180.0;
-    double lat_change = distance * cos(track_rad);
-    double lon_change = distance * sin(track_rad);
-    
-    switch (current_phase_) {
-        case FlightPhase::TAKEOFF:
-            flight_state_.altitude += TAKEOFF_RATE * delta_seconds / 60.0;
-            flight_state_.ground_speed = std::min(CRUISE_SPEED, 
-                flight_state_.ground_speed + 50.0 * delta_seconds);
-            flight_state_.latitude += lat_change;
-            flight_state_.longitude += lon_change;
-            break;
-            
-        case FlightPhase::CRUISE:
-            flight_state_.altitude = CRUISE_ALTITUDE;
-            flight_state_.ground_speed = CRUISE_SPEED;
-            flight_state_.latitude += lat_change;
-            flight_state_.longitude += lon_change;
-            break;
-            
-        case FlightPhase::LANDING:
-            flight_state_.altitude = std::max(0.0, 
-                flight_state_.altitude - TAKEOFF_RATE * delta_seconds / 60.0);
-            flight_state_.ground_speed = std::max(0.0, 
-                flight_state_.ground_speed - 50.0 * delta_seconds);
-            flight_state_.latitude += lat_change;
-            flight_state_.longitude += lon_change;
-            break;
-            
-        case FlightPhase::STOPPED:
-            flight_state_.altitude = 0.0;
-            flight_state_.ground_speed = 0.0;
-            break;
+void ARINC429Generator::setRoute(const GeoPoint& origin, const GeoPoint& destination) {
+    if (state_ == GeneratorState::RUNNING) {
+        throw std::logic_error("Cannot change the route while running");
+    }
+    FlightTrajectory trajectory(origin, destination, flightProfile());  // Validates the end points
+    origin_ = origin;
+    destination_ = destination;
+    outbound_ = true;
+    trajectory_ = std::move(trajectory);
+    cursor_ = FlightTrajectory::Cursor(trajectory_);
+    if (fleet_) {
+        layoutFleet(fleet_->size());
     }
 }
-void ARINC429Generator::transitionToNextPhase() {
-    phase_start_time_ = std::chrono::steady_clock::now();
-    
-    switch (current_phase_) {
-        case FlightPhase::TAKEOFF:
-            current_phase_ = FlightPhase::CRUISE;
-            break;
-        case FlightPhase::CRUISE:
-            current_phase_ = FlightPhase::LANDING;
-            break;
-        case FlightPhase::LANDING:
-            current_phase_ = FlightPhase::STOPPED;
-            break;
-        case FlightPhase::STOPPED:
-            current_phase_ = FlightPhase::TAKEOFF;
-            // Reset position for return flight
-            if (std::abs(flight_state_.latitude - START_POINT.latitude) < 0.1) {
-                flight_state_.latitude = END_POINT.latitude;
-                flight_state_.longitude = END_POINT.longitude;
-            } else {
-                flight_state_.latitude = START_POINT.latitude;
-                flight_state_.longitude = START_POINT.longitude;
-            }
-            calculateInitialTrack();
-            break;
+
+FlightTrajectory ARINC429Generator::legTrajectory() const {
+    return outbound_ ? FlightTrajectory(origin_, destination_, flightProfile())
+                     : FlightTrajectory(destination_, origin_, flightProfile());
+}
+
+void ARINC429Generator::applyPlan(const ChannelPlan& plan) {
+    if (plan.protocol != MessageType::ARINC429) {
+        throw std::invalid_argument("Plan is not for an ARINC429 channel");
+    }
+    const bool running = state_ == GeneratorState::RUNNING;
+    if (running && plan.fleet_size != getFleetSize()) {
+        throw std::logic_error("Cannot change the fleet size while running");
+    }
+
+    const GeoPoint origin = plan.has_route ? plan.origin : START_POINT;
+    const GeoPoint destination = plan.has_route ? plan.destination : END_POINT;
+    const bool new_route = origin.latitude != origin_.latitude || origin.longitude != origin_.longitude ||
+                           destination.latitude != destination_.latitude ||
+                           destination.longitude != destination_.longitude;
+    if (!running) {
+        if (new_route) {
+            setRoute(origin, destination);
+        }
+        if (plan.fleet_size != getFleetSize()) {
+            setFleetSize(plan.fleet_size);
+        }
+    } else if (new_route) {
+        // The single aircraft finishes its leg; the fleet starts over on the new route
+        origin_ = origin;
+        destination_ = destination;
+        if (fleet_) {
+            layoutFleet(fleet_->size());
+        }
+    }
+
+    loadSignals(plan.signals, schedule_, running);
+    faults_.assign(plan.faults);
+}
+
+void ARINC429Generator::setFleetSize(size_t aircraft) {
+    if (state_ == GeneratorState::RUNNING) {
+        throw std::logic_error("Cannot change the fleet size while running");
     }
+    layoutFleet(aircraft);
 }
 
-void ARINC429Generator::processMessages(std::vector<std::unique_ptr<IMessage>>&& messages) {
-    last_messages_.clear();
-    for (const auto& msg : messages) {
-        last_messages_.push_back(msg->toString());
+void ARINC429Generator::layoutFleet(size_t aircraft) {
+    if (aircraft > ARINC429Fleet::MAX_AIRCRAFT - getChannel()) {
+        throw std::invalid_argument("Fleet does not fit in the channel range");
     }
-    DataGenerator::processMessages(std::move(messages));   
+    fleet_ = aircraft ? std::make_unique<ARINC429Fleet>(aircraft, rng_, getChannel(), origin_, destination_)
+                      : nullptr;
+    fleet_seed_ = getSeed();
+    fleet_channel_ = getChannel();
+}
+
+size_t ARINC429Generator::getFleetSize() const {
+    return fleet_ ? fleet_->size() : 0;
 }
 
-std::unique_ptr<ARINC429Message> ARINC429Generator::generateLatitudeMessage() {
-    return std::make_unique<ARINC429Message>(
-        ARINC429Label::LATITUDE,
-        static_cast<float>(flight_state_.latitude),
-        ARINC429SSM::NORMAL_OPERATION
-    );
+FlightProfile ARINC429Generator::flightProfile() {
+    FlightProfile profile;
+    profile.cruise_altitude = CRUISE_ALTITUDE;
+    profile.cruise_speed = CRUISE_SPEED;
+    profile.climb_rate = TAKEOFF_RATE;
+    profile.descent_rate = TAKEOFF_RATE;
+    profile.acceleration = ACCELERATION;
+    return profile;
 }
 
-std::unique_ptr<ARINC429Message> ARINC429Generator::generateLongitudeMessage() {
-    return std::make_unique<ARINC429Message>(
-        ARINC429Label::LONGITUDE,
-        static_cast<float>(flight_state_.longitude),
-        ARINC429SSM::NORMAL_OPERATION
-    );
+void ARINC429Generator::prepareGeneration() {
+    if (fleet_ && (fleet_seed_ != getSeed() || fleet_channel_ != getChannel())) {
+        layoutFleet(fleet_->size());
+    }
+    schedule_.reset();
+    faults_.restart();
+
+    // Depart on the current leg, of a route that may have changed mid-run
+    trajectory_ = legTrajectory();
+    cursor_ = FlightTrajectory::Cursor(trajectory_);
+    current_phase_ = FlightPhase::TAKEOFF;
+    ground_time_ = 0.0;
+}
+
+std::vector<std::unique_ptr<IMessage>> ARINC429Generator::generateMessages(std::chrono::milliseconds delta_time) {
+    FrameBatch frames;
+    generateFrames(delta_time, frames);
+
+    std::vector<std::unique_ptr<IMessage>> messages;
+    messages.reserve(frames.size());
+    for (const Frame& frame : frames) {
+        messages.push_back(std::make_unique<ARINC429Message>(frame));
+    }
+    return messages;
+}
+
+void ARINC429Generator::generateFrames(std::chrono::milliseconds delta_time, FrameBatch& batch) {
+    {
+        SBG_TRACE_SCOPE("flight state", getChannel());
+        if (fleet_) {
+            fleet_->update(delta_time);
+        } else {
+            updateFlightState(delta_time);
+        }
+    }
+
+    SBG_TRACE_SCOPE("encode", getChannel());
+    // Faults hold for the whole tick, from its start
+    faults_.advance(schedule_.now());
+    const uint64_t timestamp = currentTimestamp();
+    for (uint32_t key : schedule_.advance(delta_time)) {
+        const FaultPlan* fault = faults_.anyActive() ? faults_.find(key) : nullptr;
+        if (fault && fault->kind == FaultKind::DROP) {
+            continue;
+        }
+
+        const size_t first = batch.size();
+        if (fleet_) {
+            fleet_->appendLabel(static_cast<ARINC429Label>(key), timestamp, getChannel(), batch);
+        } else {
+            Frame frame = generateLabelFrame(static_cast<ARINC429Label>(key), timestamp);
+            frame.channel = getChannel();
+            batch.push(frame);
+        }
+        if (fault) {
+            for (size_t i = first; i < batch.size(); ++i) {
+                injectFault(fault->kind, batch[i]);
+            }
+        }
+    }
 }
 
-std::unique_ptr<ARINC429Message> ARINC429Generator::generateStatusMessage() {
-    return std::make_unique<ARINC429Message>(
-        ARINC429Label::EQUIPMENT_STATUS,
-        1.0f,
-        ARINC429SSM::NORMAL_OPERATION
-    );
+void ARINC429Generator::updateFlightState(std::chrono::milliseconds delta_time) {
+    // Flight timing follows simulated time so it also holds in virtual-clock runs
+    const double delta_seconds = delta_time.count() / 1000.0;
+
+    if (current_phase_ == FlightPhase::STOPPED) {
+        ground_time_ += delta_seconds;
+        if (ground_time_ < TURNAROUND_TIME) {
+            return;
+        }
+        if (cursor_.isFinished()) {
+            // Return flight, on the current route
+            outbound_ = !outbound_;
+            trajectory_ = legTrajectory();
+        }
+        cursor_ = FlightTrajectory::Cursor(trajectory_);
+        current_phase_ = FlightPhase::TAKEOFF;
+        ground_time_ = 0.0;
+        SBG_TRACE_INSTANT("phase", getChannel(), flightPhaseName(current_phase_), Tracer::NO_VALUE);
+        return;
+    }
+
+    cursor_.advance(delta_seconds);
+    const FlightPhase phase = cursor_.isFinished() ? FlightPhase::STOPPED : cursor_.getState().phase;
+    if (phase != current_phase_) {
+        current_phase_ = phase;
+        SBG_TRACE_INSTANT("phase", getChannel(), flightPhaseName(phase), Tracer::NO_VALUE);
+    }
 }
 
-std::unique_ptr<ARINC429Message> ARINC429Generator::generateSpeedMessage() {
-    return std::make_unique<ARINC429Message>(
-        ARINC429Label::GROUND_SPEED,
-        static_cast<float>(flight_state_.ground_speed),
-        ARINC429SSM::NORMAL_OPERATION
-    );
+void ARINC429Generator::processFrames(const FrameBatch& frames) {
+    if (!frames.empty()) {
+        std::lock_guard<std::mutex> lock(last_message_mutex_);
+        last_frames_ = frames;
+    }
+    DataGenerator::processFrames(frames);
 }
 
-std::unique_ptr<ARINC429Message> ARINC429Generator::generateAltitudeMessage() {
-    return std::make_unique<ARINC429Message>(
-        ARINC429Label::ALTITUDE,
-        static_cast<float>(flight_state_.altitude),
-        ARINC429SSM::NORMAL_OPERATION
-    );
+Frame ARINC429Generator::generateLabelFrame(ARINC429Label label, uint64_t timestamp_ns) const {
+    const FlightTrajectory::State& state = cursor_.getState();
+    float value;
+    switch (label) {
+        case ARINC429Label::LATITUDE:
+            value = static_cast<float>(state.latitude);
+            break;
+        case ARINC429Label::LONGITUDE:
+            value = static_cast<float>(state.longitude);
+            break;
+        case ARINC429Label::GROUND_SPEED:
+            value = static_cast<float>(state.ground_speed);
+            break;
+        case ARINC429Label::ALTITUDE:
+            value = static_cast<float>(state.altitude);
+            break;
+        case ARINC429Label::TRACK_HEADING:
+            // BNR track is signed: 180 to 360 degrees go out as -180 to 0
+            value = static_cast<float>(state.track > 180.0 ? state.track - 360.0 : state.track);
+            break;
+        case ARINC429Label::VERTICAL_SPEED:
+            value = static_cast<float>(state.vertical_speed);
+            break;
+        case ARINC429Label::EQUIPMENT_STATUS:
+            value = 1.0f;
+            break;
+        default:
+            throw std::invalid_argument("No generator for ARINC429 label");
+    }
+    return ARINC429Message::encodeFrame(label, value, ARINC429SSM::NORMAL_OPERATION, timestamp_ns);
 }
 
 std::string ARINC429Generator::getLastMessage() {
     // Combine all messages into a single string
-    std::string combined;
-    for (const auto& msg : last_messages_) {
+    std::lock_guard<std::mutex> lock(last_message_mutex_);
+    TextBuffer combined(64 * last_frames_.size() + 1);
+    for (const Frame& frame : last_frames_) {
         if (!combined.empty()) {
-            combined += "\n";
+            combined.append('\n');
         }
-        combined += msg;
+        ARINC429Message(frame).formatTo(combined);
     }
-    return combined;
+    return combined.str();
 }
 } // namespace serial_bus_generator
\ No newline at end of file
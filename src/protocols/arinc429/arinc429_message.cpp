@@ -1,6 +1,6 @@
 #include "serial_bus_generator/protocols/arinc429/arinc429_message.hpp"
-#include <sstream>
-#include <iomanip>
+#include "serial_bus_generator/protocols/arinc429/arinc429_label_traits.hpp"
+#include "serial_bus_generator/messages/frame_serializer.hpp"
 #include <cmath>
 #include <bitset>
 
@@ -10,24 +10,64 @@ ARINC429Message::ARINC429Message(ARINC429Label label, float value, ARINC429SSM s
     : BaseMessage(MessageType::ARINC429),
       label_(label),
       ssm_(ssm),
-      raw_data_(0)
-{
-    if (!isValidLabel(label)) {
+      raw_data_(encodeWord(label, value, ssm))
+{}
+
+uint32_t ARINC429Message::encodeWord(ARINC429Label label, float value, ARINC429SSM ssm) {
+    const ARINC429LabelCodec* codec = findLabelCodec(label);
+    if (!codec) {
         throw MessageValidationError("Invalid ARINC429 label");
     }
-    
-    // Encode the full 32-bit word
+
     // Label (8 bits)
-    raw_data_ = static_cast<uint32_t>(label) & 0xFF;
-    
+    uint32_t word = static_cast<uint32_t>(label) & 0xFF;
+
     // Encode the value (19 bits)
-    encodeValue(value);
-    
+    word |= (codec->encode(value) & ARINC429_DATA_MASK) << 8;
+
     // SSM (2 bits)
-    raw_data_ |= (static_cast<uint32_t>(ssm) & 0x03) << 29;
-    
+    word |= (static_cast<uint32_t>(ssm) & 0x03) << 29;
+
     // Calculate and set parity bit
-    raw_data_ |= (calculateParity() & 0x01) << 31;
+    word |= (calculateParity(word) & 0x01) << 31;
+    return word;
+}
+
+Frame ARINC429Message::encodeFrame(ARINC429Label label, float value, ARINC429SSM ssm,
+                                   uint64_t timestamp_ns) {
+    return makeFrame(encodeWord(label, value, ssm), timestamp_ns);
+}
+
+Frame ARINC429Message::makeFrame(uint32_t word, uint64_t timestamp_ns) {
+    Frame frame;
+    frame.timestamp_ns = timestamp_ns;
+    frame.id = word;
+    frame.type = MessageType::ARINC429;
+    frame.dlc = 4;
+    for (int i = 0; i < 4; ++i) {
+        frame.data[i] = (word >> (8 * i)) & 0xFF;
+    }
+    return frame;
+}
+
+ARINC429Message::ARINC429Message(const Frame& frame)
+    : BaseMessage(MessageType::ARINC429),
+      label_(ARINC429Label::LATITUDE),
+      ssm_(static_cast<ARINC429SSM>((frame.id >> 29) & 0x03)),
+      raw_data_(frame.id)
+{
+    if (frame.type != MessageType::ARINC429) {
+        throw MessageValidationError("Frame is not an ARINC429 word");
+    }
+
+    // Map the 8-bit label field back to the label it was encoded from
+    const ARINC429LabelCodec* codec = findWordCodec(frame.id);
+    if (!codec) {
+        throw MessageValidationError("Invalid ARINC429 label");
+    }
+    label_ = codec->spec->label;
+
+    timestamp_ = static_cast<uint32_t>(frame.timestamp_ns / 1000000);
 }
 
 bool ARINC429Message::isValid() const {
@@ -35,106 +75,56 @@ bool ARINC429Message::isValid() const {
 }
 
 std::vector<uint8_t> ARINC429Message::serialize() const {
-    std::vector<uint8_t> data(4);
-    data[0] = (raw_data_ >> 0) & 0xFF;  // Label
-    data[1] = (raw_data_ >> 8) & 0xFF;  // Data LSB
-    data[2] = (raw_data_ >> 16) & 0xFF; // Data MSB
-    data[3] = (raw_data_ >> 24) & 0xFF; // SSM and Parity
+    std::vector<uint8_t> data(ARINC429_WIRE_SIZE);
+    serializeInto(data.data(), data.size());
     return data;
 }
 
+size_t ARINC429Message::serializeInto(uint8_t* out, size_t capacity) const {
+    return serializeFrame(toFrame(), out, capacity);
+}
+
+Frame ARINC429Message::toFrame() const {
+    return makeFrame(raw_data_, static_cast<uint64_t>(timestamp_) * 1000000);
+}
+
 std::string ARINC429Message::toString() const {
-    std::stringstream ss;
-    ss << "ARINC429 Message: Label=" << static_cast<int>(static_cast<uint8_t>(label_))
-       << " Value=" << std::fixed << std::setprecision(3) << getDecodedValue()
-       << " SSM=";
+    TextBuffer text(64);
+    formatTo(text);
+    return text.str();
+}
+
+void ARINC429Message::formatTo(TextBuffer& out) const {
+    out.append("ARINC429 Message: Label=");
+    out.appendInt(static_cast<uint8_t>(label_));
+    out.append(" Value=");
+    out.appendFixed(getDecodedValue(), 3);
+    out.append(" SSM=");
     
     switch (ssm_) {
         case ARINC429SSM::NORMAL_OPERATION:
-            ss << "Normal";
+            out.append("Normal");
             break;
         case ARINC429SSM::NO_COMPUTED_DATA:
-            ss << "No Data";
+            out.append("No Data");
             break;
         case ARINC429SSM::FUNCTIONAL_TEST:
-            ss << "Test";
+            out.append("Test");
             break;
         case ARINC429SSM::FAILURE_WARNING:
-            ss << "Failure";
+            out.append("Failure");
             break;
     }
-    
-    return ss.str();
 }
 
 float ARINC429Message::getDecodedValue() const {
-    // Extract the 19-bit data field
-    uint32_t data_bits = (raw_data_ >> 8) & 0x7FFFF;
-    
-    // Handle different label formats
-    switch (label_) {
-        case ARINC429Label::LATITUDE:
-        case ARINC429Label::LONGITUDE: {
-            // BNR format with resolution of 180°/(2^18)
-            float value = static_cast<float>(data_bits) * (180.0f / 262144.0f);
-            // Apply sign bit
-            if (data_bits & 0x40000) value = -value;
-            return value;
-        }
-        
-        case ARINC429Label::ALTITUDE: {
-            // BNR format, resolution of 0.125 feet
-            return static_cast<float>(data_bits) * 0.125f;
-        }
-        
-        case ARINC429Label::GROUND_SPEED: {
-            // BNR format, resolution of 1 knot
-            return static_cast<float>(data_bits);
-        }
-        
-        default:
-            // Default BNR format
-            return static_cast<float>(data_bits);
-    }
-}
-
-void ARINC429Message::encodeValue(float value) {
-    uint32_t encoded_value = 0;
-    
-    // Encode based on label type
-    switch (label_) {
-        case ARINC429Label::LATITUDE:
-        case ARINC429Label::LONGITUDE: {
-            // Convert to BNR format
-            float abs_value = std::abs(value);
-            encoded_value = static_cast<uint32_t>(abs_value * (262144.0f / 180.0f));
-            if (value < 0) encoded_value |= 0x40000; // Set sign bit
-            break;
-        }
-        
-        case ARINC429Label::ALTITUDE: {
-            // Convert to BNR format (0.125 feet resolution)
-            encoded_value = static_cast<uint32_t>(value / 0.125f);
-            break;
-        }
-        
-        case ARINC429Label::GROUND_SPEED: {
-            // Direct BNR format
-            encoded_value = static_cast<uint32_t>(value);
-            break;
-        }
-        
-        default:
-            encoded_value = static_cast<uint32_t>(value);
-    }
-    
-    // Place the encoded value in the raw data word (19 bits)
-    raw_data_ |= (encoded_value & 0x7FFFF) << 8;
+    // Extract the 19-bit data field and decode it per the label's format
+    return findLabelCodec(label_)->decode((raw_data_ >> 8) & ARINC429_DATA_MASK);
 }
 
-uint8_t ARINC429Message::calculateParity() const {
+uint8_t ARINC429Message::calculateParity(uint32_t word) {
     // Calculate odd parity over all bits except the parity bit
-    std::bitset<32> bits(raw_data_ & 0x7FFFFFFF);
+    std::bitset<32> bits(word & 0x7FFFFFFF);
     return bits.count() % 2 == 0 ? 1 : 0; // Ensure odd parity
 }
 
@@ -142,26 +132,11 @@ bool ARINC429Message::verifyParity() const {
     // Extract current parity bit
     uint8_t stored_parity = (raw_data_ >> 31) & 0x01;
     // Compare with calculated parity
-    return stored_parity == calculateParity();
+    return stored_parity == calculateParity(raw_data_);
 }
 
-bool ARINC429Message::isValidLabel(ARINC429Label label) const {
-    // Check if the label is one of our defined values
-    switch (label) {
-        case ARINC429Label::LATITUDE:
-        case ARINC429Label::LONGITUDE:
-        case ARINC429Label::ALTITUDE:
-        case ARINC429Label::GROUND_SPEED:
-        case ARINC429Label::TRACK_HEADING:
-        case ARINC429Label::VERTICAL_SPEED:
-        case ARINC429Label::EQUIPMENT_STATUS:
-        case ARINC429Label::NAVIGATION_MODE:
-        case ARINC429Label::GPS_SATELLITE_STATUS:
-        case ARINC429Label::SYSTEM_CONFIG:
-            return true;
-        default:
-            return false;
-    }
+bool ARINC429Message::isValidLabel(ARINC429Label label) {
+    return findLabelCodec(label) != nullptr;
 }
 
 } // namespace serial_bus_generator
\ No newline at end of file
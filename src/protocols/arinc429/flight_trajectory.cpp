@@ -0,0 +1,252 @@
+#include "serial_bus_generator/protocols/arinc429/flight_trajectory.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace serial_bus_generator {
+
+namespace {
+
+constexpr double DEGREES = 180.0 / M_PI;
+constexpr double RADIANS = M_PI / 180.0;
+constexpr double MIN_SEGMENT = 1e-6;  // seconds; closer break points are merged
+
+double wrapLongitude(double longitude) {
+    if (longitude >= 180.0) {
+        return longitude - 360.0;
+    }
+    return longitude < -180.0 ? longitude + 360.0 : longitude;
+}
+
+double wrapTrack(double track) {
+    if (track >= 360.0) {
+        return track - 360.0;
+    }
+    return track < 0.0 ? track + 360.0 : track;
+}
+
+void toUnitVector(const GeoPoint& point, double out[3]) {
+    const double lat = point.latitude * RADIANS;
+    const double lon = point.longitude * RADIANS;
+    out[0] = std::cos(lat) * std::cos(lon);
+    out[1] = std::cos(lat) * std::sin(lon);
+    out[2] = std::sin(lat);
+}
+
+} // namespace
+
+FlightTrajectory::FlightTrajectory(const GeoPoint& origin, const GeoPoint& destination,
+                                   const FlightProfile& profile, size_t route_segments)
+    : origin_(origin)
+    , destination_(destination)
+    , profile_(profile)
+{
+    if (!(profile.cruise_speed > 0.0 && profile.cruise_altitude > 0.0 && profile.climb_rate > 0.0 &&
+          profile.descent_rate > 0.0 && profile.acceleration > 0.0)) {
+        throw std::invalid_argument("Flight profile needs positive speed, altitude, rates and acceleration");
+    }
+    if (route_segments == 0) {
+        throw std::invalid_argument("Route needs at least one segment");
+    }
+
+    // Orthonormal basis of the great circle through both end points
+    double to[3];
+    toUnitVector(origin, u_);
+    toUnitVector(destination, to);
+    const double dot = u_[0] * to[0] + u_[1] * to[1] + u_[2] * to[2];
+    for (int i = 0; i < 3; ++i) {
+        v_[i] = to[i] - dot * u_[i];
+    }
+    const double norm = std::sqrt(v_[0] * v_[0] + v_[1] * v_[1] + v_[2] * v_[2]);
+    central_angle_ = std::atan2(norm, dot);
+    distance_ = central_angle_ * EARTH_RADIUS_NM;
+    if (distance_ < 1.0) {
+        throw std::invalid_argument("Origin and destination must be at least 1 nm apart");
+    }
+    for (double& component : v_) {
+        component /= norm;
+    }
+
+    // Accelerate to cruise speed, hold it, and slow to a stop at the
+    // destination; short routes never reach cruise speed
+    const double acceleration = profile.acceleration / 3600.0;  // nm/s^2
+    double speed = profile.cruise_speed / 3600.0;                 // nm/s
+    if (speed * speed / acceleration > distance_) {
+        speed = std::sqrt(distance_ * acceleration);
+    }
+    peak_speed_ = speed * 3600.0;
+    accelerate_end_ = speed / acceleration;
+    duration_ = 2.0 * accelerate_end_ + (distance_ - speed * speed / acceleration) / speed;
+    decelerate_start_ = duration_ - accelerate_end_;
+
+    // Climb, cruise, and descend to reach the ground on arrival
+    const double climb = profile.climb_rate / 60.0;
+    const double descent = profile.descent_rate / 60.0;
+    peak_altitude_ = std::min(profile.cruise_altitude, duration_ / (1.0 / climb + 1.0 / descent));
+    climb_end_ = peak_altitude_ / climb;
+    descent_start_ = duration_ - peak_altitude_ / descent;
+
+    std::vector<double> times{accelerate_end_, decelerate_start_, climb_end_, descent_start_, duration_};
+    for (size_t k = 0; k < route_segments; ++k) {
+        times.push_back(duration_ * static_cast<double>(k) / static_cast<double>(route_segments));
+    }
+    std::sort(times.begin(), times.end());
+
+    segments_.reserve(times.size());
+    State start = exactState(0.0);
+    double start_time = 0.0;
+    for (double end_time : times) {
+        const double duration = end_time - start_time;
+        if (duration < MIN_SEGMENT) {
+            continue;
+        }
+        const State end = exactState(end_time);
+        Segment segment;
+        segment.start_time = start_time;
+        segment.duration = duration;
+        segment.start = start;
+        segment.latitude_rate = (end.latitude - start.latitude) / duration;
+        segment.longitude_rate = std::remainder(end.longitude - start.longitude, 360.0) / duration;
+        segment.climb_rate = (end.altitude - start.altitude) / duration;
+        segment.acceleration = (end.ground_speed - start.ground_speed) / duration;
+        segment.track_rate = std::remainder(end.track - start.track, 360.0) / duration;
+
+        // Phase and vertical speed hold for the whole segment
+        const double middle = start_time + duration / 2.0;
+        segment.start.vertical_speed = segment.climb_rate * 60.0;
+        segment.start.phase = middle < climb_end_ ? FlightPhase::TAKEOFF
+                            : middle < descent_start_ ? FlightPhase::CRUISE
+                            : FlightPhase::LANDING;
+        segments_.push_back(segment);
+
+        start = end;
+        start_time = end_time;
+    }
+}
+
+FlightTrajectory::State FlightTrajectory::exactState(double time) const {
+    const double acceleration = profile_.acceleration / 3600.0;
+    const double speed = peak_speed_ / 3600.0;
+    State state;
+
+    double along;  // nm from the origin
+    if (time < accelerate_end_) {
+        along = 0.5 * acceleration * time * time;
+        state.ground_speed = profile_.acceleration * time;
+    } else if (time < decelerate_start_) {
+        along = 0.5 * speed * accelerate_end_ + speed * (time - accelerate_end_);
+        state.ground_speed = peak_speed_;
+    } else {
+        const double left = duration_ - time;
+        along = distance_ - 0.5 * acceleration * left * left;
+        state.ground_speed = profile_.acceleration * left;
+    }
+
+    if (time < climb_end_) {
+        state.altitude = profile_.climb_rate / 60.0 * time;
+    } else if (time < descent_start_) {
+        state.altitude = peak_altitude_;
+    } else {
+        state.altitude = profile_.descent_rate / 60.0 * (duration_ - time);
+    }
+
+    // Position and direction of travel on the great circle
+    const double angle = central_angle_ * along / distance_;
+    const double c = std::cos(angle);
+    const double s = std::sin(angle);
+    double position[3];
+    double heading[3];
+    for (int i = 0; i < 3; ++i) {
+        position[i] = c * u_[i] + s * v_[i];
+        heading[i] = c * v_[i] - s * u_[i];
+    }
+    const double lat = std::asin(std::max(-1.0, std::min(1.0, position[2])));
+    const double lon = std::atan2(position[1], position[0]);
+    const double east = -std::sin(lon) * heading[0] + std::cos(lon) * heading[1];
+    const double north = -std::sin(lat) * (std::cos(lon) * heading[0] + std::sin(lon) * heading[1]) +
+                         std::cos(lat) * heading[2];
+    state.latitude = lat * DEGREES;
+    state.longitude = lon * DEGREES;
+    state.track = wrapTrack(std::atan2(east, north) * DEGREES);
+    return state;
+}
+
+FlightTrajectory::State FlightTrajectory::arrivalState() const {
+    const Segment& last = segments_.back();
+    State state;
+    state.latitude = destination_.latitude;
+    state.longitude = destination_.longitude;
+    state.track = advanceWithin(last, last.duration).track;
+    return state;
+}
+
+size_t FlightTrajectory::findSegment(double time) const {
+    if (time >= duration_) {
+        return segments_.size();
+    }
+    auto next = std::upper_bound(segments_.begin(), segments_.end(), time,
+        [](double t, const Segment& segment) { return t < segment.start_time; });
+    return next == segments_.begin() ? 0 : static_cast<size_t>(next - segments_.begin()) - 1;
+}
+
+FlightTrajectory::State FlightTrajectory::stateAt(double time) const {
+    const size_t index = findSegment(time);
+    if (index == segments_.size()) {
+        return arrivalState();
+    }
+    const Segment& segment = segments_[index];
+    return advanceWithin(segment, std::max(0.0, time - segment.start_time));
+}
+
+FlightTrajectory::State FlightTrajectory::advanceWithin(const Segment& segment, double elapsed) {
+    State state = segment.start;
+    state.latitude += segment.latitude_rate * elapsed;
+    state.longitude = wrapLongitude(state.longitude + segment.longitude_rate * elapsed);
+    state.altitude += segment.climb_rate * elapsed;
+    state.ground_speed += segment.acceleration * elapsed;
+    state.track = wrapTrack(state.track + segment.track_rate * elapsed);
+    return state;
+}
+
+FlightTrajectory::Cursor::Cursor(const FlightTrajectory& trajectory, double start_time)
+    : trajectory_(&trajectory)
+    , segment_(trajectory.findSegment(start_time))
+    , time_(start_time)
+    , segment_left_(0.0)
+    , state_(trajectory.stateAt(start_time))
+{
+    if (!isFinished()) {
+        const Segment& segment = trajectory.getSegment(segment_);
+        segment_left_ = segment.start_time + segment.duration - start_time;
+    }
+}
+
+void FlightTrajectory::Cursor::advance(double delta_seconds) {
+    time_ += delta_seconds;
+    if (isFinished()) {
+        return;
+    }
+    segment_left_ -= delta_seconds;
+    if (segment_left_ > 0.0) {
+        const Segment& segment = trajectory_->getSegment(segment_);
+        state_.latitude += segment.latitude_rate * delta_seconds;
+        state_.longitude = wrapLongitude(state_.longitude + segment.longitude_rate * delta_seconds);
+        state_.altitude += segment.climb_rate * delta_seconds;
+        state_.ground_speed += segment.acceleration * delta_seconds;
+        state_.track = wrapTrack(state_.track + segment.track_rate * delta_seconds);
+        return;
+    }
+
+    // Crossed into a later segment: restart from its exact start state
+    while (segment_left_ <= 0.0 && ++segment_ < trajectory_->getSegmentCount()) {
+        segment_left_ += trajectory_->getSegment(segment_).duration;
+    }
+    if (isFinished()) {
+        state_ = trajectory_->arrivalState();
+    } else {
+        const Segment& segment = trajectory_->getSegment(segment_);
+        state_ = advanceWithin(segment, segment.duration - segment_left_);
+    }
+}
+
+} // namespace serial_bus_generator
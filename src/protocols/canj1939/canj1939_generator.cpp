@@ -1,33 +1,130 @@
 #include "serial_bus_generator/protocols/canj1939/canj1939_generator.hpp"
+#include "serial_bus_generator/messages/text_buffer.hpp"
+#include "serial_bus_generator/trace/tracer.hpp"
 #include <cmath>
+#include <cstring>
+#include <stdexcept>
 
 namespace serial_bus_generator {
 
-CANJ1939Generator::CANJ1939Generator()
-    : rng_(std::random_device{}())
-    , temp_variation_(-2.0f, 2.0f)
-    , rpm_variation_(-50.0f, 50.0f)
-{
+using namespace std::chrono_literals;
+
+namespace {
+
+constexpr char COMPONENT_ID_TEXT[] = "SBG*ENGINE-SIM*000001*1*";
+constexpr uint8_t DTC_OCCURRENCES = 1;
+
+bool isMultiPacket(CANJ1939PGN pgn) {
+    return pgn == CANJ1939PGN::DM1 || pgn == CANJ1939PGN::COMPONENT_ID || pgn == CANJ1939PGN::ENGINE_CONFIG;
+}
+
+void putSpeed(uint8_t* out, double rpm) {
+    const uint16_t raw = static_cast<uint16_t>(std::lround(rpm / 0.125));
+    out[0] = raw & 0xFF;
+    out[1] = (raw >> 8) & 0xFF;
+}
+
+// SPN-conversion-method-4 DTC: SPN (19 bits), FMI (5 bits), occurrence count (7 bits)
+void putDTC(uint8_t* out, uint32_t spn, uint8_t fmi, uint8_t occurrences) {
+    out[0] = spn & 0xFF;
+    out[1] = (spn >> 8) & 0xFF;
+    out[2] = static_cast<uint8_t>(((spn >> 16) & 0x07) << 5) | (fmi & 0x1F);
+    out[3] = occurrences & 0x7F;
+}
+
+} // namespace
+
+CANJ1939Generator::CANJ1939Generator() {
     engine_state_.rpm = 750.0;  // Idle
     engine_state_.temperature = 25.0;  // Room temp
     engine_state_.hours = 0.0;
     engine_state_.running = true;
+
+    // J1939-71 default transmission rates
+    schedule_.addEntry(static_cast<uint32_t>(CANJ1939PGN::ENGINE_SPEED), 10ms, 0ms);
+    schedule_.addEntry(static_cast<uint32_t>(CANJ1939PGN::ENGINE_TEMPERATURE), 1000ms, 3ms);
+    schedule_.addEntry(static_cast<uint32_t>(CANJ1939PGN::ENGINE_HOURS), 1000ms, 7ms);
+
+    // Multi-packet PGNs, broadcast with TP.BAM
+    schedule_.addEntry(static_cast<uint32_t>(CANJ1939PGN::DM1), 1000ms, 11ms);
+    schedule_.addEntry(static_cast<uint32_t>(CANJ1939PGN::ENGINE_CONFIG), 5000ms, 13ms);
+    schedule_.addEntry(static_cast<uint32_t>(CANJ1939PGN::COMPONENT_ID), 5000ms, 17ms);
+}
+
+CANJ1939Generator::~CANJ1939Generator() {
+    // Join the generation thread while the overrides it calls still exist
+    stop();
+}
+
+void CANJ1939Generator::setPGNPeriod(CANJ1939PGN pgn, std::chrono::nanoseconds period) {
+    if (getState() == GeneratorState::RUNNING) {
+        throw std::logic_error("Cannot change PGN periods while running");
+    }
+    size_t entry = schedule_.findEntry(static_cast<uint32_t>(pgn));
+    if (entry == schedule_.size()) {
+        throw std::invalid_argument("PGN is not scheduled");
+    }
+    schedule_.setPeriod(entry, period);
+}
+
+void CANJ1939Generator::queueTransfer(CANJ1939PGN pgn, const std::vector<uint8_t>& payload,
+                                      uint8_t source, uint8_t destination) {
+    if (getState() == GeneratorState::RUNNING) {
+        throw std::logic_error("Cannot queue transfers while running");
+    }
+    if (payload.size() <= 8 || payload.size() > J1939TransportScheduler::MAX_PAYLOAD) {
+        throw std::invalid_argument("Transport payloads must be 9 to 1785 bytes");
+    }
+    pending_transfers_.push_back({pgn, payload, source, destination});
+}
+
+void CANJ1939Generator::setTransportTiming(const J1939TransportTiming& timing) {
+    if (getState() == GeneratorState::RUNNING) {
+        throw std::logic_error("Cannot change transport timing while running");
+    }
+    transport_ = J1939TransportScheduler(timing);
 }
 
-void CANJ1939Generator::startGeneration() {
-    last_updates_.clear();
-    DataGenerator::startGeneration();
+void CANJ1939Generator::applyPlan(const ChannelPlan& plan) {
+    if (plan.protocol != MessageType::CANJ1939) {
+        throw std::invalid_argument("Plan is not for a CANJ1939 channel");
+    }
+    loadSignals(plan.signals, schedule_, state_ == GeneratorState::RUNNING);
+    faults_.assign(plan.faults);
+    temperature_drift_ = plan.temperature_drift;
+    rpm_jitter_ = plan.rpm_jitter;
+}
+
+void CANJ1939Generator::prepareGeneration() {
+    schedule_.reset();
+    faults_.restart();
+    transport_.reset();
+    tick_index_ = 0;
 }
 
 std::vector<std::unique_ptr<IMessage>> CANJ1939Generator::generateMessages(
     std::chrono::milliseconds duration) {
-    
+    FrameBatch frames;
+    generateFrames(duration, frames);
+
     std::vector<std::unique_ptr<IMessage>> messages;
-    
+    messages.reserve(frames.size());
+    for (const Frame& frame : frames) {
+        if (frame.dlc != 8) {
+            continue;  // Injected length fault; not a message
+        }
+        messages.push_back(std::make_unique<CANJ1939Message>(frame));
+    }
+    return messages;
+}
+
+void CANJ1939Generator::generateFrames(std::chrono::milliseconds duration, FrameBatch& batch) {
     if (engine_state_.running) {
-        // Update engine state
-        engine_state_.temperature += temp_variation_(rng_) * (duration.count() / 1000.0);
-        engine_state_.rpm += rpm_variation_(rng_);
+        SBG_TRACE_SCOPE("engine state", getChannel());
+        const CounterRng::Block noise = rng_(getChannel(), 0, tick_index_++);
+        engine_state_.temperature += CounterRng::toRange(noise[0], -temperature_drift_, temperature_drift_) *
+                                     (duration.count() / 1000.0);
+        engine_state_.rpm += CounterRng::toRange(noise[1], -rpm_jitter_, rpm_jitter_);
         engine_state_.hours += duration.count() / 3600000.0;  // Convert ms to hours
 
         // Clamp values
@@ -35,54 +132,125 @@ std::vector<std::unique_ptr<IMessage>> CANJ1939Generator::generateMessages(
         engine_state_.rpm = std::max(0.0, std::min(8000.0, engine_state_.rpm));
     }
 
-    messages.push_back(generateEngineSpeedMessage());
-    messages.push_back(generateEngineTemperatureMessage());
-    messages.push_back(generateEngineHoursMessage());
-
-    return messages;
-}
-
-void CANJ1939Generator::processMessages(std::vector<std::unique_ptr<IMessage>>&& messages) {
-    if (!messages.empty()) {
-        last_message_ = messages.back()->toString();
+    SBG_TRACE_SCOPE("encode", getChannel());
+    // The transport runs on the schedule's timeline and its frames are
+    // mapped onto this tick's timestamp
+    const uint64_t timestamp = currentTimestamp();
+    const uint64_t tick_start = static_cast<uint64_t>(schedule_.now().count());
+    const uint64_t tick_end = tick_start + static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count());
+    for (const PendingTransfer& transfer : pending_transfers_) {
+        transport_.queue(transfer.pgn, transfer.payload.data(), transfer.payload.size(),
+                         transfer.source, transfer.destination, tick_start);
     }
+    pending_transfers_.clear();
 
-    auto now = std::chrono::steady_clock::now();
-    for (const auto& msg : messages) {
-        if (auto j1939_msg = dynamic_cast<const CANJ1939Message*>(msg.get())) {
-            last_updates_[j1939_msg->getPGN()] = now;
+    faults_.advance(schedule_.now());
+    for (uint32_t key : schedule_.advance(duration)) {
+        const auto pgn = static_cast<CANJ1939PGN>(key);
+        const FaultPlan* fault = faults_.anyActive() ? faults_.find(key) : nullptr;
+        if (fault && fault->kind == FaultKind::DROP) {
+            continue;
         }
+        if (isMultiPacket(pgn)) {
+            uint8_t payload[J1939TransportScheduler::MAX_PAYLOAD];
+            transport_.queue(pgn, payload, buildPayload(pgn, payload), SOURCE_ADDRESS,
+                             J1939TransportScheduler::GLOBAL_ADDRESS, tick_start, CANJ1939Priority::PRIORITY_6);
+            continue;
+        }
+        Frame frame = generatePGNFrame(pgn, timestamp);
+        frame.channel = getChannel();
+        if (fault && fault->kind == FaultKind::BAD_LENGTH) {
+            frame.dlc = BAD_LENGTH_DLC;
+        }
+        batch.push(frame);
+    }
+
+    // Transport packets keep their own timing within the tick
+    const size_t first = batch.size();
+    transport_.advance(tick_end, batch, getChannel());
+    for (size_t i = first; i < batch.size(); ++i) {
+        batch[i].timestamp_ns = timestamp + (batch[i].timestamp_ns - tick_start);
     }
-    
-    DataGenerator::processMessages(std::move(messages));
 }
 
-std::unique_ptr<CANJ1939Message> CANJ1939Generator::generateEngineSpeedMessage() {
-    return std::make_unique<CANJ1939Message>(
-        CANJ1939PGN::ENGINE_SPEED,
-        static_cast<float>(engine_state_.rpm),
-        CANJ1939Priority::PRIORITY_3
-    );
+void CANJ1939Generator::processFrames(const FrameBatch& frames) {
+    if (!frames.empty()) {
+        std::lock_guard<std::mutex> lock(last_message_mutex_);
+        last_frame_ = frames[frames.size() - 1];
+        has_last_frame_ = true;
+    }
+    DataGenerator::processFrames(frames);
 }
 
-std::unique_ptr<CANJ1939Message> CANJ1939Generator::generateEngineTemperatureMessage() {
-    return std::make_unique<CANJ1939Message>(
-        CANJ1939PGN::ENGINE_TEMPERATURE,
-        static_cast<float>(engine_state_.temperature),
-        CANJ1939Priority::PRIORITY_3
-    );
+Frame CANJ1939Generator::generatePGNFrame(CANJ1939PGN pgn, uint64_t timestamp_ns) const {
+    switch (pgn) {
+        case CANJ1939PGN::ENGINE_SPEED:
+            return CANJ1939Message::encodeFrame(pgn, static_cast<float>(engine_state_.rpm),
+                                                CANJ1939Priority::PRIORITY_3, timestamp_ns);
+        case CANJ1939PGN::ENGINE_TEMPERATURE:
+            return CANJ1939Message::encodeFrame(pgn, static_cast<float>(engine_state_.temperature),
+                                                CANJ1939Priority::PRIORITY_3, timestamp_ns);
+        case CANJ1939PGN::ENGINE_HOURS:
+            return CANJ1939Message::encodeFrame(pgn, static_cast<float>(engine_state_.hours),
+                                                CANJ1939Priority::PRIORITY_6, timestamp_ns);
+        default:
+            throw std::invalid_argument("No generator for J1939 PGN");
+    }
 }
 
-std::unique_ptr<CANJ1939Message> CANJ1939Generator::generateEngineHoursMessage() {
-    return std::make_unique<CANJ1939Message>(
-        CANJ1939PGN::ENGINE_HOURS,
-        static_cast<float>(engine_state_.hours),
-        CANJ1939Priority::PRIORITY_6
-    );
+size_t CANJ1939Generator::buildPayload(CANJ1939PGN pgn, uint8_t* out) const {
+    switch (pgn) {
+        case CANJ1939PGN::DM1: {
+            // Amber warning lamp on, then the active trouble codes
+            out[0] = 0x04;
+            out[1] = 0xFF;
+            putDTC(out + 2, 100, 1, DTC_OCCURRENCES);   // Oil pressure low
+            putDTC(out + 6, 110, engine_state_.temperature > 110.0 ? 0 : 16, DTC_OCCURRENCES);  // Coolant temperature
+            putDTC(out + 10, 3216, 2, DTC_OCCURRENCES);  // Aftertreatment NOx erratic
+            return 14;
+        }
+        case CANJ1939PGN::COMPONENT_ID: {
+            const size_t size = sizeof(COMPONENT_ID_TEXT) - 1;
+            std::memcpy(out, COMPONENT_ID_TEXT, size);
+            return size;
+        }
+        case CANJ1939PGN::ENGINE_CONFIG: {
+            // Engine configuration 1: speed/torque map points, then gain and limits
+            std::memset(out, 0xFF, 39);
+            const double speeds[] = {750.0, 1000.0, 1400.0, 1800.0, 2100.0};
+            const uint8_t torques[] = {30, 80, 100, 90, 60};  // Percent of reference torque
+            for (size_t i = 0; i < 5; ++i) {
+                putSpeed(out + i * 3, speeds[i]);
+                out[i * 3 + 2] = static_cast<uint8_t>(torques[i] + 125);
+            }
+            putSpeed(out + 15, 2300.0);  // Speed at high idle
+            out[17] = 0x10;              // Endspeed governor gain
+            out[18] = 0x27;
+            out[19] = 0x10;              // Reference engine torque, 3600 Nm
+            out[20] = 0x0E;
+            return 39;
+        }
+        default:
+            throw std::invalid_argument("J1939 PGN has no transport payload");
+    }
 }
 
 std::string CANJ1939Generator::getLastMessage() {
-    return last_message_;
+    std::lock_guard<std::mutex> lock(last_message_mutex_);
+    if (!has_last_frame_) {
+        return std::string();
+    }
+    if (last_frame_.dlc != 8) {
+        // Injected length faults cannot be decoded; show what went out
+        TextBuffer text(64);
+        text.append("Malformed frame: ID=0x");
+        text.appendHex(last_frame_.id);
+        text.append(" DLC=");
+        text.appendInt(last_frame_.dlc);
+        return text.str();
+    }
+    return CANJ1939Message(last_frame_).toString();
 }
 
 } // namespace serial_bus_generator
\ No newline at end of file
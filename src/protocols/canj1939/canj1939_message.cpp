@@ -1,7 +1,7 @@
 #include "serial_bus_generator/protocols/canj1939/canj1939_message.hpp"
-#include <sstream>
-#include <iomanip>
+#include "serial_bus_generator/messages/frame_serializer.hpp"
 #include <cmath>
+#include <algorithm>
 #include <bitset>
 
 namespace serial_bus_generator {
@@ -9,144 +9,199 @@ namespace serial_bus_generator {
 CANJ1939Message::CANJ1939Message(CANJ1939PGN pgn, float value, CANJ1939Priority priority)
     : BaseMessage(MessageType::CANJ1939),
       pgn_(pgn),
-      priority_(priority),
-      data_(8, 0)  // Initialize 8 bytes of data to 0
+      priority_(priority)
 {
     if (!isValidPGN(pgn)) {
         throw MessageValidationError("Invalid J1939 PGN");
     }
     
-    encodeValue(value);
+    encodeValue(pgn, value, data_.data());
+}
+
+Frame CANJ1939Message::encodeFrame(CANJ1939PGN pgn, float value, CANJ1939Priority priority,
+                                   uint64_t timestamp_ns) {
+    if (!isValidPGN(pgn)) {
+        throw MessageValidationError("Invalid J1939 PGN");
+    }
+
+    Frame frame;
+    frame.timestamp_ns = timestamp_ns;
+    frame.id = calculateIdentifier(pgn, priority);
+    frame.type = MessageType::CANJ1939;
+    frame.dlc = 8;
+    encodeValue(pgn, value, frame.data);
+    return frame;
+}
+
+CANJ1939Message::CANJ1939Message(const Frame& frame)
+    : BaseMessage(MessageType::CANJ1939),
+      pgn_(pgnFromIdentifier(frame.id)),
+      priority_(static_cast<CANJ1939Priority>((frame.id >> 26) & 0x07))
+{
+    if (frame.type != MessageType::CANJ1939 || frame.dlc != 8) {
+        throw MessageValidationError("Frame is not a J1939 frame");
+    }
+    if (!isValidPGN(pgn_)) {
+        throw MessageValidationError("Invalid J1939 PGN");
+    }
+
+    std::copy(frame.data, frame.data + 8, data_.begin());
+    timestamp_ = static_cast<uint32_t>(frame.timestamp_ns / 1000000);
 }
 
 bool CANJ1939Message::isValid() const {
-    return isValidPGN(pgn_) && data_.size() == 8;
+    return isValidPGN(pgn_);
 }
 
 std::vector<uint8_t> CANJ1939Message::serialize() const {
-    std::vector<uint8_t> frame(8, 0);  // Initialize all bytes to 0
-    
-    // Store PGN in the first 3 bytes (little-endian)
-    uint32_t pgn_value = static_cast<uint32_t>(pgn_);
-    frame[2] = (pgn_value >> 16) & 0xFF;  // MSB
-    frame[1] = (pgn_value >> 8) & 0xFF;   // Middle byte
-    frame[0] = pgn_value & 0xFF;          // LSB
-    
-    // Copy remaining data bytes (starting at byte 3)
-    for (size_t i = 0; i < data_.size() && i < 5; ++i) {
-        frame[i + 3] = data_[i];
-    }
-    
+    std::vector<uint8_t> frame(CANJ1939_WIRE_SIZE);
+    serializeInto(frame.data(), frame.size());
+    return frame;
+}
+
+size_t CANJ1939Message::serializeInto(uint8_t* out, size_t capacity) const {
+    // PGN in the first 3 bytes (little-endian), then data bytes 0-4
+    return serializeFrame(toFrame(), out, capacity);
+}
+
+Frame CANJ1939Message::toFrame() const {
+    Frame frame;
+    frame.timestamp_ns = static_cast<uint64_t>(timestamp_) * 1000000;
+    frame.id = calculateIdentifier(pgn_, priority_);
+    frame.type = MessageType::CANJ1939;
+    frame.dlc = 8;
+    std::copy(data_.begin(), data_.end(), frame.data);
     return frame;
 }
 
 std::string CANJ1939Message::toString() const {
-    std::stringstream ss;
-    ss << "J1939 Message: PGN=0x" << std::hex << std::uppercase 
-       << static_cast<uint32_t>(pgn_)
-       << " Priority=" << static_cast<int>(priority_)
-       << " Value=" << std::fixed << std::setprecision(2) << getDecodedValue();
-    
-    return ss.str();
+    TextBuffer text(64);
+    formatTo(text);
+    return text.str();
+}
+
+void CANJ1939Message::formatTo(TextBuffer& out) const {
+    out.append("J1939 Message: PGN=0x");
+    out.appendHex(static_cast<uint32_t>(pgn_));
+    out.append(" Priority=");
+    out.appendInt(static_cast<int>(priority_));
+    out.append(" Value=");
+    out.appendFixed(getDecodedValue(), 2);
 }
 
 float CANJ1939Message::getDecodedValue() const {
+    return decodeValue(pgn_, data_.data());
+}
+
+float CANJ1939Message::decodeValue(CANJ1939PGN pgn, const uint8_t* data) {
     // Decode based on PGN type
-    switch (pgn_) {
+    switch (pgn) {
         case CANJ1939PGN::ENGINE_SPEED: {
             // Engine speed: 0.125 RPM/bit, 0 offset
-            uint16_t raw_value = (static_cast<uint16_t>(data_[1]) << 8) | data_[0];
+            uint16_t raw_value = (static_cast<uint16_t>(data[1]) << 8) | data[0];
             return raw_value * 0.125f;
         }
         
         case CANJ1939PGN::ENGINE_TEMPERATURE: {
             // Temperature: 1°C/bit, -40°C offset
-            return static_cast<float>(data_[0]) - 40.0f;
+            return static_cast<float>(data[0]) - 40.0f;
         }
         
         case CANJ1939PGN::ENGINE_HOURS: {
             // Engine hours: 0.05 hour/bit
-            uint32_t raw_value = (static_cast<uint32_t>(data_[3]) << 24) |
-                                (static_cast<uint32_t>(data_[2]) << 16) |
-                                (static_cast<uint32_t>(data_[1]) << 8) |
-                                data_[0];
+            uint32_t raw_value = (static_cast<uint32_t>(data[3]) << 24) |
+                                (static_cast<uint32_t>(data[2]) << 16) |
+                                (static_cast<uint32_t>(data[1]) << 8) |
+                                data[0];
             return raw_value * 0.05f;
         }
         
         case CANJ1939PGN::ENGINE_FLUID_LEVEL: {
             // Fluid level: 0.4%/bit, 0 offset
-            return data_[0] * 0.4f;
+            return data[0] * 0.4f;
         }
         
         default:
-            return static_cast<float>(data_[0]);
+            return static_cast<float>(data[0]);
     }
 }
 
-void CANJ1939Message::encodeValue(float value) {
+void CANJ1939Message::encodeValue(CANJ1939PGN pgn, float value, uint8_t* data) {
     // Clear existing data
-    std::fill(data_.begin(), data_.end(), 0);
+    std::fill(data, data + 8, 0);
     
     // Encode based on PGN type
-    switch (pgn_) {
+    switch (pgn) {
         case CANJ1939PGN::ENGINE_SPEED: {
             // Convert RPM to raw value (0.125 RPM/bit)
             uint16_t raw_value = static_cast<uint16_t>(std::round(value / 0.125f));
-            data_[0] = raw_value & 0xFF;
-            data_[1] = (raw_value >> 8) & 0xFF;
+            data[0] = raw_value & 0xFF;
+            data[1] = (raw_value >> 8) & 0xFF;
             break;
         }
         
         case CANJ1939PGN::ENGINE_TEMPERATURE: {
             // Convert temperature (+40°C offset)
-            data_[0] = static_cast<uint8_t>(std::round(value + 40.0f));
+            data[0] = static_cast<uint8_t>(std::round(value + 40.0f));
             break;
         }
         
         case CANJ1939PGN::ENGINE_HOURS: {
             // Convert hours (0.05 hour/bit)
             uint32_t raw_value = static_cast<uint32_t>(std::round(value / 0.05f));
-            data_[0] = raw_value & 0xFF;
-            data_[1] = (raw_value >> 8) & 0xFF;
-            data_[2] = (raw_value >> 16) & 0xFF;
-            data_[3] = (raw_value >> 24) & 0xFF;
+            data[0] = raw_value & 0xFF;
+            data[1] = (raw_value >> 8) & 0xFF;
+            data[2] = (raw_value >> 16) & 0xFF;
+            data[3] = (raw_value >> 24) & 0xFF;
             break;
         }
         
         case CANJ1939PGN::ENGINE_FLUID_LEVEL: {
             // Convert percentage (0.4%/bit)
-            data_[0] = static_cast<uint8_t>(std::round(value / 0.4f));
+            data[0] = static_cast<uint8_t>(std::round(value / 0.4f));
             break;
         }
         
         default:
-            data_[0] = static_cast<uint8_t>(std::round(value));
+            data[0] = static_cast<uint8_t>(std::round(value));
             break;
     }
 }
 
-bool CANJ1939Message::isValidPGN(CANJ1939PGN pgn) const {
+bool CANJ1939Message::isValidPGN(CANJ1939PGN pgn) {
     switch (pgn) {
         case CANJ1939PGN::ENGINE_SPEED:
         case CANJ1939PGN::ENGINE_TEMPERATURE:
         case CANJ1939PGN::ENGINE_HOURS:
         case CANJ1939PGN::ENGINE_FLUID_LEVEL:
         case CANJ1939PGN::ENGINE_CONFIG:
+        case CANJ1939PGN::DM1:
+        case CANJ1939PGN::COMPONENT_ID:
+        case CANJ1939PGN::TP_CM:
+        case CANJ1939PGN::TP_DT:
             return true;
         default:
             return false;
     }
 }
 
-uint32_t CANJ1939Message::calculateIdentifier() const {
+CANJ1939PGN CANJ1939Message::pgnFromIdentifier(uint32_t identifier) {
+    uint32_t pgn = (identifier >> 8) & 0x3FFFF;
+    if (((pgn >> 8) & 0xFF) < 240) {
+        pgn &= 0x3FF00;  // PDU1: drop the destination address
+    }
+    return static_cast<CANJ1939PGN>(pgn);
+}
+
+uint32_t CANJ1939Message::calculateIdentifier(CANJ1939PGN pgn, CANJ1939Priority priority) {
     // Build 29-bit CAN identifier
     uint32_t identifier = 0;
     
     // Priority (bits 26-28)
-    identifier |= (static_cast<uint32_t>(priority_) & 0x07) << 26;
+    identifier |= (static_cast<uint32_t>(priority) & 0x07) << 26;
     
     // PGN (bits 8-25)
-    identifier |= (static_cast<uint32_t>(pgn_) & 0x3FFFF) << 8;
+    identifier |= (static_cast<uint32_t>(pgn) & 0x3FFFF) << 8;
     
     // Source Address (bits 0-7) - Using 0xFE as default source
     identifier |= 0xFE;
@@ -0,0 +1,213 @@
+#include "serial_bus_generator/protocols/canj1939/canj1939_transport.hpp"
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+
+namespace serial_bus_generator {
+
+J1939TransportScheduler::J1939TransportScheduler(const J1939TransportTiming& timing)
+    : timing_(timing)
+{
+    if (timing_.packets_per_cts == 0) {
+        throw std::invalid_argument("CTS window must hold at least one packet");
+    }
+}
+
+uint32_t J1939TransportScheduler::makeIdentifier(CANJ1939Priority priority, CANJ1939PGN pgn,
+                                                 uint8_t destination, uint8_t source) {
+    uint32_t pgn_field = static_cast<uint32_t>(pgn) & 0x3FFFF;
+    if (((pgn_field >> 8) & 0xFF) < 240) {
+        pgn_field = (pgn_field & 0x3FF00) | destination;  // PDU1
+    }
+    return ((static_cast<uint32_t>(priority) & 0x07) << 26) | (pgn_field << 8) | source;
+}
+
+void J1939TransportScheduler::queue(CANJ1939PGN pgn, const uint8_t* data, size_t size, uint8_t source,
+                                    uint8_t destination, uint64_t start_ns, CANJ1939Priority priority) {
+    if (size <= 8 || size > MAX_PAYLOAD) {
+        throw std::invalid_argument("Transport payloads must be 9 to 1785 bytes");
+    }
+    if (source == GLOBAL_ADDRESS) {
+        throw std::invalid_argument("Invalid J1939 source address");
+    }
+
+    uint32_t index;
+    if (!free_.empty()) {
+        index = free_.back();
+        free_.pop_back();
+    } else {
+        index = static_cast<uint32_t>(sessions_.size());
+        sessions_.emplace_back();
+    }
+
+    Session& session = sessions_[index];
+    session.pgn = pgn;
+    session.priority = priority;
+    session.source = source;
+    session.destination = destination;
+    session.step = Step::ANNOUNCE;
+    session.packets = static_cast<uint16_t>((size + BYTES_PER_PACKET - 1) / BYTES_PER_PACKET);
+    session.next_packet = 1;
+    session.window_left = 0;
+    session.start_ns = start_ns;
+    session.payload.assign(data, data + size);
+
+    auto pair = busy_pairs_.find(pairKey(session));
+    if (pair != busy_pairs_.end()) {
+        pair->second.push_back(index);
+        ++waiting_count_;
+        return;
+    }
+    busy_pairs_.emplace(pairKey(session), std::deque<uint32_t>());
+    activate(index, start_ns);
+}
+
+void J1939TransportScheduler::advance(uint64_t end_ns, FrameBatch& batch, uint16_t channel) {
+    while (!heap_.empty() && heap_.front().due_ns < end_ns) {
+        std::pop_heap(heap_.begin(), heap_.end(), std::greater<HeapEntry>());
+        const uint32_t index = heap_.back().session;
+        heap_.pop_back();
+
+        Session& session = sessions_[index];
+        emit(session, batch, channel);
+        if (session.step == Step::DONE) {
+            finish(index);
+        } else {
+            activate(index, session.due_ns);
+        }
+    }
+}
+
+void J1939TransportScheduler::reset() {
+    sessions_.clear();
+    free_.clear();
+    heap_.clear();
+    busy_pairs_.clear();
+    waiting_count_ = 0;
+    completed_ = 0;
+}
+
+void J1939TransportScheduler::activate(uint32_t index, uint64_t due_ns) {
+    sessions_[index].due_ns = due_ns;
+    heap_.push_back({due_ns, sequence_++, index});
+    std::push_heap(heap_.begin(), heap_.end(), std::greater<HeapEntry>());
+}
+
+void J1939TransportScheduler::finish(uint32_t index) {
+    const Session& session = sessions_[index];
+    const uint64_t finished_ns = session.due_ns;
+    auto pair = busy_pairs_.find(pairKey(session));
+    free_.push_back(index);
+    ++completed_;
+
+    if (pair->second.empty()) {
+        busy_pairs_.erase(pair);
+        return;
+    }
+    // Start the next transfer between the same addresses
+    const uint32_t next = pair->second.front();
+    pair->second.pop_front();
+    --waiting_count_;
+    activate(next, std::max(sessions_[next].start_ns, finished_ns));
+}
+
+void J1939TransportScheduler::emit(Session& session, FrameBatch& batch, uint16_t channel) {
+    const bool broadcast = session.destination == GLOBAL_ADDRESS;
+    const uint32_t pgn = static_cast<uint32_t>(session.pgn);
+    const uint16_t size = static_cast<uint16_t>(session.payload.size());
+    const uint8_t pgn_bytes[3] = {static_cast<uint8_t>(pgn), static_cast<uint8_t>(pgn >> 8),
+                                  static_cast<uint8_t>(pgn >> 16)};
+
+    switch (session.step) {
+        case Step::ANNOUNCE: {
+            const uint8_t data[8] = {broadcast ? CM_BAM : CM_RTS, static_cast<uint8_t>(size),
+                                     static_cast<uint8_t>(size >> 8), static_cast<uint8_t>(session.packets),
+                                     broadcast ? uint8_t{0xFF} : timing_.packets_per_cts,
+                                     pgn_bytes[0], pgn_bytes[1], pgn_bytes[2]};
+            pushControl(session, false, data, batch, channel);
+            if (broadcast) {
+                session.step = Step::DATA;
+                session.due_ns += static_cast<uint64_t>(timing_.bam_packet_interval.count());
+            } else {
+                session.step = Step::CTS;
+                session.due_ns += static_cast<uint64_t>(timing_.response_delay.count());
+            }
+            break;
+        }
+
+        case Step::CTS: {
+            const uint16_t remaining = static_cast<uint16_t>(session.packets - session.next_packet + 1);
+            session.window_left = std::min<uint16_t>(remaining, timing_.packets_per_cts);
+            if (timing_.simulate_responder) {
+                const uint8_t data[8] = {CM_CTS, static_cast<uint8_t>(session.window_left),
+                                         static_cast<uint8_t>(session.next_packet), 0xFF, 0xFF,
+                                         pgn_bytes[0], pgn_bytes[1], pgn_bytes[2]};
+                pushControl(session, true, data, batch, channel);
+            }
+            session.step = Step::DATA;
+            session.due_ns += static_cast<uint64_t>(timing_.rts_packet_interval.count());
+            break;
+        }
+
+        case Step::DATA: {
+            Frame frame;
+            frame.timestamp_ns = session.due_ns;
+            frame.id = makeIdentifier(session.priority, CANJ1939PGN::TP_DT, session.destination, session.source);
+            frame.channel = channel;
+            frame.type = MessageType::CANJ1939;
+            frame.dlc = 8;
+            frame.data[0] = static_cast<uint8_t>(session.next_packet);
+            const size_t offset = (session.next_packet - 1) * BYTES_PER_PACKET;
+            const size_t count = std::min(BYTES_PER_PACKET, session.payload.size() - offset);
+            std::fill(frame.data + 1, frame.data + 8, 0xFF);  // Unused bytes of the last packet
+            std::copy(session.payload.data() + offset, session.payload.data() + offset + count, frame.data + 1);
+            batch.push(frame);
+
+            ++session.next_packet;
+            const bool last = session.next_packet > session.packets;
+            if (broadcast) {
+                session.step = last ? Step::DONE : Step::DATA;
+                session.due_ns += last ? 0 : static_cast<uint64_t>(timing_.bam_packet_interval.count());
+            } else if (last) {
+                session.step = Step::ACK;
+                session.due_ns += static_cast<uint64_t>(timing_.response_delay.count());
+            } else if (--session.window_left == 0) {
+                session.step = Step::CTS;
+                session.due_ns += static_cast<uint64_t>(timing_.response_delay.count());
+            } else {
+                session.due_ns += static_cast<uint64_t>(timing_.rts_packet_interval.count());
+            }
+            break;
+        }
+
+        case Step::ACK: {
+            if (timing_.simulate_responder) {
+                const uint8_t data[8] = {CM_EOM_ACK, static_cast<uint8_t>(size), static_cast<uint8_t>(size >> 8),
+                                         static_cast<uint8_t>(session.packets), 0xFF,
+                                         pgn_bytes[0], pgn_bytes[1], pgn_bytes[2]};
+                pushControl(session, true, data, batch, channel);
+            }
+            session.step = Step::DONE;
+            break;
+        }
+
+        case Step::DONE:
+            break;
+    }
+}
+
+void J1939TransportScheduler::pushControl(const Session& session, bool from_destination,
+                                          const uint8_t (&data)[8], FrameBatch& batch, uint16_t channel) const {
+    Frame frame;
+    frame.timestamp_ns = session.due_ns;
+    frame.id = from_destination
+        ? makeIdentifier(session.priority, CANJ1939PGN::TP_CM, session.source, session.destination)
+        : makeIdentifier(session.priority, CANJ1939PGN::TP_CM, session.destination, session.source);
+    frame.channel = channel;
+    frame.type = MessageType::CANJ1939;
+    frame.dlc = 8;
+    std::copy(data, data + 8, frame.data);
+    batch.push(frame);
+}
+
+} // namespace serial_bus_generator
@@ -0,0 +1,317 @@
+#include "serial_bus_generator/sinks/pcapng_sink.hpp"
+#include "serial_bus_generator/core/timed_wait.hpp"
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <system_error>
+#include <unistd.h>
+
+namespace serial_bus_generator {
+
+namespace {
+
+constexpr uint32_t SHB_TYPE = 0x0A0D0D0A;
+constexpr uint32_t IDB_TYPE = 0x00000001;
+constexpr uint32_t EPB_TYPE = 0x00000006;
+constexpr uint32_t BYTE_ORDER_MAGIC = 0x1A2B3C4D;
+
+constexpr uint16_t OPT_ENDOFOPT = 0;
+constexpr uint16_t OPT_SHB_USERAPPL = 4;
+constexpr uint16_t OPT_IF_NAME = 2;
+constexpr uint16_t OPT_IF_TSRESOL = 9;
+constexpr uint8_t TSRESOL_NANOSECONDS = 9;
+
+constexpr size_t EPB_OVERHEAD = 32;        // Block header, fields and trailing length
+constexpr size_t SOCKETCAN_HEADER = 8;     // can_id, len, padding, reserved
+constexpr size_t MAX_EPB_SIZE = EPB_OVERHEAD + SOCKETCAN_HEADER + 8;
+
+size_t padded(size_t size) {
+    return (size + 3) & ~size_t{3};
+}
+
+// pcapng fields are in the writer's byte order, announced by the SHB magic
+template <typename T>
+void put(std::vector<uint8_t>& out, T value) {
+    const size_t at = out.size();
+    out.resize(at + sizeof(T));
+    std::memcpy(out.data() + at, &value, sizeof(T));
+}
+
+void putBytes(std::vector<uint8_t>& out, const void* data, size_t size) {
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    out.insert(out.end(), bytes, bytes + size);
+    out.resize(out.size() + padded(size) - size, 0);
+}
+
+void putOption(std::vector<uint8_t>& out, uint16_t code, const void* value, uint16_t length) {
+    put(out, code);
+    put(out, length);
+    putBytes(out, value, length);
+}
+
+// Patches the total length of the block started at `start` and appends it again
+void endBlock(std::vector<uint8_t>& out, size_t start) {
+    const uint32_t length = static_cast<uint32_t>(out.size() - start + sizeof(uint32_t));
+    std::memcpy(out.data() + start + sizeof(uint32_t), &length, sizeof(length));
+    put(out, length);
+}
+
+void putInterface(std::vector<uint8_t>& out, uint16_t link_type, uint32_t snap_length, const char* name) {
+    const size_t start = out.size();
+    put(out, IDB_TYPE);
+    put(out, uint32_t{0});
+    put(out, link_type);
+    put(out, uint16_t{0});
+    put(out, snap_length);
+    putOption(out, OPT_IF_NAME, name, static_cast<uint16_t>(std::strlen(name)));
+    putOption(out, OPT_IF_TSRESOL, &TSRESOL_NANOSECONDS, sizeof(TSRESOL_NANOSECONDS));
+    put(out, OPT_ENDOFOPT);
+    put(out, uint16_t{0});
+    endBlock(out, start);
+}
+
+} // namespace
+
+PcapngSink::PcapngSink(const std::string& path, const PcapngOptions& options)
+    : path_(path)
+    , options_(options)
+{
+    if (options_.buffer_bytes == 0) {
+        throw std::invalid_argument("Invalid pcapng buffer size");
+    }
+    const bool rotating = options_.rotate_bytes > 0 || options_.rotate_interval.count() > 0;
+    openFile(rotating ? rotatedPath(path_, 0) : path_);
+
+    buffer_.reserve(options_.buffer_bytes + MAX_EPB_SIZE);
+    pending_.reserve(options_.buffer_bytes + MAX_EPB_SIZE);
+    appendHeaders();
+    io_thread_ = std::thread(&PcapngSink::ioLoop, this);
+}
+
+PcapngSink::~PcapngSink() {
+    try {
+        close();
+    } catch (...) {
+        // Destructors must not throw; call close() to see write errors
+    }
+}
+
+void PcapngSink::write(const Frame* frames, size_t count) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (closed_) {
+        throw std::logic_error("pcapng sink is closed");
+    }
+    if (io_error_) {
+        std::rethrow_exception(io_error_);
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        const Frame& frame = frames[i];
+        if (file_frames_ > 0) {
+            const bool full = options_.rotate_bytes > 0 && file_bytes_ + MAX_EPB_SIZE > options_.rotate_bytes;
+            // Frames older than the file's first, e.g. from another channel, never expire it
+            const bool expired = options_.rotate_interval.count() > 0 && frame.timestamp_ns > file_start_ns_ &&
+                frame.timestamp_ns - file_start_ns_ >= static_cast<uint64_t>(options_.rotate_interval.count());
+            if (full || expired) {
+                submit(lock, true);
+                appendHeaders();
+                ++file_count_;
+            }
+        }
+
+        appendFrame(frame);
+        ++frame_count_;
+        if (buffer_.size() >= options_.buffer_bytes) {
+            submit(lock, false);
+        }
+    }
+}
+
+void PcapngSink::flush() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (closed_) {
+        return;
+    }
+    if (!buffer_.empty()) {
+        submit(lock, false);
+    }
+    waitUntil(pending_done_, lock, [this] { return !has_pending_ || io_error_; });
+    if (io_error_) {
+        std::rethrow_exception(io_error_);
+    }
+}
+
+void PcapngSink::close() {
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (closed_) {
+            return;
+        }
+        closed_ = true;
+        waitUntil(pending_done_, lock, [this] { return !has_pending_ || io_error_; });
+        if (!io_error_ && !buffer_.empty()) {
+            pending_.swap(buffer_);
+            has_pending_ = true;
+            rotate_after_pending_ = false;
+        }
+        closing_ = true;
+        pending_ready_.notify_one();
+    }
+    io_thread_.join();
+
+    if (fd_ >= 0) {
+        ::close(fd_);
+        fd_ = -1;
+    }
+    if (io_error_) {
+        std::rethrow_exception(io_error_);
+    }
+}
+
+uint64_t PcapngSink::getFrameCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return frame_count_;
+}
+
+size_t PcapngSink::getFileCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return file_count_;
+}
+
+std::string PcapngSink::rotatedPath(const std::string& path, size_t index) {
+    const size_t slash = path.find_last_of('/');
+    const size_t dot = path.find_last_of('.');
+    const size_t split = dot != std::string::npos && (slash == std::string::npos || dot > slash)
+        ? dot : path.size();
+    char suffix[16];
+    std::snprintf(suffix, sizeof(suffix), "_%05zu", index);
+    return path.substr(0, split) + suffix + path.substr(split);
+}
+
+void PcapngSink::appendHeaders() {
+    const size_t start = buffer_.size();
+    put(buffer_, SHB_TYPE);
+    put(buffer_, uint32_t{0});
+    put(buffer_, BYTE_ORDER_MAGIC);
+    put(buffer_, uint16_t{1});  // Version 1.0
+    put(buffer_, uint16_t{0});
+    put(buffer_, int64_t{-1});  // Section length not known up front
+    static constexpr char APPLICATION[] = "serial_bus_generator";
+    putOption(buffer_, OPT_SHB_USERAPPL, APPLICATION, sizeof(APPLICATION) - 1);
+    put(buffer_, OPT_ENDOFOPT);
+    put(buffer_, uint16_t{0});
+    endBlock(buffer_, start);
+
+    // Interface IDs are fixed: CAN_INTERFACE, then ARINC429_INTERFACE
+    putInterface(buffer_, LINKTYPE_CAN_SOCKETCAN, SOCKETCAN_HEADER + 8, "j1939");
+    putInterface(buffer_, LINKTYPE_USER0, 4, "arinc429");
+
+    file_bytes_ = buffer_.size() - start;
+    file_frames_ = 0;
+}
+
+void PcapngSink::appendFrame(const Frame& frame) {
+    if (file_frames_ == 0) {
+        file_start_ns_ = frame.timestamp_ns;
+    }
+
+    const size_t start = buffer_.size();
+    const bool is_can = frame.type == MessageType::CANJ1939;
+    const uint8_t dlc = frame.dlc > 8 ? 8 : frame.dlc;
+    const uint32_t captured = is_can ? static_cast<uint32_t>(SOCKETCAN_HEADER + dlc) : 4;
+
+    put(buffer_, EPB_TYPE);
+    put(buffer_, uint32_t{0});
+    put(buffer_, is_can ? CAN_INTERFACE : ARINC429_INTERFACE);
+    put(buffer_, static_cast<uint32_t>(frame.timestamp_ns >> 32));
+    put(buffer_, static_cast<uint32_t>(frame.timestamp_ns));
+    put(buffer_, captured);
+    put(buffer_, captured);
+
+    if (is_can) {
+        // struct can_frame, with can_id in network byte order
+        const uint32_t can_id = frame.id | CAN_EFF_FLAG;
+        uint8_t packet[SOCKETCAN_HEADER + 8] = {
+            static_cast<uint8_t>(can_id >> 24), static_cast<uint8_t>(can_id >> 16),
+            static_cast<uint8_t>(can_id >> 8), static_cast<uint8_t>(can_id),
+            dlc, 0, 0, 0};
+        std::memcpy(packet + SOCKETCAN_HEADER, frame.data, dlc);
+        putBytes(buffer_, packet, captured);
+    } else {
+        putBytes(buffer_, frame.data, 4);  // The word, little-endian as in Frame
+    }
+    endBlock(buffer_, start);
+
+    file_bytes_ += buffer_.size() - start;
+    ++file_frames_;
+}
+
+void PcapngSink::submit(std::unique_lock<std::mutex>& lock, bool rotate) {
+    waitUntil(pending_done_, lock, [this] { return !has_pending_ || io_error_; });
+    if (io_error_) {
+        std::rethrow_exception(io_error_);
+    }
+    pending_.swap(buffer_);
+    buffer_.clear();
+    has_pending_ = true;
+    rotate_after_pending_ = rotate;
+    pending_ready_.notify_one();
+}
+
+void PcapngSink::ioLoop() {
+    size_t file_index = 0;
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        waitUntil(pending_ready_, lock, [this] { return has_pending_ || closing_; });
+        if (!has_pending_) {
+            return;
+        }
+        const bool rotate = rotate_after_pending_;
+        lock.unlock();
+
+        std::exception_ptr error;
+        try {
+            writeAll(pending_.data(), pending_.size());
+            if (rotate) {
+                ::close(fd_);
+                fd_ = -1;
+                openFile(rotatedPath(path_, ++file_index));
+            }
+        } catch (...) {
+            error = std::current_exception();
+        }
+
+        lock.lock();
+        pending_.clear();
+        has_pending_ = false;
+        if (error && !io_error_) {
+            io_error_ = error;
+        }
+        pending_done_.notify_all();
+    }
+}
+
+void PcapngSink::openFile(const std::string& path) {
+    fd_ = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd_ < 0) {
+        throw std::system_error(errno, std::generic_category(), "Cannot create pcapng file " + path);
+    }
+}
+
+void PcapngSink::writeAll(const uint8_t* data, size_t size) {
+    while (size > 0) {
+        const ssize_t written = ::write(fd_, data, size);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw std::system_error(errno, std::generic_category(), "pcapng write failed");
+        }
+        data += written;
+        size -= static_cast<size_t>(written);
+    }
+}
+
+} // namespace serial_bus_generator
@@ -0,0 +1,308 @@
+#include "serial_bus_generator/sinks/queued_sink.hpp"
+#include "serial_bus_generator/core/timed_wait.hpp"
+#include "serial_bus_generator/protocols/canj1939/canj1939_message.hpp"
+#include "serial_bus_generator/trace/tracer.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace serial_bus_generator {
+
+QueuedSink::QueuedSink(std::shared_ptr<IFrameSink> sink, QueuedSinkOptions options)
+    : sink_(std::move(sink))
+    , options_(options)
+{
+    if (!sink_) {
+        throw std::invalid_argument("Null sink");
+    }
+    if (options_.capacity == 0) {
+        throw std::invalid_argument("Sink queue needs room for at least one frame");
+    }
+    // Coalesced frames keep their slots until the thread skips them
+    ring_.resize(options_.policy == OverrunPolicy::COALESCE ? 2 * options_.capacity : options_.capacity);
+    discarded_slots_.resize(ring_.size());
+    thread_ = std::thread(&QueuedSink::run, this);
+}
+
+QueuedSink::~QueuedSink() {
+    try {
+        close();
+    } catch (...) {
+        // Destructors must not throw
+    }
+}
+
+void QueuedSink::write(const Frame* frames, size_t count) {
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (closing_) {
+            throw std::logic_error("Queued sink is closed");
+        }
+        bool blocked = false;
+        for (size_t i = 0; i < count; ++i) {
+            push(frames[i], lock, blocked);
+        }
+        stats_.max_queue_depth = std::max(stats_.max_queue_depth, queuedFrames());
+        not_empty_.notify_one();
+    }
+}
+
+void QueuedSink::push(const Frame& frame, std::unique_lock<std::mutex>& lock, bool& blocked) {
+    const uint64_t key = options_.policy == OverrunPolicy::COALESCE ? coalesceKey(frame) : NO_KEY;
+    if (queuedFrames() == options_.capacity) {
+        switch (options_.policy) {
+        case OverrunPolicy::BLOCK:
+            if (!blocked) {
+                ++stats_.blocked_writes;
+                blocked = true;
+            }
+            not_empty_.notify_one();  // The thread may not have seen this write's frames yet
+            waitUntil(not_full_, lock, [this] { return queuedFrames() < options_.capacity || closing_; });
+            if (queuedFrames() == options_.capacity) {
+                ++stats_.dropped_newest;  // Closed while waiting
+                return;
+            }
+            break;
+        case OverrunPolicy::DROP_OLDEST:
+            ++tail_;
+            ++stats_.dropped_oldest;
+            break;
+        case OverrunPolicy::COALESCE:
+            if (!coalesce(key)) {
+                ++stats_.dropped_newest;
+                return;
+            }
+            break;
+        case OverrunPolicy::DROP_NEWEST:
+            ++stats_.dropped_newest;
+            return;
+        }
+    }
+    if (depth() == ring_.size()) {
+        compact();
+    }
+
+    const size_t slot = head_ % ring_.size();
+    ring_[slot] = frame;
+    discarded_slots_[slot] = false;
+    if (key != NO_KEY) {
+        auto [queued, inserted] = queued_.try_emplace(key, head_);
+        if (!inserted) {
+            if (queued->second >= tail_) {
+                superseded_.push_back(queued->second);
+            }
+            queued->second = head_;
+        }
+        if (superseded_.size() > ring_.size()) {
+            // Most of them have been written by now
+            superseded_.erase(std::remove_if(superseded_.begin(), superseded_.end(),
+                [this](uint64_t seq) { return seq < tail_; }), superseded_.end());
+        }
+    }
+    ++head_;
+}
+
+bool QueuedSink::coalesce(uint64_t key) {
+    // Discard every queued frame that has a newer one of its signal behind
+    // it; the rest stay where they were queued, so the frames stay in time order
+    const size_t discarded = discarded_;
+    for (uint64_t seq : superseded_) {
+        if (seq >= tail_) {
+            discard(seq);
+        }
+    }
+    superseded_.clear();
+    if (discarded_ > discarded) {
+        return true;
+    }
+
+    // Every queued frame is its signal's latest: the arriving frame can
+    // only replace an older frame of its own signal
+    if (key == NO_KEY) {
+        return false;
+    }
+    auto queued = queued_.find(key);
+    if (queued == queued_.end() || queued->second < tail_) {
+        return false;
+    }
+    discard(queued->second);
+    queued_.erase(queued);
+    return true;
+}
+
+void QueuedSink::discard(uint64_t seq) {
+    discarded_slots_[seq % ring_.size()] = true;
+    ++discarded_;
+    ++stats_.coalesced;
+}
+
+void QueuedSink::compact() {
+    // Only reached once as many frames were discarded as the queue holds
+    uint64_t kept = tail_;
+    superseded_.clear();
+    for (uint64_t seq = tail_; seq < head_; ++seq) {
+        const size_t slot = seq % ring_.size();
+        if (discarded_slots_[slot]) {
+            continue;
+        }
+        const size_t to = kept % ring_.size();
+        ring_[to] = ring_[slot];
+        discarded_slots_[to] = false;
+        const uint64_t key = coalesceKey(ring_[to]);
+        if (key != NO_KEY) {
+            auto queued = queued_.find(key);
+            if (queued != queued_.end() && queued->second == seq) {
+                queued->second = kept;
+            } else {
+                superseded_.push_back(kept);
+            }
+        }
+        ++kept;
+    }
+    head_ = kept;
+    discarded_ = 0;
+}
+
+void QueuedSink::flush() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (closing_) {
+        return;
+    }
+    const uint64_t request = ++flush_requests_;
+    not_empty_.notify_one();
+    waitUntil(idle_, lock, [this, request] { return flushes_done_ >= request; });
+}
+
+void QueuedSink::close() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        closing_ = true;
+        not_empty_.notify_all();
+        not_full_.notify_all();
+    }
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+
+    // The thread delivered everything queued before it stopped
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (dirty_) {
+        dirty_ = false;
+        sink_->flush();
+    }
+}
+
+void QueuedSink::run() {
+    std::vector<Frame> batch(MAX_BATCH);
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        waitUntil(not_empty_, lock, [this] {
+            return depth() > 0 || flush_requests_ > flushes_done_ || closing_;
+        });
+
+        if (depth() > 0) {
+            size_t count = 0;
+            while (count < MAX_BATCH && tail_ < head_) {
+                const size_t slot = tail_++ % ring_.size();
+                if (discarded_slots_[slot]) {
+                    --discarded_;
+                    continue;
+                }
+                batch[count++] = ring_[slot];
+            }
+            not_full_.notify_all();
+            if (count == 0) {
+                continue;  // Only coalesced frames were left
+            }
+            in_flight_ = count;
+            lock.unlock();
+
+            std::string error;
+            try {
+                SBG_TRACE_SCOPE("queued write", Tracer::NO_CHANNEL);
+                sink_->write(batch.data(), count);
+            } catch (const std::exception& e) {
+                error = e.what();
+            }
+
+            lock.lock();
+            in_flight_ = 0;
+            dirty_ = true;
+            if (error.empty()) {
+                stats_.written += count;
+            } else {
+                stats_.failed += count;
+                last_error_ = error;
+            }
+        } else if (flush_requests_ > flushes_done_) {
+            // Everything requested before the flush has been written
+            const uint64_t requests = flush_requests_;
+            lock.unlock();
+            std::string error;
+            try {
+                sink_->flush();
+            } catch (const std::exception& e) {
+                error = e.what();
+            }
+            lock.lock();
+            if (!error.empty()) {
+                last_error_ = error;
+            }
+            dirty_ = false;
+            flushes_done_ = requests;
+            idle_.notify_all();
+        } else if (closing_) {
+            return;
+        }
+    }
+}
+
+QueuedSinkStats QueuedSink::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    QueuedSinkStats stats = stats_;
+    stats.queue_depth = queuedFrames() + in_flight_;
+    return stats;
+}
+
+std::string QueuedSink::getLastError() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return last_error_;
+}
+
+uint64_t QueuedSink::coalesceKey(const Frame& frame) {
+    const uint64_t source = static_cast<uint64_t>(frame.channel) << 40 |
+                            static_cast<uint64_t>(frame.type) << 32;
+    if (frame.type == MessageType::ARINC429) {
+        return source | (frame.id & 0xFF);  // Label; the bits above it are data
+    }
+    const CANJ1939PGN pgn = CANJ1939Message::pgnFromIdentifier(frame.id);
+    if (pgn == CANJ1939PGN::TP_CM || pgn == CANJ1939PGN::TP_DT) {
+        return NO_KEY;
+    }
+    return source | (frame.id & 0x3FFFFFF);  // PGN, destination and source address
+}
+
+const char* QueuedSink::policyName(OverrunPolicy policy) {
+    switch (policy) {
+    case OverrunPolicy::BLOCK:
+        return "block";
+    case OverrunPolicy::DROP_NEWEST:
+        return "drop-newest";
+    case OverrunPolicy::DROP_OLDEST:
+        return "drop-oldest";
+    case OverrunPolicy::COALESCE:
+        return "coalesce";
+    }
+    return "unknown";
+}
+
+OverrunPolicy QueuedSink::parsePolicy(const std::string& name) {
+    for (OverrunPolicy policy : {OverrunPolicy::BLOCK, OverrunPolicy::DROP_NEWEST,
+                                 OverrunPolicy::DROP_OLDEST, OverrunPolicy::COALESCE}) {
+        if (name == policyName(policy)) {
+            return policy;
+        }
+    }
+    throw std::invalid_argument("Unknown overrun policy: " + name);
+}
+
+} // namespace serial_bus_generator
@@ -0,0 +1,189 @@
+#include "serial_bus_generator/sinks/socketcan_sink.hpp"
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+
+#ifdef __linux__
+#include <linux/can.h>
+#include <linux/can/raw.h>
+#include <net/if.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+namespace serial_bus_generator {
+
+#ifdef __linux__
+
+static_assert(sizeof(can_frame) == SocketCanSink::CAN_FRAME_SIZE, "Unexpected can_frame layout");
+
+// Preallocated sendmmsg() arguments, reused by every batch
+struct SocketCanSink::Batch {
+    can_frame frames[MAX_BATCH];
+    iovec iov[MAX_BATCH];
+    mmsghdr messages[MAX_BATCH];
+
+    Batch() {
+        std::memset(messages, 0, sizeof(messages));
+        for (size_t i = 0; i < MAX_BATCH; ++i) {
+            iov[i].iov_base = &frames[i];
+            iov[i].iov_len = sizeof(can_frame);
+            messages[i].msg_hdr.msg_iov = &iov[i];
+            messages[i].msg_hdr.msg_iovlen = 1;
+        }
+    }
+};
+
+SocketCanSink::SocketCanSink(const std::string& interface_name, std::chrono::milliseconds send_timeout)
+    : fd_(-1)
+    , send_timeout_(send_timeout)
+    , batch_(std::make_unique<Batch>())
+{
+    if (interface_name.empty() || interface_name.size() >= IFNAMSIZ) {
+        throw std::invalid_argument("Invalid CAN interface name");
+    }
+    fd_ = ::socket(PF_CAN, SOCK_RAW | SOCK_CLOEXEC, CAN_RAW);
+    if (fd_ < 0) {
+        throw std::system_error(errno, std::generic_category(), "Cannot open CAN socket");
+    }
+
+    sockaddr_can address{};
+    address.can_family = AF_CAN;
+    address.can_ifindex = static_cast<int>(::if_nametoindex(interface_name.c_str()));
+    if (address.can_ifindex == 0 ||
+        ::bind(fd_, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+        const int error = errno;
+        ::close(fd_);
+        throw std::system_error(error, std::generic_category(), "Cannot bind CAN interface " + interface_name);
+    }
+
+    // Transmit only; received traffic would just fill the socket buffer
+    ::setsockopt(fd_, SOL_CAN_RAW, CAN_RAW_FILTER, nullptr, 0);
+}
+
+SocketCanSink::SocketCanSink(int socket_fd, std::chrono::milliseconds send_timeout)
+    : fd_(socket_fd)
+    , send_timeout_(send_timeout)
+    , batch_(std::make_unique<Batch>())
+{
+    if (fd_ < 0) {
+        throw std::invalid_argument("Invalid socket");
+    }
+}
+
+SocketCanSink::~SocketCanSink() {
+    ::close(fd_);
+}
+
+void SocketCanSink::write(const Frame* frames, size_t count) {
+    // Shared by the tick's batches, so a full TX queue costs one send timeout per tick
+    std::chrono::steady_clock::time_point deadline{};
+    size_t batched = 0;
+    for (size_t i = 0; i < count; ++i) {
+        if (frames[i].type != MessageType::CANJ1939) {
+            continue;
+        }
+        toCanFrame(frames[i], reinterpret_cast<uint8_t*>(&batch_->frames[batched]));
+        if (++batched == MAX_BATCH) {
+            batched = 0;
+            if (!sendBatch(MAX_BATCH, deadline)) {
+                dropRest(frames + i + 1, count - i - 1);
+                return;
+            }
+        }
+    }
+    if (batched > 0) {
+        sendBatch(batched, deadline);
+    }
+}
+
+void SocketCanSink::dropRest(const Frame* frames, size_t count) {
+    uint64_t dropped = 0;
+    for (size_t i = 0; i < count; ++i) {
+        dropped += frames[i].type == MessageType::CANJ1939;
+    }
+    dropped_ += dropped;
+}
+
+void SocketCanSink::toCanFrame(const Frame& frame, uint8_t* out) {
+    can_frame can{};
+    can.can_id = (frame.id & CAN_EFF_MASK) | CAN_EFF_FLAG;
+    can.can_dlc = frame.dlc > CAN_MAX_DLEN ? CAN_MAX_DLEN : frame.dlc;
+    std::memcpy(can.data, frame.data, can.can_dlc);
+    std::memcpy(out, &can, sizeof(can));
+}
+
+bool SocketCanSink::sendBatch(size_t count, std::chrono::steady_clock::time_point& deadline) {
+    size_t done = 0;
+    while (done < count) {
+        ++send_calls_;
+        const int sent = ::sendmmsg(fd_, batch_->messages + done, static_cast<unsigned>(count - done), MSG_DONTWAIT);
+        if (sent > 0) {
+            done += static_cast<size_t>(sent);
+            sent_ += static_cast<uint64_t>(sent);
+            continue;
+        }
+        const int error = sent < 0 ? errno : EAGAIN;
+        if (error == EINTR) {
+            continue;
+        }
+        if (error != ENOBUFS && error != EAGAIN && error != EWOULDBLOCK) {
+            dropped_ += count - done;
+            throw std::system_error(error, std::generic_category(), "CAN send failed");
+        }
+
+        // TX queue full: give the bus up to the send timeout to drain, then shed the rest
+        if (deadline == std::chrono::steady_clock::time_point{}) {
+            deadline = std::chrono::steady_clock::now() + send_timeout_;
+            ++backpressure_;
+        }
+        if (std::chrono::steady_clock::now() >= deadline) {
+            dropped_ += count - done;
+            return false;
+        }
+        waitForRoom(error);
+    }
+    return true;
+}
+
+void SocketCanSink::waitForRoom(int error) {
+    if (error == ENOBUFS) {
+        // The device queue is full; poll() cannot see that, so back off briefly
+        std::this_thread::sleep_for(std::chrono::microseconds(50));
+    } else {
+        pollfd pfd{fd_, POLLOUT, 0};
+        ::poll(&pfd, 1, 1);
+    }
+}
+
+#else
+
+struct SocketCanSink::Batch {};
+
+SocketCanSink::SocketCanSink(const std::string&, std::chrono::milliseconds send_timeout)
+    : fd_(-1)
+    , send_timeout_(send_timeout)
+{
+    throw std::runtime_error("SocketCAN is only available on Linux");
+}
+
+SocketCanSink::SocketCanSink(int, std::chrono::milliseconds send_timeout)
+    : fd_(-1)
+    , send_timeout_(send_timeout)
+{
+    throw std::runtime_error("SocketCAN is only available on Linux");
+}
+
+SocketCanSink::~SocketCanSink() = default;
+void SocketCanSink::write(const Frame*, size_t) {}
+void SocketCanSink::toCanFrame(const Frame&, uint8_t*) {}
+void SocketCanSink::dropRest(const Frame*, size_t) {}
+bool SocketCanSink::sendBatch(size_t, std::chrono::steady_clock::time_point&) { return false; }
+void SocketCanSink::waitForRoom(int) {}
+
+#endif
+
+} // namespace serial_bus_generator
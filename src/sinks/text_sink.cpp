@@ -0,0 +1,67 @@
+#include "serial_bus_generator/sinks/text_sink.hpp"
+#include "serial_bus_generator/protocols/arinc429/arinc429_message.hpp"
+#include "serial_bus_generator/protocols/canj1939/canj1939_message.hpp"
+#include "serial_bus_generator/trace/tracer.hpp"
+#include <stdexcept>
+
+namespace serial_bus_generator {
+
+TextSink::TextSink(std::FILE* out)
+    : out_(out)
+    , text_(FLUSH_THRESHOLD + 1024)
+{
+    if (!out_) {
+        throw std::invalid_argument("Null output stream");
+    }
+}
+
+TextSink::~TextSink() {
+    flush();
+}
+
+void TextSink::write(const Frame* frames, size_t count) {
+    SBG_TRACE_SCOPE("format", count > 0 ? frames[0].channel : Tracer::NO_CHANNEL);
+    for (size_t i = 0; i < count; ++i) {
+        formatFrame(frames[i], text_);
+        text_.append('\n');
+        if (text_.size() >= FLUSH_THRESHOLD) {
+            writeOut();
+        }
+    }
+}
+
+void TextSink::flush() {
+    writeOut();
+    std::fflush(out_);
+}
+
+void TextSink::formatFrame(const Frame& frame, TextBuffer& out) {
+    switch (frame.type) {
+        case MessageType::ARINC429:
+            out.append("[ARINC429] ");
+            ARINC429Message(frame).formatTo(out);
+            break;
+        case MessageType::CANJ1939:
+            out.append("[CANJ1939] ");
+            if (frame.dlc != 8) {
+                // Injected length faults cannot be decoded; show what went out
+                out.append("Malformed frame: ID=0x");
+                out.appendHex(frame.id);
+                out.append(" DLC=");
+                out.appendInt(frame.dlc);
+                break;
+            }
+            CANJ1939Message(frame).formatTo(out);
+            break;
+    }
+}
+
+void TextSink::writeOut() {
+    if (!text_.empty()) {
+        SBG_TRACE_SCOPE("text write", Tracer::NO_CHANNEL);
+        std::fwrite(text_.data(), 1, text_.size(), out_);
+        text_.clear();
+    }
+}
+
+} // namespace serial_bus_generator
@@ -0,0 +1,231 @@
+#include "serial_bus_generator/trace/tracer.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace serial_bus_generator {
+
+namespace {
+
+// Written only by its thread; read by dumps once that thread is idle
+struct ThreadBuffer {
+    ThreadBuffer(size_t capacity, size_t thread_id)
+        : events(new TraceEvent[capacity])
+        , mask(capacity - 1)
+        , id(thread_id)
+    {}
+
+    void push(const TraceEvent& event) {
+        const uint64_t index = head.load(std::memory_order_relaxed);
+        events[index & mask] = event;
+        head.store(index + 1, std::memory_order_release);
+    }
+
+    size_t size() const {
+        return static_cast<size_t>(std::min<uint64_t>(head.load(std::memory_order_acquire), mask + 1));
+    }
+
+    std::unique_ptr<TraceEvent[]> events;
+    const uint64_t mask;
+    const size_t id;
+    std::atomic<uint64_t> head{0};
+};
+
+// A trace clock reading and the steady clock at the same moment
+struct ClockPoint {
+    uint64_t ticks{0};
+    int64_t ns{0};
+
+    static ClockPoint now() {
+        return ClockPoint{Tracer::now(), std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count()};
+    }
+};
+
+// Calibration points closer than this are waited out before writing a trace
+constexpr std::chrono::milliseconds MIN_CALIBRATION{10};
+
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+    size_t events_per_thread{Tracer::DEFAULT_EVENTS_PER_THREAD};
+    ClockPoint calibration;  // Taken when tracing is first enabled
+};
+
+Registry& registry() {
+    static Registry instance;
+    return instance;
+}
+
+size_t roundUp(size_t events) {
+    size_t rounded = 1;
+    while (rounded < events) {
+        rounded <<= 1;
+    }
+    return rounded;
+}
+
+ThreadBuffer& threadBuffer() {
+    thread_local ThreadBuffer* buffer = nullptr;
+    if (!buffer) {
+        Registry& shared = registry();
+        std::lock_guard<std::mutex> lock(shared.mutex);
+        shared.buffers.push_back(std::make_unique<ThreadBuffer>(shared.events_per_thread, shared.buffers.size()));
+        buffer = shared.buffers.back().get();
+    }
+    return *buffer;
+}
+
+void writeMicroseconds(std::ostream& out, double ticks, double ns_per_tick) {
+    const uint64_t ns = static_cast<uint64_t>(ticks * ns_per_tick + 0.5);
+    char text[32];
+    std::snprintf(text, sizeof(text), "%llu.%03u", static_cast<unsigned long long>(ns / 1000),
+                  static_cast<unsigned>(ns % 1000));
+    out << text;
+}
+
+} // namespace
+
+std::atomic<bool> Tracer::enabled_{false};
+
+void Tracer::setEnabled(bool enabled) {
+    if (enabled) {
+        Registry& shared = registry();
+        std::lock_guard<std::mutex> lock(shared.mutex);
+        if (shared.calibration.ticks == 0) {
+            shared.calibration = ClockPoint::now();
+        }
+    }
+    enabled_.store(enabled, std::memory_order_relaxed);
+}
+
+void Tracer::setEventsPerThread(size_t events) {
+    if (events == 0) {
+        throw std::invalid_argument("Trace rings need room for at least one event");
+    }
+    Registry& shared = registry();
+    std::lock_guard<std::mutex> lock(shared.mutex);
+    shared.events_per_thread = roundUp(events);
+}
+
+void Tracer::recordScope(const char* name, uint16_t channel, uint64_t start) {
+    threadBuffer().push(TraceEvent{start, now() - start, name, nullptr, NO_VALUE, channel, false});
+}
+
+void Tracer::recordInstant(const char* name, uint16_t channel, const char* detail, int64_t value) {
+    threadBuffer().push(TraceEvent{now(), 0, name, detail, value, channel, true});
+}
+
+void Tracer::clear() {
+    Registry& shared = registry();
+    std::lock_guard<std::mutex> lock(shared.mutex);
+    for (auto& buffer : shared.buffers) {
+        buffer->head.store(0, std::memory_order_relaxed);
+    }
+}
+
+size_t Tracer::getEventCount() {
+    Registry& shared = registry();
+    std::lock_guard<std::mutex> lock(shared.mutex);
+    size_t count = 0;
+    for (const auto& buffer : shared.buffers) {
+        count += buffer->size();
+    }
+    return count;
+}
+
+uint64_t Tracer::getOverwrittenEvents() {
+    Registry& shared = registry();
+    std::lock_guard<std::mutex> lock(shared.mutex);
+    uint64_t overwritten = 0;
+    for (const auto& buffer : shared.buffers) {
+        overwritten += buffer->head.load(std::memory_order_acquire) - buffer->size();
+    }
+    return overwritten;
+}
+
+void Tracer::writeChromeJson(std::ostream& out) {
+    Registry& shared = registry();
+    std::lock_guard<std::mutex> lock(shared.mutex);
+
+    // Rate of the trace clock over the whole time tracing has been on
+    double ns_per_tick = 1.0;
+    if (shared.calibration.ticks != 0) {
+        ClockPoint end = ClockPoint::now();
+        const int64_t min_ns = std::chrono::nanoseconds(MIN_CALIBRATION).count();
+        if (end.ns - shared.calibration.ns < min_ns) {
+            std::this_thread::sleep_for(std::chrono::nanoseconds(min_ns - (end.ns - shared.calibration.ns)));
+            end = ClockPoint::now();
+        }
+        if (end.ticks > shared.calibration.ticks) {
+            ns_per_tick = static_cast<double>(end.ns - shared.calibration.ns) /
+                          static_cast<double>(end.ticks - shared.calibration.ticks);
+        }
+    }
+
+    // Times are shown from the earliest event kept
+    uint64_t origin = UINT64_MAX;
+    for (const auto& buffer : shared.buffers) {
+        const uint64_t head = buffer->head.load(std::memory_order_acquire);
+        for (uint64_t i = head - buffer->size(); i < head; ++i) {
+            origin = std::min(origin, buffer->events[i & buffer->mask].start);
+        }
+    }
+
+    out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    const char* separator = "\n";
+    for (const auto& buffer : shared.buffers) {
+        const uint64_t head = buffer->head.load(std::memory_order_acquire);
+        if (head == 0) {
+            continue;
+        }
+        out << separator << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->id
+            << ",\"args\":{\"name\":\"thread " << buffer->id << "\"}}";
+        separator = ",\n";
+        for (uint64_t i = head - buffer->size(); i < head; ++i) {
+            const TraceEvent& event = buffer->events[i & buffer->mask];
+            out << ",\n{\"name\":\"" << event.name << "\",\"cat\":\"sbg\",\"ph\":\""
+                << (event.instant ? "i\",\"s\":\"t" : "X") << "\",\"pid\":1,\"tid\":" << buffer->id
+                << ",\"ts\":";
+            writeMicroseconds(out, static_cast<double>(event.start - origin), ns_per_tick);
+            if (!event.instant) {
+                out << ",\"dur\":";
+                writeMicroseconds(out, static_cast<double>(event.duration), ns_per_tick);
+            }
+            out << ",\"args\":{";
+            const char* arg_separator = "";
+            if (event.channel != NO_CHANNEL) {
+                out << "\"channel\":" << event.channel;
+                arg_separator = ",";
+            }
+            if (event.detail) {
+                out << arg_separator << "\"detail\":\"" << event.detail << '"';
+                arg_separator = ",";
+            }
+            if (event.value != NO_VALUE) {
+                out << arg_separator << "\"value\":" << event.value;
+            }
+            out << "}}";
+        }
+    }
+    out << "\n]}\n";
+}
+
+void Tracer::writeChromeJson(const std::string& path) {
+    std::ofstream file(path, std::ios::trunc);
+    if (!file) {
+        throw std::runtime_error("Cannot open trace file " + path);
+    }
+    writeChromeJson(file);
+    if (!file.flush()) {
+        throw std::runtime_error("Cannot write trace file " + path);
+    }
+}
+
+} // namespace serial_bus_generator
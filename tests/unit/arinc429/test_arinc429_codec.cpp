@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+#include "serial_bus_generator/protocols/arinc429/arinc429_codec.hpp"
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace serial_bus_generator;
+
+class ARINC429CodecTest : public ::testing::TestWithParam<ARINC429BatchCodec::Kernel> {
+protected:
+    void SetUp() override {
+        if (!ARINC429BatchCodec::isSupported(GetParam())) {
+            GTEST_SKIP() << "Kernel not supported on this CPU";
+        }
+
+        const ARINC429Label all_labels[] = {
+            ARINC429Label::LATITUDE, ARINC429Label::LONGITUDE, ARINC429Label::ALTITUDE,
+            ARINC429Label::GROUND_SPEED, ARINC429Label::TRACK_HEADING, ARINC429Label::VERTICAL_SPEED,
+            ARINC429Label::EQUIPMENT_STATUS, ARINC429Label::NAVIGATION_MODE,
+            ARINC429Label::GPS_SATELLITE_STATUS, ARINC429Label::SYSTEM_CONFIG
+        };
+        std::mt19937 rng(42);
+        std::uniform_int_distribution<int> pick(0, 9);
+        std::uniform_int_distribution<int> ssm(0, 3);
+        std::uniform_real_distribution<float> value(-200.0f, 40000.0f);
+
+        // Odd count so every kernel also runs its scalar tail
+        for (size_t i = 0; i < COUNT; ++i) {
+            labels.push_back(all_labels[pick(rng)]);
+            values.push_back(value(rng));
+            ssms.push_back(static_cast<ARINC429SSM>(ssm(rng)));
+        }
+        values[3] = -0.0f;
+        values[5] = 1e12f;  // Clamped to the label range
+        values[9] = std::numeric_limits<float>::quiet_NaN();
+    }
+
+    static constexpr size_t COUNT = 1003;
+    std::vector<ARINC429Label> labels;
+    std::vector<float> values;
+    std::vector<ARINC429SSM> ssms;
+};
+
+TEST_P(ARINC429CodecTest, EncodeMatchesMessage) {
+    ARINC429BatchCodec codec(GetParam());
+    std::vector<uint32_t> words(COUNT);
+    codec.encode(labels.data(), values.data(), ssms.data(), words.data(), COUNT);
+
+    for (size_t i = 0; i < COUNT; ++i) {
+        ARINC429Message message(labels[i], values[i], ssms[i]);
+        ASSERT_EQ(words[i], message.getRawWord()) << "word " << i;
+    }
+}
+
+TEST_P(ARINC429CodecTest, DecodeMatchesMessage) {
+    ARINC429BatchCodec codec(GetParam());
+    std::vector<uint32_t> words(COUNT);
+    std::vector<float> decoded(COUNT);
+    codec.encode(labels.data(), values.data(), ssms.data(), words.data(), COUNT);
+    words[7] = (words[7] & ~0xFFu) | 0x01;  // Unrecognised label field
+
+    EXPECT_EQ(codec.decode(words.data(), decoded.data(), COUNT), 1u);
+    EXPECT_TRUE(std::isnan(decoded[7]));
+    for (size_t i = 0; i < COUNT; ++i) {
+        if (i == 7) continue;
+        Frame frame;
+        frame.id = words[i];
+        float expected = ARINC429Message(frame).getDecodedValue();
+        ASSERT_EQ(std::memcmp(&decoded[i], &expected, sizeof(float)), 0) << "word " << i;
+    }
+}
+
+TEST_P(ARINC429CodecTest, VerifiesParity) {
+    ARINC429BatchCodec codec(GetParam());
+    std::vector<uint32_t> words(COUNT);
+    std::vector<uint8_t> valid(COUNT);
+    codec.encode(labels.data(), values.data(), ssms.data(), words.data(), COUNT);
+    for (size_t i = 0; i < COUNT; i += 10) {
+        words[i] ^= 1u << (i % 32);
+    }
+
+    size_t failed = codec.verifyParity(words.data(), valid.data(), COUNT);
+    EXPECT_EQ(failed, (COUNT + 9) / 10);
+    for (size_t i = 0; i < COUNT; ++i) {
+        EXPECT_EQ(valid[i], i % 10 == 0 ? 0 : 1) << "word " << i;
+    }
+}
+
+TEST_P(ARINC429CodecTest, RejectsInvalidLabel) {
+    ARINC429BatchCodec codec(GetParam());
+    std::vector<uint32_t> words(COUNT, 0xDEADBEEF);
+    labels[100] = static_cast<ARINC429Label>(54);  // Label field of LATITUDE, but not a label
+
+    EXPECT_THROW(codec.encode(labels.data(), values.data(), ssms.data(), words.data(), COUNT),
+                 MessageValidationError);
+    EXPECT_EQ(words[0], 0xDEADBEEF);
+}
+
+INSTANTIATE_TEST_SUITE_P(Kernels, ARINC429CodecTest,
+    ::testing::Values(ARINC429BatchCodec::Kernel::SCALAR,
+                      ARINC429BatchCodec::Kernel::SSE41,
+                      ARINC429BatchCodec::Kernel::AVX2));
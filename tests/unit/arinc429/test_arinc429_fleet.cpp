@@ -0,0 +1,163 @@
+#include <gtest/gtest.h>
+#include "serial_bus_generator/protocols/arinc429/arinc429_fleet.hpp"
+#include <chrono>
+#include <map>
+#include <set>
+#include <thread>
+
+using namespace serial_bus_generator;
+using namespace std::chrono_literals;
+
+TEST(ARINC429FleetTest, OneChannelPerAircraft) {
+    ARINC429Generator generator;
+    generator.setChannel(100);
+    generator.setFleetSize(250);
+    EXPECT_EQ(generator.getFleetSize(), 250u);
+
+    FrameBatch batch;
+    generator.generateFrames(1000ms, batch);
+
+    std::map<ARINC429Label, std::set<uint16_t>> channels;
+    for (const Frame& frame : batch) {
+        ARINC429Message message(frame);
+        EXPECT_TRUE(message.verifyParity());
+        channels[message.getLabel()].insert(frame.channel);
+    }
+    ASSERT_EQ(channels.size(), 5u);
+    for (const auto& entry : channels) {
+        EXPECT_EQ(entry.second.size(), 250u);
+        EXPECT_EQ(*entry.second.begin(), 100u);
+        EXPECT_EQ(*entry.second.rbegin(), 349u);
+    }
+}
+
+TEST(ARINC429FleetTest, WordsCarryEachAircraftsState) {
+    ARINC429Fleet fleet(64, CounterRng(1), 0);
+    fleet.update(10s);
+
+    FrameBatch batch;
+    fleet.appendLabel(ARINC429Label::ALTITUDE, 0, 0, batch);
+    ASSERT_EQ(batch.size(), 64u);
+    for (size_t i = 0; i < batch.size(); ++i) {
+        EXPECT_NEAR(ARINC429Message(batch[i]).getDecodedValue(), fleet.getAltitude(i), 0.125);
+    }
+
+    batch.clear();
+    fleet.appendLabel(ARINC429Label::LATITUDE, 0, 0, batch);
+    std::set<float> latitudes;
+    for (size_t i = 0; i < batch.size(); ++i) {
+        const float decoded = ARINC429Message(batch[i]).getDecodedValue();
+        EXPECT_NEAR(decoded, fleet.getLatitude(i), 180.0 / 262144.0);
+        latitudes.insert(decoded);
+    }
+    EXPECT_GT(latitudes.size(), 32u) << "Aircraft should not fly in lockstep";
+
+    EXPECT_THROW(fleet.appendLabel(ARINC429Label::SYSTEM_CONFIG, 0, 0, batch), std::invalid_argument);
+}
+
+TEST(ARINC429FleetTest, AircraftCycleThroughPhases) {
+    ARINC429Fleet fleet(200, CounterRng(7), 0);
+    std::vector<std::set<FlightPhase>> seen(fleet.size());
+    // One full flight and turnaround plus margin, in 1 s steps
+    for (int tick = 0; tick < 20000; ++tick) {
+        fleet.update(1s);
+        for (size_t i = 0; i < fleet.size(); ++i) {
+            seen[i].insert(fleet.getPhase(i));
+            ASSERT_GE(fleet.getAltitude(i), 0.0);
+            ASSERT_LE(fleet.getAltitude(i), ARINC429Generator::CRUISE_ALTITUDE);
+            ASSERT_LE(fleet.getGroundSpeed(i), ARINC429Generator::CRUISE_SPEED);
+            ASSERT_GE(fleet.getLatitude(i), -90.0);
+            ASSERT_LE(fleet.getLatitude(i), 90.0);
+        }
+    }
+    for (const auto& phases : seen) {
+        EXPECT_EQ(phases.size(), 4u);
+    }
+}
+
+TEST(ARINC429FleetTest, TenThousandAircraftFasterThanRealTime) {
+    ARINC429Generator generator;
+    generator.setFleetSize(10000);
+
+    // 20 Hz for 5 simulated seconds
+    FrameBatch batch;
+    size_t frames = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int tick = 0; tick < 100; ++tick) {
+        batch.clear();
+        generator.generateFrames(50ms, batch);
+        frames += batch.size();
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    EXPECT_GT(frames, 10000u * 5 * 20);
+    EXPECT_LT(elapsed, 5s);
+}
+
+TEST(ARINC429FleetTest, FleetSizeLimits) {
+    ARINC429Generator generator;
+    generator.setChannel(1);
+    EXPECT_THROW(generator.setFleetSize(ARINC429Fleet::MAX_AIRCRAFT), std::invalid_argument);
+    EXPECT_NO_THROW(generator.setFleetSize(ARINC429Fleet::MAX_AIRCRAFT - 1));
+    EXPECT_NO_THROW(generator.setFleetSize(0));
+    EXPECT_EQ(generator.getFleet(), nullptr);
+
+    generator.setFleetSize(10);
+    generator.setFrameBufferCapacity(1 << 16);
+    generator.start();
+    EXPECT_THROW(generator.setFleetSize(20), std::logic_error);
+    std::this_thread::sleep_for(20ms);
+    generator.stop();
+    EXPECT_EQ(generator.getFleetSize(), 10u);
+}
+
+TEST(ARINC429FleetTest, SeedAndChannelDetermineLayout) {
+    const CounterRng rng(1234);
+    ARINC429Fleet first(100, rng, 0);
+    ARINC429Fleet second(100, rng, 0);
+    ARINC429Fleet other_channel(100, rng, 1);
+    ARINC429Fleet other_seed(100, CounterRng(1235), 0);
+    for (int tick = 0; tick < 100; ++tick) {
+        first.update(50ms);
+        second.update(50ms);
+    }
+    for (int tick = 0; tick < 100; ++tick) {
+        second.update(0ms);  // Extra empty ticks must not disturb anything
+    }
+
+    size_t same_channel = 0;
+    size_t same_seed = 0;
+    for (size_t i = 0; i < first.size(); ++i) {
+        EXPECT_EQ(first.getLatitude(i), second.getLatitude(i));
+        EXPECT_EQ(first.getAltitude(i), second.getAltitude(i));
+        same_channel += first.getPhase(i) == other_channel.getPhase(i) &&
+                        first.getLatitude(i) == other_channel.getLatitude(i);
+        same_seed += first.getPhase(i) == other_seed.getPhase(i) &&
+                     first.getLatitude(i) == other_seed.getLatitude(i);
+    }
+    EXPECT_EQ(same_channel, 0u);
+    EXPECT_EQ(same_seed, 0u);
+}
+
+TEST(ARINC429FleetTest, GeneratorLaysOutFleetAgainForNewSeed) {
+    ARINC429Generator generator;
+    generator.setSeed(5);
+    generator.setFleetSize(20);
+    const double latitude = generator.getFleet()->getLatitude(0);
+
+    generator.setSeed(6);
+    generator.setVirtualDuration(100ms);
+    generator.setClockMode(ClockMode::VIRTUAL);
+    generator.setFrameBufferCapacity(1 << 16);
+    generator.start();
+    while (generator.getState() == GeneratorState::RUNNING) {
+        std::this_thread::sleep_for(1ms);
+    }
+    generator.stop();
+    EXPECT_NE(generator.getFleet()->getLatitude(0), latitude);
+
+    ARINC429Generator replay;
+    replay.setSeed(6);
+    replay.setFleetSize(20);
+    EXPECT_NEAR(replay.getFleet()->getLatitude(0), generator.getFleet()->getLatitude(0), 0.1);
+}
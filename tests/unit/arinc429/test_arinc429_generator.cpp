@@ -2,6 +2,7 @@
 #include "serial_bus_generator/protocols/arinc429/arinc429_generator.hpp"
 #include <thread>
 #include <chrono>
+#include <map>
 
 using namespace serial_bus_generator;
 using namespace std::chrono_literals;
@@ -56,4 +57,97 @@ TEST_F(ARINC429GeneratorTest, MessageConsistency) {
             last_lat = lat;
         }
     }
-}
\ No newline at end of file
+}
+
+TEST_F(ARINC429GeneratorTest, SubMillisecondRates) {
+    EXPECT_NO_THROW(generator->setRate(DataGenerator::MAX_RATE));
+    EXPECT_THROW(generator->setRate(DataGenerator::MAX_RATE + 1), std::invalid_argument);
+    EXPECT_THROW(generator->setRate(0), std::invalid_argument);
+
+    generator->setRate(20000);  // 50us period
+    generator->start();
+    std::this_thread::sleep_for(100ms);
+    generator->setRate(500);    // Rate change while running
+    std::this_thread::sleep_for(20ms);
+    generator->stop();
+
+    EXPECT_GT(generator->getTickCount(), 100u);
+}
+
+TEST_F(ARINC429GeneratorTest, PerLabelRates) {
+    std::map<ARINC429Label, int> counts;
+    for (int tick = 0; tick < 100; ++tick) {  // 1s at 100 Hz
+        for (const auto& msg : generator->generateMessages(tick == 0 ? 0ms : 10ms)) {
+            counts[static_cast<const ARINC429Message*>(msg.get())->getLabel()]++;
+        }
+    }
+
+    EXPECT_EQ(counts[ARINC429Label::LATITUDE], 5);
+    EXPECT_EQ(counts[ARINC429Label::ALTITUDE], 20);
+    EXPECT_EQ(counts[ARINC429Label::EQUIPMENT_STATUS], 1);
+}
+
+TEST_F(ARINC429GeneratorTest, LabelPeriodsChangeOnlyWhileStopped) {
+    generator->start();
+    EXPECT_THROW(generator->setLabelPeriod(ARINC429Label::ALTITUDE, 20ms), std::logic_error);
+    generator->stop();
+    EXPECT_NO_THROW(generator->setLabelPeriod(ARINC429Label::ALTITUDE, 20ms));
+}
+
+TEST_F(ARINC429GeneratorTest, VirtualClockFastForward) {
+    // Full takeoff/cruise/landing profile of the first leg
+    const auto flight = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::duration<double>(generator->getTrajectory().getDuration() + 1));
+    const uint64_t epoch = 1700000000ull * 1000000000ull;
+
+    generator->setRate(100);
+    generator->setClockMode(ClockMode::VIRTUAL);
+    generator->setVirtualDuration(flight);
+    generator->setVirtualEpoch(epoch);
+    generator->setFrameBufferCapacity(1 << 20);
+
+    auto wall_start = std::chrono::steady_clock::now();
+    generator->start();
+    while (generator->getState() == GeneratorState::RUNNING) {
+        std::this_thread::sleep_for(1ms);
+    }
+    generator->stop();
+    auto wall_time = std::chrono::steady_clock::now() - wall_start;
+
+    EXPECT_LT(wall_time, 30s) << "Virtual run should be far faster than real time";
+    EXPECT_GE(generator->getElapsedTime(), flight);
+    EXPECT_EQ(generator->current_phase_, FlightPhase::STOPPED);
+    EXPECT_NEAR(generator->getFlightState().latitude, ARINC429Generator::END_POINT.latitude, 1e-6);
+    EXPECT_NEAR(generator->getFlightState().longitude, ARINC429Generator::END_POINT.longitude, 1e-6);
+    EXPECT_EQ(generator->getOverrunCount(), 0u);
+
+    // Frame timestamps follow the virtual timeline
+    std::vector<Frame> frames(generator->getQueuedFrames());
+    ASSERT_EQ(generator->drainFrames(frames.data(), frames.size()), frames.size());
+    ASSERT_FALSE(frames.empty());
+    EXPECT_EQ(frames.front().timestamp_ns, epoch);
+    EXPECT_GE(frames.back().timestamp_ns - epoch, static_cast<uint64_t>(flight.count()) - 100000000u);
+}
+
+
+TEST_F(ARINC429GeneratorTest, GenerateFramesReusesBatch) {
+    FrameBatch batch;
+    generator->generateFrames(1000ms, batch);
+    ASSERT_FALSE(batch.empty());
+    for (const Frame& frame : batch) {
+        EXPECT_EQ(frame.type, MessageType::ARINC429);
+        EXPECT_EQ(frame.dlc, 4);
+        EXPECT_TRUE(ARINC429Message(frame).verifyParity());
+    }
+
+    // Once grown, the caller's buffer is reused rather than reallocated
+    const Frame* storage = batch.data();
+    const size_t capacity = batch.capacity();
+    for (int tick = 0; tick < 1000; ++tick) {
+        batch.clear();
+        generator->generateFrames(10ms, batch);
+        EXPECT_LE(batch.size(), capacity);
+    }
+    EXPECT_EQ(batch.data(), storage);
+    EXPECT_EQ(batch.capacity(), capacity);
+}
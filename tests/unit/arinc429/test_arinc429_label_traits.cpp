@@ -0,0 +1,61 @@
+#include <gtest/gtest.h>
+#include "serial_bus_generator/protocols/arinc429/arinc429_label_traits.hpp"
+
+using namespace serial_bus_generator;
+
+TEST(ARINC429LabelTraitsTest, EveryLabelRoundTrips) {
+    for (const ARINC429LabelSpec& spec : ARINC429_LABEL_SPECS) {
+        const float values[] = {spec.min_value, spec.max_value, (spec.min_value + spec.max_value) / 2};
+        for (float value : values) {
+            ARINC429Message message(spec.label, value, ARINC429SSM::NORMAL_OPERATION);
+            ASSERT_TRUE(message.isValid());
+
+            Frame frame = message.toFrame();
+            ARINC429Message decoded(frame);
+            EXPECT_EQ(decoded.getLabel(), spec.label);
+            // Truncation toward zero loses at most one step
+            EXPECT_NEAR(decoded.getDecodedValue(), value, spec.resolution)
+                << "label " << static_cast<int>(spec.label) << " value " << value;
+        }
+    }
+}
+
+TEST(ARINC429LabelTraitsTest, SignedLabelsDecodeNegativeValues) {
+    ARINC429Message latitude(ARINC429Label::LATITUDE, -33.9425f, ARINC429SSM::NORMAL_OPERATION);
+    EXPECT_NEAR(latitude.getDecodedValue(), -33.9425f, 0.001f);
+
+    ARINC429Message track(ARINC429Label::TRACK_HEADING, -120.5f, ARINC429SSM::NORMAL_OPERATION);
+    EXPECT_NEAR(track.getDecodedValue(), -120.5f, 0.001f);
+
+    ARINC429Message climb(ARINC429Label::VERTICAL_SPEED, -1500.0f, ARINC429SSM::NORMAL_OPERATION);
+    EXPECT_FLOAT_EQ(climb.getDecodedValue(), -1500.0f);
+}
+
+TEST(ARINC429LabelTraitsTest, ClampsToLabelRange) {
+    using Altitude = ARINC429LabelTraits<ARINC429Label::ALTITUDE>;
+    EXPECT_EQ(Altitude::encode(-100.0f), 0u);
+    EXPECT_FLOAT_EQ(Altitude::decode(Altitude::encode(1e9f)), Altitude::SPEC.max_value);
+
+    using Latitude = ARINC429LabelTraits<ARINC429Label::LATITUDE>;
+    EXPECT_FLOAT_EQ(Latitude::decode(Latitude::encode(-95.0f)), -90.0f);
+}
+
+TEST(ARINC429LabelTraitsTest, EncodesBCDDigits) {
+    using Status = ARINC429LabelTraits<ARINC429Label::GPS_SATELLITE_STATUS>;
+    static_assert(Status::SPEC.format == ARINC429Format::BCD, "GPS status is BCD");
+    EXPECT_EQ(Status::encode(1234.0f), 0x01234u);
+    EXPECT_EQ(Status::encode(79999.0f), 0x79999u);
+    EXPECT_FLOAT_EQ(Status::decode(0x00912u), 912.0f);
+}
+
+TEST(ARINC429LabelTraitsTest, DispatchCoversLabelSet) {
+    for (const ARINC429LabelSpec& spec : ARINC429_LABEL_SPECS) {
+        const ARINC429LabelCodec* codec = findLabelCodec(spec.label);
+        ASSERT_NE(codec, nullptr);
+        EXPECT_EQ(codec->spec->label, spec.label);
+    }
+    // Label field 54 belongs to LATITUDE (310) but 54 itself is no label
+    EXPECT_EQ(findLabelCodec(static_cast<ARINC429Label>(54)), nullptr);
+    EXPECT_NE(findWordCodec(54), nullptr);
+    EXPECT_EQ(findWordCodec(0x01), nullptr);
+}
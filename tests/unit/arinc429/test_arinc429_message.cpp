@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include "serial_bus_generator/protocols/arinc429/arinc429_message.hpp"
+#include <cstring>
 #include <vector>
 #include <stdexcept>
 #include <iostream>
@@ -57,4 +58,19 @@ TEST_F(ARINC429MessageTest, Serialization) {
     
     EXPECT_TRUE(position_msg->verifyParity())
         << "Parity check should pass";
-}
\ No newline at end of file
+}
+
+TEST_F(ARINC429MessageTest, EncodeFrameMatchesMessage) {
+    ASSERT_TRUE(position_msg != nullptr);
+    Frame frame = ARINC429Message::encodeFrame(
+        ARINC429Label::LATITUDE, 45.5f, ARINC429SSM::NORMAL_OPERATION, 1234000000);
+    Frame expected = position_msg->toFrame();
+
+    EXPECT_EQ(frame.id, position_msg->getRawWord());
+    EXPECT_EQ(frame.dlc, expected.dlc);
+    EXPECT_EQ(std::memcmp(frame.data, expected.data, sizeof(frame.data)), 0);
+    EXPECT_EQ(frame.timestamp_ns, 1234000000u);
+    EXPECT_THROW(ARINC429Message::encodeFrame(static_cast<ARINC429Label>(1), 0.0f,
+                                              ARINC429SSM::NORMAL_OPERATION, 0),
+                 MessageValidationError);
+}
@@ -0,0 +1,148 @@
+#include <gtest/gtest.h>
+#include "serial_bus_generator/protocols/arinc429/arinc429_generator.hpp"
+#include "serial_bus_generator/protocols/arinc429/flight_trajectory.hpp"
+#include <cmath>
+
+using namespace serial_bus_generator;
+
+namespace {
+
+const GeoPoint SEATTLE{47.6062, -122.3321};
+const GeoPoint MIAMI{25.7959, -80.2870};
+
+// Haversine distance in nautical miles
+double distanceNm(const GeoPoint& a, const GeoPoint& b) {
+    const double rad = M_PI / 180.0;
+    const double dlat = (b.latitude - a.latitude) * rad;
+    const double dlon = (b.longitude - a.longitude) * rad;
+    const double h = std::sin(dlat / 2) * std::sin(dlat / 2) +
+                     std::cos(a.latitude * rad) * std::cos(b.latitude * rad) * std::sin(dlon / 2) * std::sin(dlon / 2);
+    return 2.0 * std::asin(std::sqrt(h)) * FlightTrajectory::EARTH_RADIUS_NM;
+}
+
+// Classic initial-bearing formula, degrees 0 to 360
+double initialBearing(const GeoPoint& a, const GeoPoint& b) {
+    const double rad = M_PI / 180.0;
+    const double dlon = (b.longitude - a.longitude) * rad;
+    const double y = std::sin(dlon) * std::cos(b.latitude * rad);
+    const double x = std::cos(a.latitude * rad) * std::sin(b.latitude * rad) -
+                     std::sin(a.latitude * rad) * std::cos(b.latitude * rad) * std::cos(dlon);
+    return std::fmod(std::atan2(y, x) / rad + 360.0, 360.0);
+}
+
+GeoPoint position(const FlightTrajectory::State& state) {
+    return {state.latitude, state.longitude};
+}
+
+} // namespace
+
+TEST(FlightTrajectoryTest, FliesTheGreatCircleToTheDestination) {
+    const FlightTrajectory trajectory(SEATTLE, MIAMI, ARINC429Generator::flightProfile());
+    EXPECT_NEAR(trajectory.getDistance(), distanceNm(SEATTLE, MIAMI), 0.01);
+    EXPECT_NEAR(trajectory.getDistance(), 2370.0, 10.0);
+
+    // Accelerate, hold cruise speed, slow down: cruise time plus one ramp
+    const double ramp = ARINC429Generator::CRUISE_SPEED / ARINC429Generator::ACCELERATION;
+    EXPECT_NEAR(trajectory.getDuration(),
+                trajectory.getDistance() / ARINC429Generator::CRUISE_SPEED * 3600.0 + ramp, 1e-6);
+
+    const FlightTrajectory::State departure = trajectory.stateAt(0.0);
+    EXPECT_NEAR(departure.latitude, SEATTLE.latitude, 1e-9);
+    EXPECT_NEAR(departure.longitude, SEATTLE.longitude, 1e-9);
+    EXPECT_EQ(departure.phase, FlightPhase::TAKEOFF);
+    EXPECT_NEAR(departure.track, initialBearing(SEATTLE, MIAMI), 1e-6);
+
+    const FlightTrajectory::State arrival = trajectory.stateAt(trajectory.getDuration());
+    EXPECT_DOUBLE_EQ(arrival.latitude, MIAMI.latitude);
+    EXPECT_DOUBLE_EQ(arrival.longitude, MIAMI.longitude);
+    EXPECT_EQ(arrival.altitude, 0.0);
+    EXPECT_EQ(arrival.ground_speed, 0.0);
+    EXPECT_EQ(arrival.phase, FlightPhase::STOPPED);
+
+    // Along the route, distance flown plus distance left is the route length,
+    // which only holds on the great circle, and the track keeps pointing at
+    // the destination
+    for (int step = 1; step < 10; ++step) {
+        const double fraction = step / 10.0;
+        const FlightTrajectory::State state = trajectory.stateAt(fraction * trajectory.getDuration());
+        const GeoPoint here = position(state);
+        EXPECT_NEAR(distanceNm(SEATTLE, here) + distanceNm(here, MIAMI), trajectory.getDistance(), 0.5)
+            << "at " << fraction;
+        EXPECT_NEAR(state.track, initialBearing(here, MIAMI), 0.5) << "at " << fraction;
+    }
+}
+
+TEST(FlightTrajectoryTest, ClimbCruiseDescentProfile) {
+    const FlightProfile profile = ARINC429Generator::flightProfile();
+    const FlightTrajectory trajectory(SEATTLE, MIAMI, profile);
+    const double climb_time = profile.cruise_altitude / profile.climb_rate * 60.0;
+
+    const FlightTrajectory::State climbing = trajectory.stateAt(climb_time / 2);
+    EXPECT_EQ(climbing.phase, FlightPhase::TAKEOFF);
+    EXPECT_NEAR(climbing.altitude, profile.cruise_altitude / 2, 1e-6);
+    EXPECT_NEAR(climbing.vertical_speed, profile.climb_rate, 1e-6);
+    EXPECT_NEAR(climbing.ground_speed, profile.cruise_speed, 1e-6);
+
+    const FlightTrajectory::State cruising = trajectory.stateAt(trajectory.getDuration() / 2);
+    EXPECT_EQ(cruising.phase, FlightPhase::CRUISE);
+    EXPECT_NEAR(cruising.altitude, profile.cruise_altitude, 1e-6);
+    EXPECT_NEAR(cruising.vertical_speed, 0.0, 1e-9);
+
+    const FlightTrajectory::State descending = trajectory.stateAt(trajectory.getDuration() - climb_time / 2);
+    EXPECT_EQ(descending.phase, FlightPhase::LANDING);
+    EXPECT_NEAR(descending.altitude, profile.cruise_altitude / 2, 1e-6);
+    EXPECT_NEAR(descending.vertical_speed, -profile.descent_rate, 1e-6);
+}
+
+TEST(FlightTrajectoryTest, ShortRoutesPeakBelowCruise) {
+    const FlightProfile profile = ARINC429Generator::flightProfile();
+    const FlightTrajectory hop(SEATTLE, {47.4, -122.0}, profile);  // About 17 nm
+    double peak = 0.0;
+    for (double t = 0.0; t < hop.getDuration(); t += 1.0) {
+        peak = std::max(peak, hop.stateAt(t).altitude);
+    }
+    EXPECT_GT(peak, 0.0);
+    EXPECT_LT(peak, profile.cruise_altitude);
+    EXPECT_EQ(hop.stateAt(hop.getDuration()).altitude, 0.0);
+}
+
+TEST(FlightTrajectoryTest, CursorMatchesRandomAccess) {
+    const FlightTrajectory trajectory(MIAMI, SEATTLE, ARINC429Generator::flightProfile());
+    FlightTrajectory::Cursor cursor(trajectory);
+    while (!cursor.isFinished()) {
+        cursor.advance(0.05);  // 20 Hz
+        const FlightTrajectory::State expected = trajectory.stateAt(cursor.getTime());
+        ASSERT_NEAR(cursor.getState().latitude, expected.latitude, 1e-6) << cursor.getTime();
+        ASSERT_NEAR(cursor.getState().longitude, expected.longitude, 1e-6) << cursor.getTime();
+        ASSERT_NEAR(cursor.getState().altitude, expected.altitude, 1e-3) << cursor.getTime();
+        ASSERT_NEAR(cursor.getState().ground_speed, expected.ground_speed, 1e-3) << cursor.getTime();
+        // Summed steps may land either side of a segment boundary
+        const double t = cursor.getTime();
+        ASSERT_TRUE(cursor.getState().phase == trajectory.stateAt(t - 1e-6).phase ||
+                    cursor.getState().phase == trajectory.stateAt(t + 1e-6).phase) << t;
+    }
+    EXPECT_DOUBLE_EQ(cursor.getState().latitude, SEATTLE.latitude);
+    EXPECT_DOUBLE_EQ(cursor.getState().longitude, SEATTLE.longitude);
+}
+
+TEST(FlightTrajectoryTest, CrossesTheAntimeridian) {
+    const GeoPoint tokyo{35.55, 139.78};
+    const GeoPoint anchorage{61.17, -149.99};
+    const FlightTrajectory trajectory(tokyo, anchorage, ARINC429Generator::flightProfile());
+    FlightTrajectory::Cursor cursor(trajectory);
+    while (!cursor.isFinished()) {
+        cursor.advance(10.0);
+        ASSERT_GE(cursor.getState().longitude, -180.0);
+        ASSERT_LT(cursor.getState().longitude, 180.0);
+        ASSERT_GE(cursor.getState().track, 0.0);
+        ASSERT_LT(cursor.getState().track, 360.0);
+    }
+    EXPECT_NEAR(trajectory.getDistance(), distanceNm(tokyo, anchorage), 0.01);
+}
+
+TEST(FlightTrajectoryTest, RejectsDegenerateRoutes) {
+    const FlightProfile profile = ARINC429Generator::flightProfile();
+    EXPECT_THROW(FlightTrajectory(SEATTLE, SEATTLE, profile), std::invalid_argument);
+    EXPECT_THROW(FlightTrajectory(SEATTLE, MIAMI, FlightProfile{}), std::invalid_argument);
+    EXPECT_THROW(FlightTrajectory(SEATTLE, MIAMI, profile, 0), std::invalid_argument);
+}
@@ -2,6 +2,7 @@
 #include "serial_bus_generator/protocols/canj1939/canj1939_generator.hpp"
 #include <thread>
 #include <chrono>
+#include <cstring>
 
 using namespace serial_bus_generator;
 using namespace std::chrono_literals;
@@ -69,4 +70,74 @@ TEST_F(CANJ1939GeneratorTest, EngineParameters) {
     
     EXPECT_TRUE(found_speed) << "No engine speed message found";
     EXPECT_TRUE(found_temp) << "No engine temperature message found";
-}
\ No newline at end of file
+}
+TEST_F(CANJ1939GeneratorTest, DrainsEveryFrameInOrder) {
+    generator->setRate(1000);
+    generator->start();
+    std::this_thread::sleep_for(100ms);
+    generator->stop();
+
+    std::vector<Frame> frames(DataGenerator::DEFAULT_FRAME_BUFFER);
+    size_t count = generator->drainFrames(frames.data(), frames.size());
+    EXPECT_GT(count, 0u);
+    EXPECT_EQ(generator->getOverrunCount(), 0u);
+
+    for (size_t i = 0; i < count; ++i) {
+        EXPECT_EQ(frames[i].type, MessageType::CANJ1939);
+        EXPECT_EQ(frames[i].dlc, 8);
+        if (i > 0) {
+            EXPECT_GE(frames[i].timestamp_ns, frames[i - 1].timestamp_ns);
+        }
+        EXPECT_NO_THROW(CANJ1939Message view(frames[i]));
+    }
+}
+
+TEST_F(CANJ1939GeneratorTest, CountsOverruns) {
+    generator->setFrameBufferCapacity(4);
+    generator->setRate(1000);
+    generator->start();
+    std::this_thread::sleep_for(50ms);
+    generator->stop();
+
+    EXPECT_EQ(generator->getQueuedFrames(), 4u);
+    EXPECT_GT(generator->getOverrunCount(), 0u);
+}
+
+TEST_F(CANJ1939GeneratorTest, PGNPeriodsChangeOnlyWhileStopped) {
+    generator->start();
+    EXPECT_THROW(generator->setPGNPeriod(CANJ1939PGN::ENGINE_SPEED, 20ms), std::logic_error);
+    generator->stop();
+    EXPECT_NO_THROW(generator->setPGNPeriod(CANJ1939PGN::ENGINE_SPEED, 20ms));
+}
+
+TEST_F(CANJ1939GeneratorTest, SeedReproducesEngineNoise) {
+    CANJ1939Generator first;
+    CANJ1939Generator second;
+    CANJ1939Generator other;
+    first.setSeed(42);
+    second.setSeed(42);
+    other.setSeed(43);
+    EXPECT_EQ(first.getSeed(), 42u);
+
+    bool diverged = false;
+    FrameBatch a, b, c;
+    for (int tick = 0; tick < 200; ++tick) {
+        a.clear();
+        b.clear();
+        c.clear();
+        first.generateFrames(10ms, a);
+        second.generateFrames(10ms, b);
+        other.generateFrames(10ms, c);
+        ASSERT_EQ(a.size(), b.size());
+        for (size_t i = 0; i < a.size(); ++i) {
+            EXPECT_EQ(a[i].id, b[i].id);
+            EXPECT_EQ(std::memcmp(a[i].data, b[i].data, sizeof(a[i].data)), 0);
+            diverged |= std::memcmp(a[i].data, c[i].data, sizeof(a[i].data)) != 0;
+        }
+    }
+    EXPECT_TRUE(diverged) << "A different seed should give different engine noise";
+
+    generator->start();
+    EXPECT_THROW(generator->setSeed(1), std::logic_error);
+    generator->stop();
+}
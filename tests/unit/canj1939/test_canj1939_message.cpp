@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include "serial_bus_generator/protocols/canj1939/canj1939_message.hpp"
+#include <cstring>
 #include <vector>
 #include <stdexcept>
 #include <iostream>
@@ -56,4 +57,20 @@ TEST_F(CANJ1939MessageTest, Serialization) {
                     static_cast<uint32_t>(data[0]);
     EXPECT_EQ(pgn, static_cast<uint32_t>(CANJ1939PGN::ENGINE_SPEED))
         << "First three bytes should contain the PGN";
-}
\ No newline at end of file
+}
+
+TEST_F(CANJ1939MessageTest, EncodeFrameMatchesMessage) {
+    ASSERT_TRUE(engine_msg != nullptr);
+    Frame frame = CANJ1939Message::encodeFrame(
+        CANJ1939PGN::ENGINE_SPEED, 1500.0f, CANJ1939Priority::PRIORITY_3, 1234000000);
+    Frame expected = engine_msg->toFrame();
+
+    EXPECT_EQ(frame.id, expected.id);
+    EXPECT_EQ(frame.dlc, 8);
+    EXPECT_EQ(std::memcmp(frame.data, expected.data, sizeof(frame.data)), 0);
+
+    CANJ1939Message view(frame);
+    EXPECT_EQ(view.getPGN(), CANJ1939PGN::ENGINE_SPEED);
+    EXPECT_NEAR(view.getDecodedValue(), 1500.0f, 0.1f);
+    EXPECT_EQ(view.getTimestamp(), 1234u);
+}
@@ -0,0 +1,261 @@
+#include <gtest/gtest.h>
+#include "serial_bus_generator/protocols/canj1939/canj1939_generator.hpp"
+#include "serial_bus_generator/protocols/canj1939/canj1939_transport.hpp"
+#include <map>
+#include <numeric>
+
+using namespace serial_bus_generator;
+using namespace std::chrono_literals;
+
+namespace {
+
+using Scheduler = J1939TransportScheduler;
+
+uint8_t sourceOf(const Frame& frame) { return frame.id & 0xFF; }
+uint8_t destinationOf(const Frame& frame) { return (frame.id >> 8) & 0xFF; }
+
+std::vector<uint8_t> makePayload(size_t size, uint8_t seed = 0) {
+    std::vector<uint8_t> payload(size);
+    std::iota(payload.begin(), payload.end(), seed);
+    return payload;
+}
+
+// Reassembles the transfers in a frame stream the way a receiver would,
+// keyed by source/destination pair
+struct Reassembler {
+    struct Transfer {
+        uint32_t pgn{0};
+        size_t size{0};
+        std::vector<uint8_t> data;
+    };
+
+    void feed(const Frame& frame) {
+        const CANJ1939PGN pgn = CANJ1939Message::pgnFromIdentifier(frame.id);
+        if (pgn == CANJ1939PGN::TP_CM) {
+            const uint8_t control = frame.data[0];
+            if (control == Scheduler::CM_BAM || control == Scheduler::CM_RTS) {
+                Transfer& transfer = open[{sourceOf(frame), destinationOf(frame)}];
+                transfer.size = frame.data[1] | (frame.data[2] << 8);
+                transfer.pgn = frame.data[5] | (frame.data[6] << 8) | (frame.data[7] << 16);
+                transfer.data.clear();
+            }
+        } else if (pgn == CANJ1939PGN::TP_DT) {
+            Transfer& transfer = open.at({sourceOf(frame), destinationOf(frame)});
+            EXPECT_EQ(frame.data[0], transfer.data.size() / 7 + 1) << "Out of sequence";
+            transfer.data.insert(transfer.data.end(), frame.data + 1, frame.data + 8);
+            if (transfer.data.size() >= transfer.size) {
+                transfer.data.resize(transfer.size);
+                done.push_back(transfer);
+            }
+        }
+    }
+
+    std::map<std::pair<uint8_t, uint8_t>, Transfer> open;
+    std::vector<Transfer> done;
+};
+
+} // namespace
+
+TEST(J1939TransportTest, BroadcastsWithBAM) {
+    Scheduler scheduler;
+    const auto payload = makePayload(20);
+    scheduler.queue(CANJ1939PGN::DM1, payload.data(), payload.size(), 0x00, Scheduler::GLOBAL_ADDRESS, 1000);
+
+    FrameBatch batch;
+    scheduler.advance(UINT64_MAX, batch);
+    ASSERT_EQ(batch.size(), 4u);  // TP.CM_BAM + 3 TP.DT
+
+    const Frame& announce = batch[0];
+    EXPECT_EQ(CANJ1939Message::pgnFromIdentifier(announce.id), CANJ1939PGN::TP_CM);
+    EXPECT_EQ(destinationOf(announce), Scheduler::GLOBAL_ADDRESS);
+    EXPECT_EQ(announce.data[0], Scheduler::CM_BAM);
+    EXPECT_EQ(announce.data[1], 20u);
+    EXPECT_EQ(announce.data[3], 3u);
+    EXPECT_EQ(announce.data[5] | (announce.data[6] << 8) | (announce.data[7] << 16),
+              static_cast<int>(CANJ1939PGN::DM1));
+    EXPECT_EQ((announce.id >> 26) & 0x7, 7u);
+
+    for (size_t i = 1; i < batch.size(); ++i) {
+        EXPECT_EQ(CANJ1939Message::pgnFromIdentifier(batch[i].id), CANJ1939PGN::TP_DT);
+        EXPECT_EQ(batch[i].timestamp_ns, 1000u + i * 50000000u) << "BAM packets are 50 ms apart";
+        EXPECT_EQ(batch[i].data[0], i);
+        EXPECT_EQ(batch[i].dlc, 8u);
+    }
+    EXPECT_EQ(batch[3].data[7], 0xFFu) << "Unused bytes of the last packet are padding";
+
+    Reassembler receiver;
+    for (const Frame& frame : batch) {
+        receiver.feed(frame);
+    }
+    ASSERT_EQ(receiver.done.size(), 1u);
+    EXPECT_EQ(receiver.done[0].data, payload);
+    EXPECT_EQ(scheduler.getCompletedSessions(), 1u);
+    EXPECT_EQ(scheduler.getActiveSessions(), 0u);
+}
+
+TEST(J1939TransportTest, RtsCtsConversation) {
+    J1939TransportTiming timing;
+    timing.packets_per_cts = 2;
+    Scheduler scheduler(timing);
+    const auto payload = makePayload(35);  // 5 packets
+    scheduler.queue(CANJ1939PGN::ENGINE_CONFIG, payload.data(), payload.size(), 0x10, 0x20, 0);
+
+    FrameBatch batch;
+    scheduler.advance(UINT64_MAX, batch);
+
+    // RTS, CTS(2 from 1), DT1, DT2, CTS(2 from 3), DT3, DT4, CTS(1 from 5), DT5, EOM
+    const uint8_t expected[][2] = {{Scheduler::CM_RTS, 0}, {Scheduler::CM_CTS, 1}, {0, 1}, {0, 2},
+                                   {Scheduler::CM_CTS, 3}, {0, 3}, {0, 4}, {Scheduler::CM_CTS, 5},
+                                   {0, 5}, {Scheduler::CM_EOM_ACK, 0}};
+    ASSERT_EQ(batch.size(), 10u);
+    for (size_t i = 0; i < batch.size(); ++i) {
+        const Frame& frame = batch[i];
+        const bool control = CANJ1939Message::pgnFromIdentifier(frame.id) == CANJ1939PGN::TP_CM;
+        const bool from_responder = control && (frame.data[0] == Scheduler::CM_CTS ||
+                                                frame.data[0] == Scheduler::CM_EOM_ACK);
+        EXPECT_EQ(sourceOf(frame), from_responder ? 0x20 : 0x10) << "Frame " << i;
+        EXPECT_EQ(destinationOf(frame), from_responder ? 0x10 : 0x20) << "Frame " << i;
+        if (control) {
+            EXPECT_EQ(frame.data[0], expected[i][0]) << "Frame " << i;
+            if (frame.data[0] == Scheduler::CM_CTS) {
+                EXPECT_EQ(frame.data[2], expected[i][1]) << "Next packet in CTS " << i;
+            }
+        } else {
+            EXPECT_EQ(expected[i][0], 0) << "Frame " << i;
+            EXPECT_EQ(frame.data[0], expected[i][1]) << "Frame " << i;
+        }
+        if (i > 0) {
+            EXPECT_GT(frame.timestamp_ns, batch[i - 1].timestamp_ns);
+        }
+    }
+    EXPECT_EQ(batch[0].data[4], 2u) << "RTS announces the CTS window";
+    EXPECT_EQ(batch[7].data[1], 1u) << "Last window holds the remaining packet";
+
+    Reassembler receiver;
+    for (const Frame& frame : batch) {
+        receiver.feed(frame);
+    }
+    ASSERT_EQ(receiver.done.size(), 1u);
+    EXPECT_EQ(receiver.done[0].data, payload);
+}
+
+TEST(J1939TransportTest, OmitsResponderFramesWhenNotSimulated) {
+    J1939TransportTiming timing;
+    timing.packets_per_cts = 2;
+    timing.simulate_responder = false;
+    Scheduler scheduler(timing);
+    const auto payload = makePayload(35);
+    scheduler.queue(CANJ1939PGN::ENGINE_CONFIG, payload.data(), payload.size(), 0x10, 0x20, 0);
+
+    FrameBatch batch;
+    scheduler.advance(UINT64_MAX, batch);
+    EXPECT_EQ(batch.size(), 6u);  // RTS and the 5 packets
+}
+
+TEST(J1939TransportTest, SerializesSamePairAndOverlapsOthers) {
+    Scheduler scheduler;
+    const auto payload = makePayload(14);  // 2 packets
+    scheduler.queue(CANJ1939PGN::DM1, payload.data(), payload.size(), 0x01, Scheduler::GLOBAL_ADDRESS, 0);
+    scheduler.queue(CANJ1939PGN::COMPONENT_ID, payload.data(), payload.size(), 0x01, Scheduler::GLOBAL_ADDRESS, 0);
+    scheduler.queue(CANJ1939PGN::DM1, payload.data(), payload.size(), 0x02, Scheduler::GLOBAL_ADDRESS, 0);
+    EXPECT_EQ(scheduler.getActiveSessions(), 2u);
+    EXPECT_EQ(scheduler.getWaitingSessions(), 1u);
+
+    FrameBatch batch;
+    scheduler.advance(UINT64_MAX, batch);
+    EXPECT_EQ(scheduler.getCompletedSessions(), 3u);
+
+    // Source 2 broadcasts alongside source 1; source 1's second BAM follows its first
+    uint64_t second_bam_ns = 0;
+    uint64_t first_done_ns = 0;
+    for (const Frame& frame : batch) {
+        const bool announce = CANJ1939Message::pgnFromIdentifier(frame.id) == CANJ1939PGN::TP_CM;
+        if (sourceOf(frame) == 0x01 && announce &&
+            (frame.data[5] | (frame.data[6] << 8) | (frame.data[7] << 16)) == static_cast<int>(CANJ1939PGN::COMPONENT_ID)) {
+            second_bam_ns = frame.timestamp_ns;
+        }
+        if (sourceOf(frame) == 0x01 && !announce && frame.data[0] == 2 && first_done_ns == 0) {
+            first_done_ns = frame.timestamp_ns;
+        }
+        if (sourceOf(frame) == 0x02 && announce) {
+            EXPECT_EQ(frame.timestamp_ns, 0u);
+        }
+    }
+    EXPECT_GE(second_bam_ns, first_done_ns);
+    EXPECT_GT(first_done_ns, 0u);
+}
+
+TEST(J1939TransportTest, ManyConcurrentSessions) {
+    Scheduler scheduler;
+    Reassembler receiver;
+    constexpr int SOURCES = 200;
+    constexpr int DESTINATIONS = 4;
+    for (int source = 0; source < SOURCES; ++source) {
+        for (int destination = 0; destination < DESTINATIONS; ++destination) {
+            const auto payload = makePayload(9 + (source * 7 + destination) % 200, static_cast<uint8_t>(source));
+            scheduler.queue(CANJ1939PGN::ENGINE_CONFIG, payload.data(), payload.size(),
+                            static_cast<uint8_t>(source), static_cast<uint8_t>(0xE0 + destination),
+                            static_cast<uint64_t>(source) * 100000);
+        }
+    }
+    EXPECT_EQ(scheduler.getActiveSessions(), static_cast<size_t>(SOURCES * DESTINATIONS));
+
+    // Step in 10 ms ticks; frames come out in time order across ticks
+    FrameBatch batch;
+    uint64_t last_ns = 0;
+    for (uint64_t end = 10000000; scheduler.getActiveSessions() > 0; end += 10000000) {
+        batch.clear();
+        scheduler.advance(end, batch);
+        for (const Frame& frame : batch) {
+            EXPECT_GE(frame.timestamp_ns, last_ns);
+            EXPECT_LT(frame.timestamp_ns, end);
+            last_ns = frame.timestamp_ns;
+            receiver.feed(frame);
+        }
+    }
+    EXPECT_EQ(receiver.done.size(), static_cast<size_t>(SOURCES * DESTINATIONS));
+    EXPECT_EQ(scheduler.getCompletedSessions(), static_cast<uint64_t>(SOURCES * DESTINATIONS));
+}
+
+TEST(J1939TransportTest, RejectsInvalidTransfers) {
+    Scheduler scheduler;
+    const auto payload = makePayload(Scheduler::MAX_PAYLOAD + 1);
+    EXPECT_THROW(scheduler.queue(CANJ1939PGN::DM1, payload.data(), 8, 0x01, 0xFF, 0), std::invalid_argument);
+    EXPECT_THROW(scheduler.queue(CANJ1939PGN::DM1, payload.data(), payload.size(), 0x01, 0xFF, 0), std::invalid_argument);
+    EXPECT_THROW(scheduler.queue(CANJ1939PGN::DM1, payload.data(), 20, 0xFF, 0x01, 0), std::invalid_argument);
+    J1939TransportTiming timing;
+    timing.packets_per_cts = 0;
+    EXPECT_THROW(Scheduler{timing}, std::invalid_argument);
+}
+
+TEST(J1939TransportTest, GeneratorBroadcastsMultiPacketPGNs) {
+    CANJ1939Generator generator;
+    generator.setRate(100);
+    generator.queueTransfer(CANJ1939PGN::ENGINE_CONFIG, makePayload(100), 0x30, 0x40);
+
+    Reassembler receiver;
+    FrameBatch batch;
+    for (int tick = 0; tick < 600; ++tick) {  // 6 seconds
+        batch.clear();
+        generator.generateFrames(10ms, batch);
+        for (const Frame& frame : batch) {
+            EXPECT_NO_THROW(CANJ1939Message{frame});
+            receiver.feed(frame);
+        }
+    }
+
+    std::map<uint32_t, size_t> sizes;
+    for (const auto& transfer : receiver.done) {
+        sizes[transfer.pgn] = transfer.size;
+    }
+    EXPECT_EQ(sizes[static_cast<uint32_t>(CANJ1939PGN::DM1)], 14u);
+    EXPECT_EQ(sizes[static_cast<uint32_t>(CANJ1939PGN::ENGINE_CONFIG)], 39u);
+    EXPECT_GT(sizes[static_cast<uint32_t>(CANJ1939PGN::COMPONENT_ID)], 8u);
+    EXPECT_GE(receiver.done.size(), 6u + 2u + 2u + 1u);  // DM1 each second, the 5 s PGNs twice, the queued transfer
+
+    bool queued_done = false;
+    for (const auto& transfer : receiver.done) {
+        queued_done |= transfer.size == 100 && transfer.data == makePayload(100);
+    }
+    EXPECT_TRUE(queued_done);
+}
@@ -0,0 +1,192 @@
+#include <gtest/gtest.h>
+#include "serial_bus_generator/capture/capture_reader.hpp"
+#include "serial_bus_generator/capture/capture_writer.hpp"
+#include "serial_bus_generator/protocols/arinc429/arinc429_generator.hpp"
+#include <cstdio>
+#include <fstream>
+#include <thread>
+#include <unistd.h>
+
+using namespace serial_bus_generator;
+using namespace std::chrono_literals;
+
+namespace {
+
+class CaptureTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        path_ = ::testing::TempDir() + "capture_test_" + std::to_string(::getpid()) + ".sbgcap";
+    }
+
+    void TearDown() override {
+        std::remove(path_.c_str());
+    }
+
+    static Frame makeFrame(uint64_t timestamp_ns, uint16_t channel, uint32_t id) {
+        Frame frame;
+        frame.timestamp_ns = timestamp_ns;
+        frame.channel = channel;
+        frame.id = id;
+        frame.type = channel % 2 ? MessageType::CANJ1939 : MessageType::ARINC429;
+        frame.dlc = 4;
+        frame.data[0] = static_cast<uint8_t>(id);
+        return frame;
+    }
+
+    std::string path_;
+};
+
+} // namespace
+
+TEST_F(CaptureTest, RoundTripsRecordsAndChannels) {
+    {
+        CaptureWriter writer(path_, {CaptureWriter::makeChannelInfo(0, MessageType::ARINC429, 100, "adc"),
+                                     CaptureWriter::makeChannelInfo(1, MessageType::CANJ1939, 50, "engine")},
+                             16);
+        std::vector<Frame> frames;
+        for (uint32_t i = 0; i < 100; ++i) {
+            frames.push_back(makeFrame(1000 + i, i % 2, i));
+        }
+        writer.write(frames.data(), 30);
+        writer.write(frames.data() + 30, 70);
+        EXPECT_EQ(writer.getRecordCount(), 100u);
+    }
+
+    CaptureReader reader(path_);
+    EXPECT_EQ(reader.getRecordCount(), 100u);
+    EXPECT_EQ(reader.getFirstTimestamp(), 1000u);
+    EXPECT_EQ(reader.getLastTimestamp(), 1099u);
+    ASSERT_EQ(reader.getChannelCount(), 2u);
+    EXPECT_STREQ(reader.getChannel(1).name, "engine");
+    EXPECT_EQ(reader.getChannel(1).type, MessageType::CANJ1939);
+    EXPECT_EQ(reader.getChannel(1).rate_hz, 50u);
+    EXPECT_EQ(reader.getBlockCount(), 7u);  // 6 full blocks of 16 and the remainder
+
+    uint32_t expected = 0;
+    for (size_t block = 0; block < reader.getBlockCount(); ++block) {
+        const Frame* records = reader.getBlockRecords(block);
+        for (uint32_t i = 0; i < reader.getBlock(block).record_count; ++i, ++expected) {
+            EXPECT_EQ(records[i].id, expected);
+            EXPECT_EQ(records[i].channel, expected % 2);
+            EXPECT_EQ(records[i].timestamp_ns, 1000u + expected);
+        }
+    }
+    EXPECT_EQ(expected, 100u);
+}
+
+TEST_F(CaptureTest, RangeQuerySkipsUnrelatedBlocks) {
+    {
+        CaptureWriter writer(path_, {}, 10);
+        for (uint32_t i = 0; i < 1000; ++i) {
+            Frame frame = makeFrame(static_cast<uint64_t>(i) * 1000, 0, i);
+            writer.write(&frame, 1);
+        }
+    }
+
+    CaptureReader reader(path_);
+    ASSERT_EQ(reader.getBlockCount(), 100u);
+    EXPECT_EQ(reader.findBlock(0), 0u);
+    EXPECT_EQ(reader.findBlock(250000), 25u);
+    EXPECT_EQ(reader.findBlock(10000000), reader.getBlockCount());
+
+    std::vector<uint32_t> ids;
+    size_t visited = reader.forEachInRange(250000, 260000, [&](const Frame& frame) { ids.push_back(frame.id); });
+    ASSERT_EQ(visited, 10u);
+    EXPECT_EQ(ids.front(), 250u);
+    EXPECT_EQ(ids.back(), 259u);
+
+    EXPECT_EQ(reader.forEachInRange(2000000, 3000000, [](const Frame&) {}), 0u);
+}
+
+TEST_F(CaptureTest, RangeQueryHandlesInterleavedChannels) {
+    // Two channels whose batches arrive out of global time order
+    {
+        CaptureWriter writer(path_, {}, 4);
+        for (uint64_t tick = 0; tick < 50; ++tick) {
+            Frame late = makeFrame(tick * 100 + 50, 1, 1);
+            Frame early = makeFrame(tick * 100, 0, 0);
+            writer.write(&late, 1);
+            writer.write(&early, 1);
+        }
+    }
+
+    CaptureReader reader(path_);
+    size_t visited = reader.forEachInRange(1000, 2000, [](const Frame& frame) {
+        EXPECT_GE(frame.timestamp_ns, 1000u);
+        EXPECT_LT(frame.timestamp_ns, 2000u);
+    });
+    EXPECT_EQ(visited, 20u);
+}
+
+TEST_F(CaptureTest, ConcurrentWritersKeepEveryRecord) {
+    constexpr int WRITERS = 4;
+    constexpr uint32_t FRAMES = 20000;
+    {
+        auto writer = std::make_shared<CaptureWriter>(path_, std::vector<CaptureChannelInfo>{}, 1024);
+        std::vector<std::thread> threads;
+        for (int w = 0; w < WRITERS; ++w) {
+            threads.emplace_back([&, w] {
+                std::vector<Frame> batch;
+                for (uint32_t i = 0; i < FRAMES; ++i) {
+                    batch.push_back(makeFrame(i, static_cast<uint16_t>(w), i));
+                    if (batch.size() == 37) {
+                        writer->write(batch.data(), batch.size());
+                        batch.clear();
+                    }
+                }
+                writer->write(batch.data(), batch.size());
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        writer->close();
+    }
+
+    CaptureReader reader(path_);
+    EXPECT_EQ(reader.getRecordCount(), static_cast<uint64_t>(WRITERS) * FRAMES);
+
+    // Each channel's records stay in the order it wrote them
+    std::vector<uint32_t> next(WRITERS, 0);
+    reader.forEachInRange(0, UINT64_MAX, [&](const Frame& frame) {
+        EXPECT_EQ(frame.id, next[frame.channel]++);
+    });
+    for (uint32_t count : next) {
+        EXPECT_EQ(count, FRAMES);
+    }
+    // Writers that both waited for the same full block submit it once
+    for (size_t block = 0; block + 1 < reader.getBlockCount(); ++block) {
+        EXPECT_EQ(reader.getBlock(block).record_count, 1024u) << block;
+    }
+}
+
+TEST_F(CaptureTest, RecordsGeneratorOutput) {
+    {
+        auto writer = std::make_shared<CaptureWriter>(path_, std::vector<CaptureChannelInfo>{});
+        ARINC429Generator generator;
+        generator.setRate(1000);
+        generator.setClockMode(ClockMode::VIRTUAL);
+        generator.setVirtualDuration(100ms);
+        generator.addSink(writer);
+        generator.start();
+        while (generator.getState() == GeneratorState::RUNNING) {
+            std::this_thread::sleep_for(1ms);
+        }
+        generator.stop();
+        EXPECT_GT(writer->getRecordCount(), 0u);
+    }
+
+    CaptureReader reader(path_);
+    EXPECT_GT(reader.getRecordCount(), 0u);
+    EXPECT_GE(reader.getLastTimestamp(), reader.getFirstTimestamp());
+}
+
+TEST_F(CaptureTest, RejectsUnfinishedOrForeignFiles) {
+    {
+        std::ofstream out(path_, std::ios::binary);
+        out << std::string(128, 'x');
+    }
+    EXPECT_THROW(CaptureReader reader(path_), std::runtime_error);
+    EXPECT_THROW(CaptureReader reader(path_ + ".missing"), std::system_error);
+    EXPECT_THROW(CaptureWriter(path_, {}, 0), std::invalid_argument);
+}
@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+#include "serial_bus_generator/core/channel_runtime.hpp"
+#include "serial_bus_generator/protocols/arinc429/arinc429_generator.hpp"
+#include "serial_bus_generator/protocols/canj1939/canj1939_generator.hpp"
+#include <thread>
+#include <chrono>
+
+using namespace serial_bus_generator;
+using namespace std::chrono_literals;
+
+class ChannelRuntimeTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        runtime = std::make_unique<ChannelRuntime>(2);
+        for (size_t i = 0; i < CHANNELS; ++i) {
+            if (i % 2 == 0) {
+                runtime->addChannel(std::make_unique<ARINC429Generator>());
+            } else {
+                runtime->addChannel(std::make_unique<CANJ1939Generator>());
+            }
+        }
+    }
+
+    static constexpr size_t CHANNELS = 40;
+    std::unique_ptr<ChannelRuntime> runtime;
+};
+
+TEST_F(ChannelRuntimeTest, HostsChannelsOnWorkerPool) {
+    EXPECT_EQ(runtime->getWorkerCount(), 2u);
+    EXPECT_EQ(runtime->getChannelCount(), CHANNELS);
+
+    for (size_t i = 0; i < CHANNELS; ++i) {
+        runtime->getChannel(i).setRate(200);
+    }
+    runtime->startAll();
+    std::this_thread::sleep_for(200ms);
+    runtime->stopAll();
+
+    for (size_t i = 0; i < CHANNELS; ++i) {
+        auto& channel = runtime->getChannel(i);
+        EXPECT_EQ(channel.getState(), GeneratorState::STOPPED);
+        // ~40 ticks expected; allow for a loaded CI machine
+        EXPECT_GT(channel.getTickCount() + channel.getMissedDeadlines(), 20u) << "channel " << i;
+    }
+}
+
+TEST_F(ChannelRuntimeTest, PerChannelStartStop) {
+    auto& running = runtime->getChannel(0);
+    auto& idle = runtime->getChannel(1);
+
+    running.start();
+    EXPECT_EQ(running.getState(), GeneratorState::RUNNING);
+    EXPECT_EQ(idle.getState(), GeneratorState::STOPPED);
+    std::this_thread::sleep_for(50ms);
+    running.stop();
+
+    const auto ticks = running.getTickCount();
+    EXPECT_GT(ticks, 0u);
+    EXPECT_EQ(idle.getTickCount(), 0u);
+
+    // No ticks after stop() has returned
+    std::this_thread::sleep_for(30ms);
+    EXPECT_EQ(running.getTickCount(), ticks);
+
+    // Restart resumes on the pool
+    running.start();
+    std::this_thread::sleep_for(30ms);
+    running.stop();
+    EXPECT_GT(running.getTickCount(), ticks);
+}
+
+TEST_F(ChannelRuntimeTest, SetRateWhileRunning) {
+    auto& channel = runtime->getChannel(0);
+    channel.setRate(10);
+    channel.start();
+    std::this_thread::sleep_for(50ms);
+    const auto slow_ticks = channel.getTickCount();
+
+    // Takes effect after the pending 100ms deadline
+    channel.setRate(1000);
+    std::this_thread::sleep_for(150ms);
+    channel.stop();
+
+    EXPECT_LE(slow_ticks, 3u);
+    EXPECT_GT(channel.getTickCount() - slow_ticks, 30u);
+}
+
+TEST_F(ChannelRuntimeTest, RejectsRunningGenerator) {
+    auto generator = std::make_unique<CANJ1939Generator>();
+    generator->start();
+    EXPECT_THROW(runtime->addChannel(std::move(generator)), std::logic_error);
+}
\ No newline at end of file
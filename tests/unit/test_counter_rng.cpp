@@ -0,0 +1,70 @@
+#include <gtest/gtest.h>
+#include "serial_bus_generator/core/counter_rng.hpp"
+#include <algorithm>
+#include <numeric>
+#include <set>
+#include <vector>
+
+using namespace serial_bus_generator;
+
+// Known-answer vectors published with the Random123 reference implementation
+TEST(CounterRngTest, MatchesPhiloxReferenceVectors) {
+    EXPECT_EQ(CounterRng::philox({0, 0, 0, 0}, 0, 0),
+              (CounterRng::Block{0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8}));
+    EXPECT_EQ(CounterRng::philox({0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff}, 0xffffffff, 0xffffffff),
+              (CounterRng::Block{0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd}));
+    EXPECT_EQ(CounterRng::philox({0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344}, 0xa4093822, 0x299f31d0),
+              (CounterRng::Block{0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}));
+}
+
+TEST(CounterRngTest, DrawsArePureFunctionsOfTheCounter) {
+    const CounterRng rng(0x0123456789abcdefull);
+    EXPECT_EQ(rng.getSeed(), 0x0123456789abcdefull);
+
+    // Visiting entities in any order gives the same values
+    std::vector<uint32_t> order(1000);
+    std::iota(order.begin(), order.end(), 0u);
+    std::vector<CounterRng::Block> forward(order.size());
+    for (uint32_t entity : order) {
+        forward[entity] = rng(3, entity, 77);
+    }
+    std::reverse(order.begin(), order.end());
+    for (uint32_t entity : order) {
+        EXPECT_EQ(rng(3, entity, 77), forward[entity]);
+    }
+}
+
+TEST(CounterRngTest, EveryCounterFieldSelectsAnIndependentStream) {
+    const CounterRng rng(9);
+    std::set<uint32_t> seen;
+    seen.insert(rng(0, 0, 0)[0]);
+    seen.insert(rng(1, 0, 0)[0]);
+    seen.insert(rng(0, 1, 0)[0]);
+    seen.insert(rng(0, 0, 1)[0]);
+    seen.insert(rng(0, 0, 1ull << 32)[0]);
+    seen.insert(rng(0, 0, 0, 1)[0]);
+    seen.insert(CounterRng(10)(0, 0, 0)[0]);
+    EXPECT_EQ(seen.size(), 7u);
+}
+
+TEST(CounterRngTest, UniformValuesCoverTheRange) {
+    const CounterRng rng(1);
+    double sum = 0.0;
+    float low = 1.0f;
+    float high = 0.0f;
+    const int draws = 100000;
+    for (int tick = 0; tick < draws; ++tick) {
+        const float value = CounterRng::toUnit(rng(0, 0, tick)[0]);
+        ASSERT_GE(value, 0.0f);
+        ASSERT_LT(value, 1.0f);
+        sum += value;
+        low = std::min(low, value);
+        high = std::max(high, value);
+    }
+    EXPECT_NEAR(sum / draws, 0.5, 0.01);
+    EXPECT_LT(low, 0.001f);
+    EXPECT_GT(high, 0.999f);
+
+    EXPECT_EQ(CounterRng::toRange(0, -2.0f, 2.0f), -2.0f);
+    EXPECT_LT(CounterRng::toRange(0xffffffff, -2.0f, 2.0f), 2.0f);
+}
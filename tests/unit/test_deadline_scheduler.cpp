@@ -0,0 +1,77 @@
+#include <gtest/gtest.h>
+#include "serial_bus_generator/core/deadline_scheduler.hpp"
+#include <thread>
+#include <chrono>
+
+using namespace serial_bus_generator;
+using namespace std::chrono_literals;
+
+class DeadlineSchedulerTest : public ::testing::Test {
+protected:
+    using Clock = DeadlineScheduler::Clock;
+
+    void SetUp() override {
+        origin = Clock::now();
+    }
+
+    Clock::time_point origin;
+};
+
+TEST_F(DeadlineSchedulerTest, ExactAverageRate) {
+    // 300 Hz has no whole-millisecond period; 300 ticks must still span exactly 1s
+    DeadlineScheduler scheduler(300);
+    scheduler.start(origin);
+    for (int i = 0; i < 300; ++i) {
+        scheduler.advance();
+    }
+    EXPECT_EQ(scheduler.nextDeadline(), origin + 1s);
+    EXPECT_EQ(scheduler.elapsed(), 1s);
+}
+
+TEST_F(DeadlineSchedulerTest, SubMillisecondPeriod) {
+    DeadlineScheduler scheduler(100000);  // 100 kHz
+    scheduler.start(origin);
+    scheduler.advance();
+    EXPECT_EQ(scheduler.elapsed(), 10us);
+}
+
+TEST_F(DeadlineSchedulerTest, RateChangeKeepsPendingDeadline) {
+    DeadlineScheduler scheduler(100);
+    scheduler.start(origin);
+    scheduler.advance();
+    scheduler.advance();  // pending deadline at 20ms
+
+    scheduler.setRate(1000);
+    EXPECT_EQ(scheduler.nextDeadline(), origin + 20ms);
+
+    scheduler.advance();
+    EXPECT_EQ(scheduler.nextDeadline(), origin + 21ms);
+    EXPECT_EQ(scheduler.elapsed(), 21ms);
+}
+
+TEST_F(DeadlineSchedulerTest, ReportsMissedDeadlines) {
+    DeadlineScheduler scheduler(1000);
+    scheduler.start(origin);
+
+    // Finishing tick 0 at 5.5ms leaves deadlines 1..4 unreachable; tick 5 runs late
+    EXPECT_EQ(scheduler.advance(origin + 5500us), 4u);
+    EXPECT_EQ(scheduler.nextDeadline(), origin + 5ms);
+
+    // Finishing on time misses nothing
+    EXPECT_EQ(scheduler.advance(origin + 5900us), 0u);
+    EXPECT_EQ(scheduler.nextDeadline(), origin + 6ms);
+}
+
+TEST_F(DeadlineSchedulerTest, SleepsUntilDeadline) {
+    DeadlineScheduler scheduler(200);
+    scheduler.start(Clock::now());
+    scheduler.advance();
+
+    auto deadline = scheduler.nextDeadline();
+    scheduler.sleepUntilDeadline();
+    EXPECT_GE(Clock::now(), deadline);
+}
+
+TEST_F(DeadlineSchedulerTest, RejectsZeroRate) {
+    EXPECT_THROW(DeadlineScheduler scheduler(0), std::invalid_argument);
+}
\ No newline at end of file
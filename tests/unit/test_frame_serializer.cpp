@@ -0,0 +1,58 @@
+#include <gtest/gtest.h>
+#include "serial_bus_generator/messages/frame_serializer.hpp"
+#include "serial_bus_generator/protocols/arinc429/arinc429_message.hpp"
+#include "serial_bus_generator/protocols/canj1939/canj1939_message.hpp"
+#include <vector>
+
+using namespace serial_bus_generator;
+
+class FrameSerializerTest : public ::testing::Test {
+protected:
+    ARINC429Message arinc{ARINC429Label::ALTITUDE, 35000.0f, ARINC429SSM::NORMAL_OPERATION};
+    CANJ1939Message j1939{CANJ1939PGN::ENGINE_HOURS, 1234.5f, CANJ1939Priority::PRIORITY_6};
+};
+
+TEST_F(FrameSerializerTest, SerializeIntoMatchesSerialize) {
+    uint8_t buffer[MAX_WIRE_SIZE];
+
+    auto expected = arinc.serialize();
+    ASSERT_EQ(arinc.serializeInto(buffer, sizeof(buffer)), ARINC429_WIRE_SIZE);
+    EXPECT_EQ(std::vector<uint8_t>(buffer, buffer + ARINC429_WIRE_SIZE), expected);
+
+    expected = j1939.serialize();
+    ASSERT_EQ(j1939.serializeInto(buffer, sizeof(buffer)), CANJ1939_WIRE_SIZE);
+    EXPECT_EQ(std::vector<uint8_t>(buffer, buffer + CANJ1939_WIRE_SIZE), expected);
+}
+
+TEST_F(FrameSerializerTest, RejectsShortBuffer) {
+    uint8_t buffer[MAX_WIRE_SIZE] = {};
+    EXPECT_EQ(arinc.serializeInto(buffer, ARINC429_WIRE_SIZE - 1), 0u);
+    EXPECT_EQ(j1939.serializeInto(buffer, CANJ1939_WIRE_SIZE - 1), 0u);
+    EXPECT_EQ(buffer[0], 0);
+}
+
+TEST_F(FrameSerializerTest, PacksBatchContiguously) {
+    const Frame frames[] = {arinc.toFrame(), j1939.toFrame(), arinc.toFrame()};
+
+    std::vector<uint8_t> expected;
+    for (const IMessage* msg : {static_cast<const IMessage*>(&arinc),
+                                static_cast<const IMessage*>(&j1939),
+                                static_cast<const IMessage*>(&arinc)}) {
+        auto bytes = msg->serialize();
+        expected.insert(expected.end(), bytes.begin(), bytes.end());
+    }
+
+    std::vector<uint8_t> buffer(64);
+    size_t consumed = 0;
+    size_t written = serializeFrames(frames, 3, buffer.data(), buffer.size(), &consumed);
+    EXPECT_EQ(consumed, 3u);
+    ASSERT_EQ(written, expected.size());
+    buffer.resize(written);
+    EXPECT_EQ(buffer, expected);
+
+    // Stops at the first frame that does not fit
+    uint8_t small[10];
+    written = serializeFrames(frames, 3, small, sizeof(small), &consumed);
+    EXPECT_EQ(consumed, 1u);
+    EXPECT_EQ(written, ARINC429_WIRE_SIZE);
+}
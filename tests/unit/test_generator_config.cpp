@@ -0,0 +1,368 @@
+#include <gtest/gtest.h>
+#include "serial_bus_generator/config/generator_config.hpp"
+#include "serial_bus_generator/protocols/arinc429/arinc429_fleet.hpp"
+#include "serial_bus_generator/protocols/arinc429/arinc429_generator.hpp"
+#include "serial_bus_generator/protocols/canj1939/canj1939_generator.hpp"
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <thread>
+#include <unistd.h>
+
+using namespace serial_bus_generator;
+using namespace std::chrono_literals;
+
+namespace {
+
+const char SCENARIO[] = R"(# Two channels
+[scenario]
+name = soak
+seed = 42
+
+[channel nav]
+protocol = ARINC429
+channel = 0
+rate = 200
+route = 40.6413,-73.7781 -> 51.4700,-0.4543
+signal = ALTITUDE 50ms 15ms
+signal = LATITUDE 200ms
+signal = TRACK_HEADING 100ms 5ms   ; inline comment
+fault = LATITUDE SSM_FAILURE 20s 5s
+fault = ALTITUDE PARITY_ERROR 10s 500ms
+
+[channel engine]
+protocol = CANJ1939
+channel = 1
+signal = ENGINE_SPEED 10ms
+signal = DM1 1s 11ms
+fault = ENGINE_SPEED BAD_LENGTH 1s 1s
+rpm_jitter = 0
+)";
+
+ScenarioPlan compile(const std::string& text) {
+    std::istringstream in(text);
+    return ScenarioPlan::compile(in);
+}
+
+// Message of the error a scenario fails with; empty if it compiles
+std::string compileError(const std::string& text) {
+    try {
+        compile(text);
+    } catch (const std::invalid_argument& e) {
+        return e.what();
+    }
+    return std::string();
+}
+
+std::shared_ptr<const ChannelPlan> channelPlan(const std::string& text, const std::string& name) {
+    auto plan = std::make_shared<const ScenarioPlan>(compile(text));
+    return std::shared_ptr<const ChannelPlan>(plan, plan->findChannel(name));
+}
+
+} // namespace
+
+TEST(GeneratorConfigTest, CompilesChannelsToProtocolKeys) {
+    const ScenarioPlan plan = compile(SCENARIO);
+    EXPECT_EQ(plan.name, "soak");
+    EXPECT_TRUE(plan.has_seed);
+    EXPECT_EQ(plan.seed, 42u);
+    ASSERT_EQ(plan.channels.size(), 2u);
+    EXPECT_EQ(plan.findChannel("missing"), nullptr);
+
+    const ChannelPlan& nav = *plan.findChannel("nav");
+    EXPECT_EQ(nav.protocol, MessageType::ARINC429);
+    EXPECT_EQ(nav.rate, 200u);
+    EXPECT_TRUE(nav.has_route);
+    EXPECT_DOUBLE_EQ(nav.origin.latitude, 40.6413);
+    EXPECT_DOUBLE_EQ(nav.destination.longitude, -0.4543);
+    ASSERT_EQ(nav.signals.size(), 3u);
+    EXPECT_EQ(nav.signals[0].key, static_cast<uint32_t>(ARINC429Label::ALTITUDE));
+    EXPECT_EQ(nav.signals[0].period, 50ms);
+    EXPECT_EQ(nav.signals[0].phase, 15ms);
+    EXPECT_EQ(nav.signals[1].phase, 0ms);
+    EXPECT_EQ(nav.signals[2].key, static_cast<uint32_t>(ARINC429Label::TRACK_HEADING));
+
+    // Sorted by start, whatever the file order
+    ASSERT_EQ(nav.faults.size(), 2u);
+    EXPECT_EQ(nav.faults[0].kind, FaultKind::PARITY_ERROR);
+    EXPECT_EQ(nav.faults[0].start, 10s);
+    EXPECT_EQ(nav.faults[0].end, 10500ms);
+    EXPECT_EQ(nav.faults[1].key, static_cast<uint32_t>(ARINC429Label::LATITUDE));
+
+    const ChannelPlan& engine = *plan.findChannel("engine");
+    EXPECT_EQ(engine.protocol, MessageType::CANJ1939);
+    EXPECT_EQ(engine.channel, 1u);
+    EXPECT_EQ(engine.rate, 100u);
+    EXPECT_EQ(engine.signals[1].key, static_cast<uint32_t>(CANJ1939PGN::DM1));
+    EXPECT_EQ(engine.rpm_jitter, 0.0f);
+    EXPECT_EQ(engine.temperature_drift, 2.0f);
+}
+
+TEST(GeneratorConfigTest, ErrorsNameTheLine) {
+    const std::string header = "[channel a]\nprotocol = ARINC429\nchannel = 0\n";
+    EXPECT_EQ(compileError(header + "signal = ALTITUDE 50ms\n"), "");
+    EXPECT_EQ(compileError(header + "signal = ENGINE_SPEED 10ms\n"),
+              "scenario:4: Unknown ARINC429 signal 'ENGINE_SPEED'");
+    EXPECT_EQ(compileError(header + "signal = ALTITUDE 50\n"),
+              "scenario:4: Duration '50' needs a unit of ns, us, ms or s");
+    EXPECT_EQ(compileError(header + "signal = ALTITUDE 50ms\nfault = LATITUDE DROP 1s 1s\n"),
+              "scenario:5: Fault targets 'LATITUDE', which is not scheduled on this channel");
+    EXPECT_EQ(compileError(header + "signal = ALTITUDE 50ms\nfault = ALTITUDE BAD_LENGTH 1s 1s\n"),
+              "scenario:5: BAD_LENGTH only applies to single-frame J1939 PGNs");
+    EXPECT_EQ(compileError(header + "rate = 0\n"), "scenario:4: Rate must be at least 1 Hz");
+    EXPECT_EQ(compileError(header + "route = 10,10 -> 10,10\nsignal = ALTITUDE 50ms\n"),
+              "scenario:1: Bad route: Origin and destination must be at least 1 nm apart");
+    EXPECT_EQ(compileError(header), "scenario:1: Channel 'a' has no signals");
+    EXPECT_EQ(compileError("[channel a]\nprotocol = CANJ1939\nchannel = 0\nsignal = DM1 1s\n"
+                           "fault = DM1 PARITY_ERROR 1s 1s\n"),
+              "scenario:5: Fault kind 'PARITY_ERROR' only applies to ARINC429");
+    EXPECT_EQ(compileError(header + "signal = ALTITUDE 50ms\n[channel b]\nprotocol = ARINC429\n"
+                           "channel = 0\nsignal = ALTITUDE 50ms\n"),
+              "scenario:5: Channel 'b' overlaps the channels of 'a'");
+    EXPECT_EQ(compileError(header + "fleet = 10\nsignal = ALTITUDE 50ms\n[channel b]\n"
+                           "protocol = CANJ1939\nchannel = 9\nsignal = DM1 1s\n"),
+              "scenario:6: Channel 'b' overlaps the channels of 'a'");
+    EXPECT_EQ(compileError("[scenario]\nseed = -1\n"), "scenario:2: Bad seed '-1'");
+    EXPECT_EQ(compileError("[scenario]\n"), "scenario: Scenario has no channels");
+    EXPECT_EQ(compileError("name = x\n"), "scenario:1: Setting outside of a section");
+}
+
+TEST(GeneratorConfigTest, FaultScheduleTracksWindows) {
+    FaultSchedule faults;
+    faults.assign({{1s, 3s, 7, FaultKind::DROP}, {2s, 4s, 8, FaultKind::PARITY_ERROR}});
+    EXPECT_FALSE(faults.anyActive());
+
+    faults.advance(1s);
+    ASSERT_NE(faults.find(7), nullptr);
+    EXPECT_EQ(faults.find(8), nullptr);
+    faults.advance(2500ms);
+    EXPECT_NE(faults.find(7), nullptr);
+    EXPECT_EQ(faults.find(8)->kind, FaultKind::PARITY_ERROR);
+    faults.advance(3s);
+    EXPECT_EQ(faults.find(7), nullptr);
+    faults.advance(10s);
+    EXPECT_FALSE(faults.anyActive());
+
+    // A new fault list picks up windows open at the current time
+    faults.assign({{9s, 11s, 7, FaultKind::DROP}});
+    EXPECT_NE(faults.find(7), nullptr);
+    faults.restart();
+    EXPECT_FALSE(faults.anyActive());
+}
+
+TEST(GeneratorConfigTest, ARINC429PlanSetsLabelsRouteAndFaults) {
+    ARINC429Generator generator;
+    generator.setPlan(channelPlan(R"(
+[channel nav]
+protocol = ARINC429
+channel = 3
+rate = 50
+route = 40.6413,-73.7781 -> 51.4700,-0.4543
+signal = ALTITUDE 100ms
+signal = LATITUDE 100ms
+signal = GROUND_SPEED 100ms
+signal = VERTICAL_SPEED 100ms
+fault = ALTITUDE PARITY_ERROR 0s 1s
+fault = LATITUDE SSM_FAILURE 0s 1s
+fault = GROUND_SPEED DROP 0s 1s
+)", "nav"));
+    EXPECT_EQ(generator.getChannel(), 3u);
+    EXPECT_NEAR(generator.getTrajectory().getOrigin().latitude, 40.6413, 1e-9);
+
+    std::map<ARINC429Label, int> sent;
+    std::map<ARINC429Label, int> bad_parity;
+    std::map<ARINC429Label, int> failure;
+    for (int tick = 0; tick < 10; ++tick) {
+        FrameBatch batch;
+        generator.generateFrames(100ms, batch);
+        for (const Frame& frame : batch) {
+            ARINC429Message message(frame);
+            EXPECT_EQ(frame.channel, 3u);
+            sent[message.getLabel()]++;
+            bad_parity[message.getLabel()] += !message.verifyParity();
+            failure[message.getLabel()] += message.getSSM() == ARINC429SSM::FAILURE_WARNING;
+        }
+    }
+    EXPECT_EQ(sent.size(), 3u);
+    EXPECT_EQ(sent[ARINC429Label::GROUND_SPEED], 0);
+    EXPECT_EQ(bad_parity[ARINC429Label::ALTITUDE], sent[ARINC429Label::ALTITUDE]);
+    EXPECT_EQ(bad_parity[ARINC429Label::LATITUDE], 0);
+    EXPECT_EQ(failure[ARINC429Label::LATITUDE], sent[ARINC429Label::LATITUDE]);
+    EXPECT_EQ(sent[ARINC429Label::VERTICAL_SPEED], 10);
+
+    // Past the fault windows everything is sent clean
+    FrameBatch batch;
+    generator.generateFrames(100ms, batch);
+    ASSERT_EQ(batch.size(), 4u);
+    for (const Frame& frame : batch) {
+        ARINC429Message message(frame);
+        EXPECT_TRUE(message.verifyParity());
+        EXPECT_EQ(message.getSSM(), ARINC429SSM::NORMAL_OPERATION);
+    }
+
+    EXPECT_THROW(generator.setPlan(channelPlan(SCENARIO, "engine")), std::invalid_argument);
+}
+
+TEST(GeneratorConfigTest, FleetFliesThePlannedRoute) {
+    ARINC429Generator generator;
+    generator.setPlan(channelPlan(R"(
+[channel fleet]
+protocol = ARINC429
+channel = 100
+fleet = 20
+route = -33.9399,151.1753 -> -37.6690,144.8410
+signal = TRACK_HEADING 100ms
+)", "fleet"));
+    ASSERT_EQ(generator.getFleetSize(), 20u);
+    for (size_t i = 0; i < 20; ++i) {
+        // Sydney to Melbourne and back, with the fleet's end point jitter
+        EXPECT_LT(generator.getFleet()->getLatitude(i), -30.0);
+        EXPECT_GT(generator.getFleet()->getLongitude(i), 140.0);
+    }
+
+    FrameBatch batch;
+    generator.generateFrames(100ms, batch);
+    ASSERT_EQ(batch.size(), 20u);
+    for (size_t i = 0; i < batch.size(); ++i) {
+        ARINC429Message message(batch[i]);
+        EXPECT_EQ(message.getLabel(), ARINC429Label::TRACK_HEADING);
+        EXPECT_EQ(batch[i].channel, 100u + i);
+        double track = generator.getFleet()->getTrack(i);
+        track = track > 180.0 ? track - 360.0 : track;
+        EXPECT_NEAR(message.getDecodedValue(), track, 0.01);
+    }
+}
+
+TEST(GeneratorConfigTest, CANJ1939PlanSetsPGNsNoiseAndFaults) {
+    CANJ1939Generator generator;
+    generator.setPlan(channelPlan(SCENARIO, "engine"));
+
+    int speed_frames = 0;
+    int short_frames = 0;
+    for (int tick = 0; tick < 200; ++tick) {
+        FrameBatch batch;
+        generator.generateFrames(10ms, batch);
+        for (const Frame& frame : batch) {
+            if (frame.dlc == 4) {
+                ++speed_frames;  // Only ENGINE_SPEED is faulted; too short to decode
+                ++short_frames;
+                continue;
+            }
+            const CANJ1939Message message(frame);
+            EXPECT_NE(message.getPGN(), CANJ1939PGN::ENGINE_HOURS);
+            if (message.getPGN() == CANJ1939PGN::ENGINE_SPEED) {
+                ++speed_frames;
+                EXPECT_NEAR(message.getDecodedValue(), 750.0f, 0.2f) << "No RPM jitter";
+            }
+        }
+    }
+    EXPECT_EQ(speed_frames, 200);
+    EXPECT_EQ(short_frames, 100);
+}
+
+TEST(GeneratorConfigTest, CANJ1939LengthFaultsDoNotBreakMessages) {
+    const std::string text = "[channel engine]\nprotocol = CANJ1939\nchannel = 1\n"
+                             "signal = ENGINE_SPEED 10ms\n"
+                             "fault = ENGINE_SPEED BAD_LENGTH 0s 3600s\n";
+
+    CANJ1939Generator generator;
+    generator.setPlan(channelPlan(text, "engine"));
+    std::vector<std::unique_ptr<IMessage>> messages;
+    ASSERT_NO_THROW(messages = generator.generateMessages(100ms));
+    EXPECT_TRUE(messages.empty()) << "Every frame is cut short";
+
+    generator.start();
+    std::this_thread::sleep_for(50ms);
+    std::string last;
+    ASSERT_NO_THROW(last = static_cast<IGenerator&>(generator).getLastMessage());
+    generator.stop();
+    EXPECT_NE(last.find("Malformed frame"), std::string::npos) << last;
+}
+
+TEST(GeneratorConfigTest, RunningGeneratorSwapsPlanBetweenTicks) {
+    const std::string before = "[channel nav]\nprotocol = ARINC429\nchannel = 0\nsignal = ALTITUDE 10ms\n";
+    const std::string after = "[channel nav]\nprotocol = ARINC429\nchannel = 0\nrate = 200\n"
+                              "signal = VERTICAL_SPEED 10ms\n";
+
+    ARINC429Generator generator;
+    generator.setPlan(channelPlan(before, "nav"));
+    generator.start();
+    std::this_thread::sleep_for(100ms);
+    generator.setPlan(channelPlan(after, "nav"));
+    EXPECT_THROW(generator.setPlan(channelPlan(
+        "[channel nav]\nprotocol = ARINC429\nchannel = 1\nsignal = ALTITUDE 10ms\n", "nav")), std::logic_error);
+    std::this_thread::sleep_for(100ms);
+    generator.stop();
+    EXPECT_EQ(generator.getState(), GeneratorState::STOPPED);
+
+    std::vector<Frame> frames(generator.getQueuedFrames());
+    frames.resize(generator.drainFrames(frames.data(), frames.size()));
+    ASSERT_FALSE(frames.empty());
+    EXPECT_EQ(ARINC429Message(frames.front()).getLabel(), ARINC429Label::ALTITUDE);
+    EXPECT_EQ(ARINC429Message(frames.back()).getLabel(), ARINC429Label::VERTICAL_SPEED);
+
+    // Once the new plan is in, the dropped label stays quiet
+    bool swapped = false;
+    for (const Frame& frame : frames) {
+        const ARINC429Label label = ARINC429Message(frame).getLabel();
+        swapped = swapped || label == ARINC429Label::VERTICAL_SPEED;
+        EXPECT_FALSE(swapped && label == ARINC429Label::ALTITUDE);
+    }
+}
+
+class ScenarioLoaderTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        path_ = ::testing::TempDir() + "scenario_test_" + std::to_string(::getpid()) + ".ini";
+        write(SCENARIO);
+    }
+
+    void TearDown() override {
+        std::remove(path_.c_str());
+    }
+
+    // Rewrites the file with a later modification time than any before it
+    void write(const std::string& text) {
+        std::ofstream(path_) << text;
+        std::filesystem::last_write_time(path_, std::filesystem::file_time_type::clock::now() + 1s * ++writes_);
+    }
+
+    std::string path_;
+    int writes_{0};
+};
+
+TEST_F(ScenarioLoaderTest, ReloadsChangedFile) {
+    ScenarioLoader loader(path_);
+    auto first = loader.getPlan();
+    EXPECT_EQ(loader.getVersion(), 1u);
+    EXPECT_FALSE(loader.reloadIfChanged());
+
+    std::string text = SCENARIO;
+    text.replace(text.find("rate = 200"), 10, "rate = 400");
+    write(text);
+    EXPECT_TRUE(loader.reloadIfChanged());
+    EXPECT_EQ(loader.getVersion(), 2u);
+    EXPECT_EQ(loader.getPlan()->findChannel("nav")->rate, 400u);
+    EXPECT_EQ(first->findChannel("nav")->rate, 200u) << "Readers keep the plan they hold";
+    EXPECT_TRUE(loader.getLastError().empty());
+}
+
+TEST_F(ScenarioLoaderTest, KeepsPlanOnBadReload) {
+    ScenarioLoader loader(path_);
+
+    write(std::string(SCENARIO) + "bogus = 1\n");
+    EXPECT_FALSE(loader.reloadIfChanged());
+    EXPECT_EQ(loader.getLastError(), path_ + ":24: Unknown channel setting 'bogus'");
+
+    std::string moved = SCENARIO;
+    moved.replace(moved.find("channel = 1"), 11, "channel = 2");
+    write(moved);
+    EXPECT_FALSE(loader.reloadIfChanged());
+    EXPECT_NE(loader.getLastError().find("Channels cannot change"), std::string::npos);
+
+    EXPECT_EQ(loader.getVersion(), 1u);
+    EXPECT_EQ(loader.getPlan()->findChannel("engine")->channel, 1u);
+    EXPECT_THROW(ScenarioLoader(path_ + ".missing"), std::runtime_error);
+}
@@ -15,6 +15,9 @@ public:
     MOCK_METHOD(void, setRate, (uint32_t rate), (override));
     MOCK_METHOD(GeneratorState, getState, (), (const, override));
     MOCK_METHOD(std::vector<std::unique_ptr<IMessage>>, generateMessages, (std::chrono::milliseconds duration), (override));
+    MOCK_METHOD(std::string, getLastMessage, (), (override));
+    MOCK_METHOD(GeneratorStats, getStats, (), (const, override));
+    MOCK_METHOD(std::string, getLastError, (), (const, override));
 };
 
 class GeneratorInterfaceTest : public ::testing::Test {
@@ -56,7 +59,7 @@ TEST_F(GeneratorInterfaceTest, MessageGeneration) {
     
     EXPECT_CALL(*generator, generateMessages(duration))
         .Times(1)
-        .WillOnce(testing::Return(std::vector<std::unique_ptr<IMessage>>{}));
+        .WillOnce(testing::Return(testing::ByMove(std::vector<std::unique_ptr<IMessage>>{})));
     
     auto messages = generator->generateMessages(duration);
     EXPECT_TRUE(messages.empty());  // For this test, we return empty vector
@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+#include "serial_bus_generator/metrics/latency_histogram.hpp"
+#include "serial_bus_generator/protocols/arinc429/arinc429_generator.hpp"
+#include <atomic>
+#include <memory>
+#include <random>
+#include <thread>
+
+using namespace serial_bus_generator;
+using namespace std::chrono_literals;
+
+TEST(LatencyHistogramTest, BucketsTileTheRange) {
+    EXPECT_EQ(LatencyHistogram::bucketLowest(0), 0u);
+    for (size_t i = 1; i < LatencyHistogram::BUCKET_COUNT; ++i) {
+        ASSERT_EQ(LatencyHistogram::bucketLowest(i), LatencyHistogram::bucketHighest(i - 1) + 1) << i;
+    }
+    EXPECT_EQ(LatencyHistogram::bucketHighest(LatencyHistogram::BUCKET_COUNT - 1),
+              LatencyHistogram::MAX_TRACKABLE);
+    EXPECT_EQ(LatencyHistogram::bucketIndex(LatencyHistogram::MAX_TRACKABLE + 1000),
+              LatencyHistogram::BUCKET_COUNT - 1);
+}
+
+TEST(LatencyHistogramTest, BucketWidthBoundsTheRelativeError) {
+    std::mt19937_64 random(1);
+    for (int i = 0; i < 100000; ++i) {
+        const uint64_t value = random() >> (random() % 64) & LatencyHistogram::MAX_TRACKABLE;
+        const size_t index = LatencyHistogram::bucketIndex(value);
+        ASSERT_LE(LatencyHistogram::bucketLowest(index), value);
+        ASSERT_GE(LatencyHistogram::bucketHighest(index), value);
+        const double width = static_cast<double>(LatencyHistogram::bucketHighest(index) -
+                                                 LatencyHistogram::bucketLowest(index));
+        ASSERT_LE(width, static_cast<double>(value) * 2.0 / LatencyHistogram::SUB_BUCKETS) << value;
+    }
+}
+
+TEST(LatencyHistogramTest, PercentilesOfAUniformDistribution) {
+    auto histogram = std::make_unique<LatencyHistogram>();
+    for (int us = 1; us <= 1000; ++us) {
+        histogram->record(std::chrono::microseconds(us));
+    }
+    const HistogramSnapshot snapshot = histogram->snapshot();
+
+    EXPECT_EQ(snapshot.count, 1000u);
+    EXPECT_EQ(snapshot.max, 1000us);
+    EXPECT_EQ(snapshot.mean(), 500500ns);
+    auto near = [](std::chrono::nanoseconds actual, std::chrono::nanoseconds expected) {
+        return actual >= expected && actual.count() <= expected.count() * 1.02;
+    };
+    EXPECT_TRUE(near(snapshot.percentile(50.0), 500us)) << snapshot.percentile(50.0).count();
+    EXPECT_TRUE(near(snapshot.percentile(99.0), 990us)) << snapshot.percentile(99.0).count();
+    EXPECT_TRUE(near(snapshot.percentile(99.9), 999us)) << snapshot.percentile(99.9).count();
+    EXPECT_EQ(snapshot.percentile(100.0), 1000us);  // Capped at the maximum
+    EXPECT_TRUE(near(snapshot.percentile(0.0), 1us)) << snapshot.percentile(0.0).count();
+}
+
+TEST(LatencyHistogramTest, SummaryReportsPercentiles) {
+    auto histogram = std::make_unique<LatencyHistogram>();
+    EXPECT_EQ(histogram->snapshot().summary(), "no samples");
+
+    histogram->record(-5us);  // Counts as zero
+    histogram->record(2ms);
+    const HistogramSnapshot snapshot = histogram->snapshot();
+    EXPECT_EQ(snapshot.percentile(50.0).count(), 0);
+    EXPECT_EQ(snapshot.summary(), "p50 0ns p99 2ms p99.9 2ms max 2ms (n=2)");
+}
+
+TEST(LatencyHistogramTest, SnapshotsWhileRecording) {
+    auto histogram = std::make_unique<LatencyHistogram>();
+    constexpr uint64_t SAMPLES = 200000;
+    std::atomic<bool> done{false};
+    std::thread writer([&] {
+        for (uint64_t i = 0; i < SAMPLES; ++i) {
+            histogram->record(std::chrono::nanoseconds(i % 5000));
+        }
+        done = true;
+    });
+
+    uint64_t previous = 0;
+    while (!done) {
+        const HistogramSnapshot snapshot = histogram->snapshot();
+        EXPECT_GE(snapshot.count, previous);
+        previous = snapshot.count;
+    }
+    writer.join();
+    EXPECT_EQ(histogram->snapshot().count, SAMPLES);
+    EXPECT_EQ(histogram->getCount(), SAMPLES);
+}
+
+TEST(LatencyHistogramTest, GeneratorRecordsTickLatencies) {
+    ARINC429Generator generator;
+    generator.setRate(500);
+    generator.start();
+    std::this_thread::sleep_for(100ms);
+    generator.stop();
+
+    const LatencyStats latency = generator.getLatencyStats();
+    EXPECT_EQ(latency.wakeup_lateness.count, generator.getTickCount());
+    EXPECT_EQ(latency.generate_duration.count, generator.getTickCount());
+    EXPECT_GT(latency.sink_latency.count, 0u);
+    EXPECT_LE(latency.sink_latency.count, generator.getTickCount());  // Only ticks with frames
+}
+
+TEST(LatencyHistogramTest, VirtualRunsOnlyRecordGenerateDuration) {
+    ARINC429Generator generator;
+    generator.setClockMode(ClockMode::VIRTUAL);
+    generator.setVirtualDuration(1s);
+    generator.setFrameBufferCapacity(1 << 16);
+    generator.start();
+    while (generator.getState() == GeneratorState::RUNNING) {
+        std::this_thread::sleep_for(1ms);
+    }
+    generator.stop();
+
+    const LatencyStats latency = generator.getLatencyStats();
+    EXPECT_TRUE(latency.wakeup_lateness.empty());
+    EXPECT_TRUE(latency.sink_latency.empty());
+    EXPECT_EQ(latency.generate_duration.count, generator.getTickCount());
+}
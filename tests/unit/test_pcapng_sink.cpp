@@ -0,0 +1,182 @@
+#include <gtest/gtest.h>
+#include "serial_bus_generator/sinks/pcapng_sink.hpp"
+#include "serial_bus_generator/protocols/arinc429/arinc429_message.hpp"
+#include "serial_bus_generator/protocols/canj1939/canj1939_message.hpp"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <unistd.h>
+
+using namespace serial_bus_generator;
+using namespace std::chrono_literals;
+
+namespace {
+
+struct Block {
+    uint32_t type;
+    std::vector<uint8_t> body;  // Between the leading and trailing lengths
+};
+
+uint32_t read32(const uint8_t* p) {
+    uint32_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+uint16_t read16(const uint8_t* p) {
+    uint16_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+std::vector<Block> readBlocks(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    std::vector<uint8_t> file((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    std::vector<Block> blocks;
+    size_t at = 0;
+    while (at + 12 <= file.size()) {
+        const uint32_t length = read32(&file[at + 4]);
+        EXPECT_EQ(length % 4, 0u);
+        EXPECT_LE(at + length, file.size());
+        EXPECT_EQ(read32(&file[at + length - 4]), length) << "Trailing length mismatch";
+        blocks.push_back({read32(&file[at]), std::vector<uint8_t>(&file[at + 8], &file[at + length - 4])});
+        at += length;
+    }
+    EXPECT_EQ(at, file.size());
+    return blocks;
+}
+
+class PcapngSinkTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        path_ = ::testing::TempDir() + "pcapng_test_" + std::to_string(::getpid()) + ".pcapng";
+    }
+
+    void TearDown() override {
+        std::remove(path_.c_str());
+        for (size_t i = 0; i < 64; ++i) {
+            std::remove(PcapngSink::rotatedPath(path_, i).c_str());
+        }
+    }
+
+    std::string path_;
+};
+
+} // namespace
+
+TEST_F(PcapngSinkTest, WritesSocketCanAndArincInterfaces) {
+    const uint64_t ts = 1700000000123456789ull;
+    Frame can = CANJ1939Message::encodeFrame(CANJ1939PGN::ENGINE_SPEED, 1500.0f,
+                                             CANJ1939Priority::PRIORITY_3, ts);
+    Frame word = ARINC429Message::encodeFrame(ARINC429Label::ALTITUDE, 35000.0f, ARINC429SSM::NORMAL_OPERATION, ts + 1);
+    {
+        PcapngSink sink(path_);
+        sink.write(&can, 1);
+        sink.write(&word, 1);
+        EXPECT_EQ(sink.getFrameCount(), 2u);
+    }
+
+    auto blocks = readBlocks(path_);
+    ASSERT_EQ(blocks.size(), 5u);
+    EXPECT_EQ(blocks[0].type, 0x0A0D0D0Au);
+    EXPECT_EQ(read32(blocks[0].body.data()), 0x1A2B3C4Du);
+
+    ASSERT_EQ(blocks[1].type, 1u);
+    EXPECT_EQ(read16(blocks[1].body.data()), PcapngSink::LINKTYPE_CAN_SOCKETCAN);
+    ASSERT_EQ(blocks[2].type, 1u);
+    EXPECT_EQ(read16(blocks[2].body.data()), PcapngSink::LINKTYPE_USER0);
+
+    // J1939 frame as struct can_frame with a big-endian extended identifier
+    const Block& epb = blocks[3];
+    ASSERT_EQ(epb.type, 6u);
+    EXPECT_EQ(read32(&epb.body[0]), PcapngSink::CAN_INTERFACE);
+    const uint64_t stamp = (static_cast<uint64_t>(read32(&epb.body[4])) << 32) | read32(&epb.body[8]);
+    EXPECT_EQ(stamp, ts);
+    ASSERT_EQ(read32(&epb.body[12]), 16u);
+    const uint8_t* packet = &epb.body[20];
+    const uint32_t can_id = (uint32_t{packet[0]} << 24) | (uint32_t{packet[1]} << 16) |
+                            (uint32_t{packet[2]} << 8) | packet[3];
+    EXPECT_EQ(can_id, can.id | PcapngSink::CAN_EFF_FLAG);
+    EXPECT_EQ((can_id >> 8) & 0x3FFFF, static_cast<uint32_t>(CANJ1939PGN::ENGINE_SPEED));
+    EXPECT_EQ((can_id >> 26) & 0x7, 3u);
+    EXPECT_EQ(packet[4], 8u);
+    EXPECT_EQ(std::memcmp(packet + 8, can.data, 8), 0);
+
+    const Block& arinc = blocks[4];
+    ASSERT_EQ(arinc.type, 6u);
+    EXPECT_EQ(read32(&arinc.body[0]), PcapngSink::ARINC429_INTERFACE);
+    ASSERT_EQ(read32(&arinc.body[12]), 4u);
+    EXPECT_EQ(read32(&arinc.body[20]), word.id);
+}
+
+TEST_F(PcapngSinkTest, RotatesBySize) {
+    PcapngOptions options;
+    options.rotate_bytes = 4096;
+    options.buffer_bytes = 1024;
+    Frame can = CANJ1939Message::encodeFrame(CANJ1939PGN::ENGINE_TEMPERATURE, 90.0f,
+                                             CANJ1939Priority::PRIORITY_6, 0);
+    size_t files = 0;
+    {
+        PcapngSink sink(path_, options);
+        for (uint64_t i = 0; i < 500; ++i) {
+            can.timestamp_ns = i * 1000;
+            sink.write(&can, 1);
+        }
+        sink.close();
+        files = sink.getFileCount();
+    }
+    ASSERT_GT(files, 1u);
+
+    size_t frames = 0;
+    for (size_t i = 0; i < files; ++i) {
+        const std::string path = PcapngSink::rotatedPath(path_, i);
+        std::ifstream in(path, std::ios::binary | std::ios::ate);
+        EXPECT_LE(static_cast<uint64_t>(in.tellg()), options.rotate_bytes);
+
+        auto blocks = readBlocks(path);
+        ASSERT_GE(blocks.size(), 3u);
+        EXPECT_EQ(blocks[0].type, 0x0A0D0D0Au) << "Every file starts a new section";
+        frames += blocks.size() - 3;
+    }
+    EXPECT_EQ(frames, 500u);
+}
+
+TEST_F(PcapngSinkTest, RotatesByFrameTime) {
+    PcapngOptions options;
+    options.rotate_interval = 1s;
+    Frame word = ARINC429Message::encodeFrame(ARINC429Label::GROUND_SPEED, 250.0f, ARINC429SSM::NORMAL_OPERATION, 0);
+    {
+        PcapngSink sink(path_, options);
+        for (uint64_t ms = 0; ms < 3500; ms += 100) {
+            word.timestamp_ns = ms * 1000000;
+            sink.write(&word, 1);
+        }
+        sink.flush();
+        EXPECT_EQ(sink.getFileCount(), 4u);
+    }
+    EXPECT_EQ(readBlocks(PcapngSink::rotatedPath(path_, 0)).size(), 3u + 10u);
+    EXPECT_EQ(readBlocks(PcapngSink::rotatedPath(path_, 3)).size(), 3u + 5u);
+}
+
+TEST_F(PcapngSinkTest, OlderFramesDoNotRotate) {
+    PcapngOptions options;
+    options.rotate_interval = 1s;
+    Frame word = ARINC429Message::encodeFrame(ARINC429Label::GROUND_SPEED, 250.0f, ARINC429SSM::NORMAL_OPERATION, 0);
+    {
+        PcapngSink sink(path_, options);
+        // Channels sharing a sink interleave, so a frame can predate the file's first
+        for (uint64_t ms : {500u, 200u, 900u, 100u}) {
+            word.timestamp_ns = ms * 1000000;
+            sink.write(&word, 1);
+        }
+        sink.flush();
+        EXPECT_EQ(sink.getFileCount(), 1u);
+    }
+    EXPECT_EQ(readBlocks(PcapngSink::rotatedPath(path_, 0)).size(), 3u + 4u);
+}
+
+TEST(PcapngSinkPathTest, RotatedPathKeepsExtension) {
+    EXPECT_EQ(PcapngSink::rotatedPath("out/run.pcapng", 3), "out/run_00003.pcapng");
+    EXPECT_EQ(PcapngSink::rotatedPath("out.d/run", 12), "out.d/run_00012");
+}
@@ -0,0 +1,171 @@
+#include <gtest/gtest.h>
+#include "serial_bus_generator/metrics/prometheus_exporter.hpp"
+#include "serial_bus_generator/protocols/arinc429/arinc429_generator.hpp"
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using namespace serial_bus_generator;
+using namespace std::chrono_literals;
+
+namespace {
+
+// Generator with fixed statistics
+class FixedStatsGenerator : public IGenerator {
+public:
+    void start() override {}
+    void stop() override {}
+    void setRate(uint32_t) override {}
+    GeneratorState getState() const override { return GeneratorState::STOPPED; }
+    std::vector<std::unique_ptr<IMessage>> generateMessages(std::chrono::milliseconds) override { return {}; }
+    std::string getLastMessage() override { return ""; }
+    GeneratorStats getStats() const override { return stats; }
+    std::string getLastError() const override { return ""; }
+
+    GeneratorStats stats;
+};
+
+std::string readFile(const std::string& path) {
+    std::ifstream file(path);
+    std::stringstream text;
+    text << file.rdbuf();
+    return text.str();
+}
+
+std::string scrape(const std::string& path) {
+    const int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    std::snprintf(address.sun_path, sizeof(address.sun_path), "%s", path.c_str());
+    if (::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+        ::close(fd);
+        return "";
+    }
+    const std::string request = "GET /metrics HTTP/1.0\r\n\r\n";
+    EXPECT_EQ(::send(fd, request.data(), request.size(), 0), static_cast<ssize_t>(request.size()));
+    std::string response;
+    char buffer[1024];
+    for (ssize_t count; (count = ::recv(fd, buffer, sizeof(buffer), 0)) > 0;) {
+        response.append(buffer, static_cast<size_t>(count));
+    }
+    ::close(fd);
+    return response;
+}
+
+class PrometheusExporterTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        path_ = ::testing::TempDir() + "sbg_metrics_" + std::to_string(::getpid());
+        generator_.stats.channel = 3;
+        generator_.stats.frames = 1500;
+        generator_.stats.ticks = 100;
+        generator_.stats.missed_deadlines = 2;
+        generator_.stats.dropped_frames = 5;
+        generator_.stats.queue_depth = 12;
+        generator_.stats.queue_capacity = 16384;
+        generator_.stats.max_lateness = 250us;
+        generator_.stats.signals = {
+            SignalStats{MessageType::ARINC429, static_cast<uint32_t>(ARINC429Label::LATITUDE), 1000},
+            SignalStats{MessageType::CANJ1939, 61444, 500}};
+    }
+
+    void TearDown() override {
+        std::remove(path_.c_str());
+    }
+
+    std::string path_;
+    FixedStatsGenerator generator_;
+};
+
+} // namespace
+
+TEST_F(PrometheusExporterTest, RendersTextFormat) {
+    PrometheusExporter exporter(path_);
+    exporter.addGenerator(generator_);
+    const std::string text = exporter.render();
+
+    EXPECT_NE(text.find("# TYPE sbg_frames_total counter\nsbg_frames_total{channel=\"3\"} 1500\n"),
+              std::string::npos);
+    EXPECT_NE(text.find("sbg_missed_deadlines_total{channel=\"3\"} 2\n"), std::string::npos);
+    EXPECT_NE(text.find("sbg_dropped_frames_total{channel=\"3\"} 5\n"), std::string::npos);
+    EXPECT_NE(text.find("sbg_queue_depth{channel=\"3\"} 12\n"), std::string::npos);
+    EXPECT_NE(text.find("sbg_tick_lateness_max_seconds{channel=\"3\"} 0.00025\n"), std::string::npos);
+    EXPECT_NE(text.find("sbg_signal_frames_total{channel=\"3\",protocol=\"ARINC429\",signal=\"310\"} 1000\n"),
+              std::string::npos);
+    EXPECT_NE(text.find("sbg_signal_frames_total{channel=\"3\",protocol=\"CANJ1939\",signal=\"61444\"} 500\n"),
+              std::string::npos);
+    EXPECT_NE(text.find("sbg_frames_per_second{channel=\"3\"} 0\n"), std::string::npos);  // No baseline yet
+}
+
+TEST_F(PrometheusExporterTest, RatesFollowTheChangeSinceTheLastExport) {
+    PrometheusExporter exporter(path_);
+    exporter.addGenerator(generator_);
+    exporter.render();
+    generator_.stats.frames += 1000;
+    std::this_thread::sleep_for(50ms);
+    const std::string text = exporter.render();
+
+    const std::string prefix = "sbg_frames_per_second{channel=\"3\"} ";
+    const size_t at = text.find(prefix);
+    ASSERT_NE(at, std::string::npos);
+    const double rate = std::stod(text.substr(at + prefix.size()));
+    EXPECT_GT(rate, 0.0);
+    EXPECT_LE(rate, 1000.0 / 0.05);
+}
+
+TEST_F(PrometheusExporterTest, WritesFileTarget) {
+    PrometheusExporter exporter(path_, 10ms);
+    exporter.addGenerator(generator_);
+    exporter.start();
+    std::this_thread::sleep_for(50ms);
+    EXPECT_THROW(exporter.addGenerator(generator_), std::logic_error);
+    exporter.stop();
+
+    EXPECT_GT(exporter.getExportCount(), 1u);
+    EXPECT_TRUE(exporter.getLastError().empty());
+    EXPECT_NE(readFile(path_).find("sbg_frames_total{channel=\"3\"} 1500"), std::string::npos);
+    EXPECT_FALSE(std::ifstream(path_ + ".tmp").good());
+}
+
+TEST_F(PrometheusExporterTest, ServesSocketScrapes) {
+    PrometheusExporter exporter(PrometheusExporter::SOCKET_PREFIX + path_);
+    exporter.addGenerator(generator_);
+    exporter.start();
+    const std::string response = scrape(path_);
+    exporter.stop();
+
+    EXPECT_EQ(response.rfind("HTTP/1.0 200 OK\r\n", 0), 0u);
+    EXPECT_NE(response.find("sbg_ticks_total{channel=\"3\"} 100\n"), std::string::npos);
+    EXPECT_EQ(exporter.getExportCount(), 1u);
+    EXPECT_THROW(exporter.exportNow(), std::logic_error);
+    EXPECT_NE(::access(path_.c_str(), F_OK), 0);  // Socket removed on stop
+}
+
+TEST_F(PrometheusExporterTest, ExportsLiveGenerator) {
+    ARINC429Generator generator;
+    generator.setChannel(1);
+    generator.setRate(200);
+    PrometheusExporter exporter(path_);
+    exporter.addGenerator(generator);
+    generator.start();
+    std::this_thread::sleep_for(50ms);
+    exporter.exportNow();
+    generator.stop();
+
+    const std::string text = readFile(path_);
+    EXPECT_NE(text.find("sbg_signal_frames_total{channel=\"1\",protocol=\"ARINC429\",signal=\"310\"}"),
+              std::string::npos);
+}
+
+TEST(PrometheusExporterTargetTest, RejectsInvalidTargets) {
+    EXPECT_THROW(PrometheusExporter(""), std::invalid_argument);
+    EXPECT_THROW(PrometheusExporter("unix:"), std::invalid_argument);
+    EXPECT_THROW(PrometheusExporter("metrics.prom", 0ms), std::invalid_argument);
+    PrometheusExporter exporter("unix:/" + std::string(200, 'x'));
+    EXPECT_THROW(exporter.start(), std::invalid_argument);
+}
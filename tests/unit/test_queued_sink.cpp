@@ -0,0 +1,362 @@
+#include <gtest/gtest.h>
+#include "serial_bus_generator/sinks/queued_sink.hpp"
+#include "serial_bus_generator/protocols/arinc429/arinc429_generator.hpp"
+#include "serial_bus_generator/protocols/arinc429/arinc429_message.hpp"
+#include "serial_bus_generator/protocols/canj1939/canj1939_message.hpp"
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <thread>
+
+using namespace serial_bus_generator;
+using namespace std::chrono_literals;
+
+namespace {
+
+// Records frames; holds writes while the gate is closed, like a stalled consumer
+class GatedSink : public IFrameSink {
+public:
+    void write(const Frame* frames, size_t count) override {
+        std::unique_lock<std::mutex> lock(mutex);
+        ++writes_entered;
+        while (!open) {
+            cv.wait_for(lock, 1ms);
+        }
+        received.insert(received.end(), frames, frames + count);
+    }
+
+    void flush() override {
+        std::lock_guard<std::mutex> lock(mutex);
+        ++flushes;
+    }
+
+    void setOpen(bool value) {
+        std::lock_guard<std::mutex> lock(mutex);
+        open = value;
+    }
+
+    // Waits until the queue's thread is stuck in a write
+    void waitForWrite(int writes) {
+        for (;;) {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (writes_entered >= writes) {
+                    return;
+                }
+            }
+            std::this_thread::sleep_for(1ms);
+        }
+    }
+
+    std::vector<uint64_t> sequence() {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::vector<uint64_t> result;
+        for (const Frame& frame : received) {
+            result.push_back(frame.timestamp_ns);
+        }
+        return result;
+    }
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool open{true};
+    int writes_entered{0};
+    int flushes{0};
+    std::vector<Frame> received;
+};
+
+class ThrowingSink : public IFrameSink {
+public:
+    void write(const Frame*, size_t) override { throw std::runtime_error("disk full"); }
+};
+
+Frame arincFrame(ARINC429Label label, float value, uint64_t timestamp_ns = 0) {
+    return ARINC429Message::encodeFrame(label, value, ARINC429SSM::NORMAL_OPERATION, timestamp_ns);
+}
+
+// Frame n of a sequence, told apart by its timestamp
+Frame numberedFrame(uint64_t n) {
+    return arincFrame(ARINC429Label::GROUND_SPEED, 250.0f, n);
+}
+
+// Queue of four behind a sink that is stalled on frame 1
+std::shared_ptr<QueuedSink> stalledQueue(const std::shared_ptr<GatedSink>& sink, OverrunPolicy policy) {
+    sink->setOpen(false);
+    auto queue = std::make_shared<QueuedSink>(sink, QueuedSinkOptions{policy, 4});
+    const Frame first = numberedFrame(1);
+    queue->write(&first, 1);
+    sink->waitForWrite(1);
+    return queue;
+}
+
+void writeSequence(QueuedSink& queue, uint64_t from, uint64_t to) {
+    for (uint64_t n = from; n <= to; ++n) {
+        const Frame frame = numberedFrame(n);
+        queue.write(&frame, 1);
+    }
+}
+
+} // namespace
+
+TEST(QueuedSinkTest, DeliversFramesInOrder) {
+    auto sink = std::make_shared<GatedSink>();
+    QueuedSink queue(sink, QueuedSinkOptions{OverrunPolicy::DROP_NEWEST, 1024});
+    std::vector<Frame> frames;
+    for (uint64_t n = 0; n < 1000; ++n) {
+        frames.push_back(numberedFrame(n));
+    }
+    queue.write(frames.data(), frames.size());
+    queue.flush();
+
+    ASSERT_EQ(sink->received.size(), 1000u);
+    for (uint64_t n = 0; n < 1000; ++n) {
+        ASSERT_EQ(sink->received[n].timestamp_ns, n);
+    }
+    EXPECT_EQ(sink->flushes, 1);
+    const QueuedSinkStats stats = queue.getStats();
+    EXPECT_EQ(stats.written, 1000u);
+    EXPECT_EQ(stats.dropped(), 0u);
+    EXPECT_EQ(stats.queue_depth, 0u);
+    EXPECT_GE(stats.max_queue_depth, 1000u - QueuedSink::MAX_BATCH);
+}
+
+TEST(QueuedSinkTest, DropNewestKeepsTheQueuedFrames) {
+    auto sink = std::make_shared<GatedSink>();
+    auto queue = stalledQueue(sink, OverrunPolicy::DROP_NEWEST);
+    writeSequence(*queue, 2, 7);  // Room for 2..5
+    sink->setOpen(true);
+    queue->flush();
+
+    EXPECT_EQ(sink->sequence(), (std::vector<uint64_t>{1, 2, 3, 4, 5}));
+    const QueuedSinkStats stats = queue->getStats();
+    EXPECT_EQ(stats.written, 5u);
+    EXPECT_EQ(stats.dropped_newest, 2u);
+    EXPECT_EQ(stats.dropped_oldest, 0u);
+    EXPECT_EQ(stats.max_queue_depth, 4u);
+}
+
+TEST(QueuedSinkTest, DropOldestKeepsTheLatestFrames) {
+    auto sink = std::make_shared<GatedSink>();
+    auto queue = stalledQueue(sink, OverrunPolicy::DROP_OLDEST);
+    writeSequence(*queue, 2, 9);
+    sink->setOpen(true);
+    queue->flush();
+
+    EXPECT_EQ(sink->sequence(), (std::vector<uint64_t>{1, 6, 7, 8, 9}));
+    EXPECT_EQ(queue->getStats().dropped_oldest, 4u);
+    EXPECT_EQ(queue->getStats().dropped_newest, 0u);
+}
+
+TEST(QueuedSinkTest, BlockWaitsForRoom) {
+    auto sink = std::make_shared<GatedSink>();
+    auto queue = stalledQueue(sink, OverrunPolicy::BLOCK);
+    writeSequence(*queue, 2, 5);
+
+    std::atomic<bool> returned{false};
+    std::thread writer([&] {
+        writeSequence(*queue, 6, 6);
+        returned = true;
+    });
+    std::this_thread::sleep_for(50ms);
+    EXPECT_FALSE(returned);
+    sink->setOpen(true);
+    writer.join();
+    queue->flush();
+
+    EXPECT_EQ(sink->sequence(), (std::vector<uint64_t>{1, 2, 3, 4, 5, 6}));
+    const QueuedSinkStats stats = queue->getStats();
+    EXPECT_EQ(stats.blocked_writes, 1u);
+    EXPECT_EQ(stats.dropped(), 0u);
+}
+
+TEST(QueuedSinkTest, CoalesceKeepsTheLatestValuePerSignal) {
+    auto sink = std::make_shared<GatedSink>();
+    auto queue = stalledQueue(sink, OverrunPolicy::COALESCE);
+
+    // Two labels, then five more values of each. The values differ in bits
+    // 8 and 9 too, which are data rather than an SDI in these words.
+    for (int value = 0; value < 6; ++value) {
+        for (ARINC429Label label : {ARINC429Label::LATITUDE, ARINC429Label::LONGITUDE}) {
+            const Frame frame = arincFrame(label, static_cast<float>(value));
+            queue->write(&frame, 1);
+        }
+    }
+    const Frame altitude = arincFrame(ARINC429Label::ALTITUDE, 3500.0f);
+    queue->write(&altitude, 1);
+    sink->setOpen(true);
+    queue->flush();
+
+    ASSERT_EQ(sink->received.size(), 4u);
+    const ARINC429Message latitude(sink->received[1]);
+    EXPECT_EQ(latitude.getLabel(), ARINC429Label::LATITUDE);
+    EXPECT_NEAR(latitude.getDecodedValue(), 5.0f, 0.01f);
+    const ARINC429Message longitude(sink->received[2]);
+    EXPECT_EQ(longitude.getLabel(), ARINC429Label::LONGITUDE);
+    EXPECT_NEAR(longitude.getDecodedValue(), 5.0f, 0.01f);
+    EXPECT_EQ(ARINC429Message(sink->received[3]).getLabel(), ARINC429Label::ALTITUDE);
+    EXPECT_EQ(queue->getStats().coalesced, 10u);
+}
+
+TEST(QueuedSinkTest, CoalescesOnlyWhenFull) {
+    auto sink = std::make_shared<GatedSink>();
+    sink->setOpen(false);
+    QueuedSink queue(sink, QueuedSinkOptions{OverrunPolicy::COALESCE, 16});
+    for (int value = 0; value < 8; ++value) {
+        const Frame frame = arincFrame(ARINC429Label::LATITUDE, static_cast<float>(value));
+        queue.write(&frame, 1);
+    }
+    sink->setOpen(true);
+    queue.flush();
+
+    // A sink that is only a little behind still gets every value
+    ASSERT_EQ(sink->received.size(), 8u);
+    EXPECT_NEAR(ARINC429Message(sink->received[7]).getDecodedValue(), 7.0f, 0.01f);
+    EXPECT_EQ(queue.getStats().coalesced, 0u);
+}
+
+TEST(QueuedSinkTest, CoalesceKeepsTimestampsInOrder) {
+    auto sink = std::make_shared<GatedSink>();
+    auto queue = stalledQueue(sink, OverrunPolicy::COALESCE);
+
+    // Three signals at different rates, stamped in write order
+    constexpr ARINC429Label LABELS[] = {ARINC429Label::LATITUDE, ARINC429Label::LONGITUDE,
+                                        ARINC429Label::LATITUDE, ARINC429Label::ALTITUDE,
+                                        ARINC429Label::LATITUDE, ARINC429Label::LONGITUDE};
+    constexpr uint64_t WRITES = 60;
+    for (uint64_t i = 0; i < WRITES; ++i) {
+        const Frame frame = arincFrame(LABELS[i % 6], static_cast<float>(i % 7), 1000 + i);
+        queue->write(&frame, 1);
+    }
+    sink->setOpen(true);
+    queue->flush();
+
+    const std::vector<Frame>& received = sink->received;
+    ASSERT_GE(received.size(), 4u);
+    for (size_t i = 2; i < received.size(); ++i) {
+        EXPECT_LT(received[i - 1].timestamp_ns, received[i].timestamp_ns) << i;
+    }
+    // Each signal's last value survives
+    std::map<ARINC429Label, uint64_t> last;
+    for (const Frame& frame : received) {
+        last[ARINC429Message(frame).getLabel()] = frame.timestamp_ns;
+    }
+    EXPECT_EQ(last[ARINC429Label::LATITUDE], 1000 + 58u);
+    EXPECT_EQ(last[ARINC429Label::LONGITUDE], 1000 + 59u);
+    EXPECT_EQ(last[ARINC429Label::ALTITUDE], 1000 + 57u);
+    EXPECT_EQ(queue->getStats().coalesced + queue->getStats().dropped_newest, WRITES + 1 - received.size());
+}
+
+TEST(QueuedSinkTest, CoalesceReplacesTheSignalsOwnFrame) {
+    auto sink = std::make_shared<GatedSink>();
+    auto queue = stalledQueue(sink, OverrunPolicy::COALESCE);
+
+    // Four signals fill the queue, so each new value can only replace its
+    // own signal's queued frame; far more rounds than the queue holds
+    constexpr ARINC429Label LABELS[] = {ARINC429Label::LATITUDE, ARINC429Label::LONGITUDE,
+                                        ARINC429Label::ALTITUDE, ARINC429Label::TRACK_HEADING};
+    constexpr uint64_t ROUNDS = 100;
+    uint64_t timestamp = 2;
+    for (uint64_t round = 0; round < ROUNDS; ++round) {
+        for (ARINC429Label label : LABELS) {
+            const Frame frame = arincFrame(label, static_cast<float>(round % 50), timestamp++);
+            queue->write(&frame, 1);
+        }
+    }
+    sink->setOpen(true);
+    queue->flush();
+
+    ASSERT_EQ(sink->received.size(), 5u);
+    for (size_t i = 1; i < 5; ++i) {
+        const ARINC429Message message(sink->received[i]);
+        EXPECT_EQ(message.getLabel(), LABELS[i - 1]);
+        EXPECT_NEAR(message.getDecodedValue(), static_cast<float>((ROUNDS - 1) % 50), 0.01f);
+        EXPECT_EQ(sink->received[i].timestamp_ns, timestamp - 5 + i);
+    }
+    const QueuedSinkStats stats = queue->getStats();
+    EXPECT_EQ(stats.coalesced, (ROUNDS - 1) * 4);
+    EXPECT_EQ(stats.dropped_newest, 0u);
+    EXPECT_EQ(stats.max_queue_depth, 4u);
+}
+
+TEST(QueuedSinkTest, CoalesceNeverMergesTransportPackets) {
+    auto sink = std::make_shared<GatedSink>();
+    auto queue = stalledQueue(sink, OverrunPolicy::COALESCE);
+
+    Frame packet;
+    packet.type = MessageType::CANJ1939;
+    packet.id = (7u << 26) | (static_cast<uint32_t>(CANJ1939PGN::TP_DT) << 8) | 0x00;
+    packet.dlc = 8;
+    Frame engine = CANJ1939Message::encodeFrame(CANJ1939PGN::ENGINE_TEMPERATURE, 90.0f,
+                                                CANJ1939Priority::PRIORITY_6, 0);
+    for (int i = 0; i < 3; ++i) {
+        packet.data[0] = static_cast<uint8_t>(i + 1);
+        queue->write(&packet, 1);
+        queue->write(&engine, 1);
+    }
+    sink->setOpen(true);
+    queue->flush();
+
+    // The engine temperature gives way twice; every packet is kept, in order
+    ASSERT_EQ(sink->received.size(), 5u);
+    EXPECT_EQ(sink->received[1].data[0], 1);
+    EXPECT_EQ(sink->received[2].data[0], 2);
+    EXPECT_EQ(sink->received[3].data[0], 3);
+    EXPECT_EQ(sink->received[4].id, engine.id);
+    EXPECT_EQ(queue->getStats().coalesced, 2u);
+}
+
+TEST(QueuedSinkTest, CountsFramesTheSinkThrowsOn) {
+    QueuedSink queue(std::make_shared<ThrowingSink>());
+    writeSequence(queue, 1, 3);
+    queue.flush();
+    EXPECT_EQ(queue.getStats().failed, 3u);
+    EXPECT_EQ(queue.getStats().written, 0u);
+    EXPECT_EQ(queue.getLastError(), "disk full");
+}
+
+TEST(QueuedSinkTest, CloseDeliversWhatIsQueued) {
+    auto sink = std::make_shared<GatedSink>();
+    {
+        QueuedSink queue(sink);
+        writeSequence(queue, 1, 100);
+    }
+    EXPECT_EQ(sink->received.size(), 100u);
+    EXPECT_EQ(sink->flushes, 1);
+
+    QueuedSink closed(sink);
+    closed.close();
+    const Frame frame = numberedFrame(1);
+    EXPECT_THROW(closed.write(&frame, 1), std::logic_error);
+}
+
+TEST(QueuedSinkTest, RejectsInvalidOptions) {
+    EXPECT_THROW(QueuedSink(nullptr), std::invalid_argument);
+    EXPECT_THROW(QueuedSink(std::make_shared<GatedSink>(), QueuedSinkOptions{OverrunPolicy::BLOCK, 0}),
+                 std::invalid_argument);
+    EXPECT_EQ(QueuedSink::parsePolicy("drop-oldest"), OverrunPolicy::DROP_OLDEST);
+    EXPECT_STREQ(QueuedSink::policyName(OverrunPolicy::COALESCE), "coalesce");
+    EXPECT_THROW(QueuedSink::parsePolicy("latest"), std::invalid_argument);
+}
+
+TEST(QueuedSinkTest, StalledSinkDoesNotHoldUpGeneration) {
+    auto stalled = std::make_shared<GatedSink>();
+    stalled->setOpen(false);
+    auto queue = std::make_shared<QueuedSink>(stalled, QueuedSinkOptions{OverrunPolicy::DROP_OLDEST, 8});
+    auto direct = std::make_shared<GatedSink>();
+
+    ARINC429Generator generator;
+    generator.setRate(200);
+    generator.addSink(queue);
+    generator.addSink(direct);
+    generator.start();
+    std::this_thread::sleep_for(200ms);
+    stalled->setOpen(true);  // So stop() can flush it
+    generator.stop();
+
+    // The other sink kept receiving every tick while the queue overflowed
+    EXPECT_GT(generator.getTickCount(), 20u);
+    EXPECT_EQ(direct->received.size(), generator.getStats().frames);
+    const QueuedSinkStats stats = queue->getStats();
+    EXPECT_GT(stats.dropped_oldest, 0u);
+    EXPECT_EQ(stats.written + stats.dropped_oldest, generator.getStats().frames);
+}
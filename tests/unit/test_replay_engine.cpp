@@ -0,0 +1,221 @@
+#include <gtest/gtest.h>
+#include "serial_bus_generator/capture/capture_writer.hpp"
+#include "serial_bus_generator/capture/replay_engine.hpp"
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <unistd.h>
+
+using namespace serial_bus_generator;
+using namespace std::chrono_literals;
+
+namespace {
+
+class RecordingSink : public IFrameSink {
+public:
+    void write(const Frame* frames, size_t count) override {
+        const auto now = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < count; ++i) {
+            frames_.push_back(frames[i]);
+            arrivals_.push_back(now);
+        }
+    }
+    void flush() override { ++flushes_; }
+
+    std::vector<Frame> frames_;
+    std::vector<std::chrono::steady_clock::time_point> arrivals_;
+    int flushes_{0};
+};
+
+class ReplayEngineTest : public ::testing::Test {
+protected:
+    static constexpr uint64_t EPOCH = 1700000000000000000ull;
+
+    void SetUp() override {
+        path_ = ::testing::TempDir() + "replay_test_" + std::to_string(::getpid()) + ".sbgcap";
+    }
+
+    void TearDown() override {
+        std::remove(path_.c_str());
+    }
+
+    // count frames spaced 'spacing' apart, in small blocks
+    void record(size_t count, std::chrono::nanoseconds spacing) {
+        CaptureWriter writer(path_, {}, 8);
+        for (size_t i = 0; i < count; ++i) {
+            Frame frame;
+            frame.timestamp_ns = EPOCH + i * static_cast<uint64_t>(spacing.count());
+            frame.id = static_cast<uint32_t>(i);
+            writer.write(&frame, 1);
+        }
+    }
+
+    std::string path_;
+};
+
+} // namespace
+
+TEST_F(ReplayEngineTest, KeepsRecordedTiming) {
+    record(21, 10ms);  // 200ms of traffic
+    ReplayEngine replay(path_);
+    auto sink = std::make_shared<RecordingSink>();
+    replay.addSink(sink);
+
+    replay.run();
+
+    ASSERT_EQ(sink->frames_.size(), 21u);
+    EXPECT_EQ(replay.getReplayedFrames(), 21u);
+    EXPECT_EQ(sink->flushes_, 1);
+    const auto start = sink->arrivals_.front();
+    for (size_t i = 0; i < sink->frames_.size(); ++i) {
+        EXPECT_EQ(sink->frames_[i].id, i);
+        EXPECT_EQ(sink->frames_[i].timestamp_ns, EPOCH + i * 10000000u) << "Timestamps are kept by default";
+        EXPECT_GE(sink->arrivals_[i] - start, std::chrono::milliseconds(10 * static_cast<int>(i) - 1)) << "Frame " << i << " left early";
+    }
+    EXPECT_LT(sink->arrivals_.back() - start, 400ms);
+}
+
+TEST_F(ReplayEngineTest, ScalesSpeed) {
+    record(21, 10ms);
+    ReplayOptions options;
+    options.speed = 10.0;
+    ReplayEngine replay(path_, options);
+    auto sink = std::make_shared<RecordingSink>();
+    replay.addSink(sink);
+
+    replay.run();
+
+    ASSERT_EQ(sink->frames_.size(), 21u);
+    const auto span = sink->arrivals_.back() - sink->arrivals_.front();
+    EXPECT_GE(span, 19ms);
+    EXPECT_LT(span, 150ms);
+}
+
+TEST_F(ReplayEngineTest, AsFastAsPossible) {
+    record(20000, 1s);  // More than five hours of recorded time
+    ReplayOptions options;
+    options.speed = 0.0;
+    ReplayEngine replay(path_, options);
+    auto sink = std::make_shared<RecordingSink>();
+    replay.addSink(sink);
+
+    const auto start = std::chrono::steady_clock::now();
+    replay.start();
+    while (replay.getState() == GeneratorState::RUNNING) {
+        std::this_thread::sleep_for(1ms);
+    }
+    replay.stop();
+
+    EXPECT_LT(std::chrono::steady_clock::now() - start, 10s);
+    ASSERT_EQ(sink->frames_.size(), 20000u);
+    EXPECT_EQ(sink->frames_.back().id, 19999u);
+}
+
+TEST_F(ReplayEngineTest, ReplaysTimeRange) {
+    record(1000, 1ms);
+    ReplayOptions options;
+    options.speed = 0.0;
+    options.begin_ns = EPOCH + 500 * 1000000ull;
+    options.end_ns = EPOCH + 600 * 1000000ull;
+    ReplayEngine replay(path_, options);
+    auto sink = std::make_shared<RecordingSink>();
+    replay.addSink(sink);
+
+    replay.run();
+
+    ASSERT_EQ(sink->frames_.size(), 100u);
+    EXPECT_EQ(sink->frames_.front().id, 500u);
+    EXPECT_EQ(sink->frames_.back().id, 599u);
+}
+
+TEST_F(ReplayEngineTest, RestampsOntoReplayTimeline) {
+    record(5, 1ms);
+    ReplayOptions options;
+    options.speed = 0.0;
+    options.restamp = true;
+    ReplayEngine replay(path_, options);
+    auto sink = std::make_shared<RecordingSink>();
+    replay.addSink(sink);
+
+    const uint64_t before = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+    replay.run();
+
+    ASSERT_EQ(sink->frames_.size(), 5u);
+    EXPECT_GE(sink->frames_[0].timestamp_ns, before);
+    for (size_t i = 1; i < 5; ++i) {
+        EXPECT_EQ(sink->frames_[i].timestamp_ns - sink->frames_[0].timestamp_ns, i * 1000000u);
+    }
+}
+
+TEST_F(ReplayEngineTest, RestampsOlderRecordsOntoTheStart) {
+    {
+        // Channels sharing a capture interleave, so a record can predate the first
+        CaptureWriter writer(path_, {}, 8);
+        for (uint64_t ms : {5u, 2u, 7u}) {
+            Frame frame;
+            frame.timestamp_ns = EPOCH + ms * 1000000;
+            writer.write(&frame, 1);
+        }
+    }
+    ReplayOptions options;
+    options.speed = 0.0;
+    options.restamp = true;
+    ReplayEngine replay(path_, options);
+    auto sink = std::make_shared<RecordingSink>();
+    replay.addSink(sink);
+    replay.run();
+
+    ASSERT_EQ(sink->frames_.size(), 3u);
+    EXPECT_EQ(sink->frames_[1].timestamp_ns, sink->frames_[0].timestamp_ns);
+    EXPECT_EQ(sink->frames_[2].timestamp_ns - sink->frames_[0].timestamp_ns, 2000000u);
+}
+
+TEST_F(ReplayEngineTest, StopsEarly) {
+    record(100, 100ms);  // 10 seconds at 1x
+    ReplayEngine replay(path_);
+    auto sink = std::make_shared<RecordingSink>();
+    replay.addSink(sink);
+
+    replay.start();
+    std::this_thread::sleep_for(150ms);
+    replay.stop();
+
+    EXPECT_EQ(replay.getState(), GeneratorState::STOPPED);
+    EXPECT_GE(sink->frames_.size(), 1u);
+    EXPECT_LT(sink->frames_.size(), 100u);
+}
+
+TEST_F(ReplayEngineTest, StopsDuringALongGap) {
+    record(2, 10s);  // 100 seconds apart at 0.1x
+    ReplayOptions options;
+    options.speed = 0.1;
+    ReplayEngine replay(path_, options);
+    auto sink = std::make_shared<RecordingSink>();
+    replay.addSink(sink);
+
+    replay.start();
+    std::this_thread::sleep_for(50ms);
+    const auto stop_start = std::chrono::steady_clock::now();
+    replay.stop();
+
+    EXPECT_LT(std::chrono::steady_clock::now() - stop_start, 1s);
+    EXPECT_EQ(replay.getState(), GeneratorState::STOPPED);
+    EXPECT_EQ(sink->frames_.size(), 1u);
+}
+
+TEST_F(ReplayEngineTest, RejectsInvalidOptions) {
+    record(1, 1ms);
+    ReplayOptions options;
+    options.speed = 1000.0;
+    EXPECT_THROW(ReplayEngine(path_, options), std::invalid_argument);
+    options.speed = 0.05;
+    EXPECT_THROW(ReplayEngine(path_, options), std::invalid_argument);
+    options.speed = 1.0;
+    options.begin_ns = 10;
+    options.end_ns = 10;
+    EXPECT_THROW(ReplayEngine(path_, options), std::invalid_argument);
+
+    ReplayEngine replay(path_);
+    EXPECT_THROW(replay.addSink(nullptr), std::invalid_argument);
+}
@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+#include "serial_bus_generator/sinks/socketcan_sink.hpp"
+#include "serial_bus_generator/protocols/arinc429/arinc429_message.hpp"
+#include "serial_bus_generator/protocols/canj1939/canj1939_message.hpp"
+#include <cstring>
+#include <linux/can.h>
+#include <sys/socket.h>
+#include <system_error>
+#include <unistd.h>
+
+using namespace serial_bus_generator;
+using namespace std::chrono_literals;
+
+namespace {
+
+std::vector<Frame> makeFrames(size_t count) {
+    std::vector<Frame> frames;
+    for (size_t i = 0; i < count; ++i) {
+        frames.push_back(CANJ1939Message::encodeFrame(CANJ1939PGN::ENGINE_SPEED, static_cast<float>(i),
+                                                      CANJ1939Priority::PRIORITY_3, i));
+    }
+    return frames;
+}
+
+} // namespace
+
+TEST(SocketCanSinkTest, BuildsExtendedCanFrame) {
+    Frame frame = CANJ1939Message::encodeFrame(CANJ1939PGN::ENGINE_TEMPERATURE, 90.0f,
+                                               CANJ1939Priority::PRIORITY_6, 0);
+    can_frame can;
+    SocketCanSink::toCanFrame(frame, reinterpret_cast<uint8_t*>(&can));
+
+    EXPECT_TRUE(can.can_id & CAN_EFF_FLAG);
+    EXPECT_EQ(can.can_id & CAN_EFF_MASK, frame.id);
+    EXPECT_EQ((can.can_id >> 26) & 0x7, 6u);
+    EXPECT_EQ((can.can_id >> 8) & 0x3FFFF, static_cast<uint32_t>(CANJ1939PGN::ENGINE_TEMPERATURE));
+    EXPECT_EQ(can.can_id & 0xFF, 0xFEu);  // Source address
+    EXPECT_EQ(can.can_dlc, 8u);
+    EXPECT_EQ(std::memcmp(can.data, frame.data, 8), 0);
+}
+
+TEST(SocketCanSinkTest, SendsTicksInBatches) {
+    int sockets[2];
+    ASSERT_EQ(::socketpair(AF_UNIX, SOCK_DGRAM, 0, sockets), 0);
+    int receive_buffer = 1 << 20;
+    ::setsockopt(sockets[1], SOL_SOCKET, SO_RCVBUF, &receive_buffer, sizeof(receive_buffer));
+
+    SocketCanSink sink(sockets[0]);
+    auto frames = makeFrames(150);
+    frames.push_back(ARINC429Message::encodeFrame(ARINC429Label::ALTITUDE, 1000.0f, ARINC429SSM::NORMAL_OPERATION, 0));
+    sink.write(frames.data(), frames.size());
+
+    EXPECT_EQ(sink.getSentFrames(), 150u) << "Only J1939 frames go on the bus";
+    EXPECT_EQ(sink.getSendCalls(), 3u);  // 64 + 64 + 22
+    EXPECT_EQ(sink.getDroppedFrames(), 0u);
+
+    for (size_t i = 0; i < 150; ++i) {
+        can_frame can{};
+        ASSERT_EQ(::recv(sockets[1], &can, sizeof(can), MSG_DONTWAIT), static_cast<ssize_t>(sizeof(can)));
+        EXPECT_EQ(can.can_id, frames[i].id | CAN_EFF_FLAG);
+        EXPECT_EQ(std::memcmp(can.data, frames[i].data, 8), 0);
+    }
+    ::close(sockets[1]);
+}
+
+TEST(SocketCanSinkTest, CountsBackpressureAndDrops) {
+    int sockets[2];
+    ASSERT_EQ(::socketpair(AF_UNIX, SOCK_DGRAM, 0, sockets), 0);
+
+    // Nobody reads the other end, so the queue fills up
+    SocketCanSink sink(sockets[0], 1ms);
+    auto frames = makeFrames(20000);
+    const auto start = std::chrono::steady_clock::now();
+    sink.write(frames.data(), frames.size());
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+
+    // One stall per tick: once the send timeout passes, the rest of the tick is dropped
+    EXPECT_EQ(sink.getBackpressureEvents(), 1u);
+    EXPECT_GT(sink.getDroppedFrames(), 0u);
+    EXPECT_EQ(sink.getSentFrames() + sink.getDroppedFrames(), frames.size());
+    EXPECT_LT(elapsed, 100ms);
+
+    // The next tick finds the queue still full
+    const uint64_t sent = sink.getSentFrames();
+    sink.write(frames.data(), frames.size());
+    EXPECT_EQ(sink.getBackpressureEvents(), 2u);
+    EXPECT_EQ(sink.getSentFrames(), sent);
+    EXPECT_EQ(sink.getDroppedFrames(), 2 * frames.size() - sent);
+    ::close(sockets[1]);
+}
+
+TEST(SocketCanSinkTest, TransmitsOnVcan) {
+    std::unique_ptr<SocketCanSink> sink;
+    try {
+        sink = std::make_unique<SocketCanSink>("vcan0");
+    } catch (const std::system_error&) {
+        GTEST_SKIP() << "vcan0 is not available";
+    }
+    auto frames = makeFrames(32);
+    sink->write(frames.data(), frames.size());
+    EXPECT_EQ(sink->getSentFrames() + sink->getDroppedFrames(), frames.size());
+}
+
+TEST(SocketCanSinkTest, RejectsBadInterfaces) {
+    EXPECT_THROW(SocketCanSink(""), std::invalid_argument);
+    EXPECT_THROW(SocketCanSink(-1), std::invalid_argument);
+}
@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+#include "serial_bus_generator/core/spsc_ring.hpp"
+#include "serial_bus_generator/messages/frame.hpp"
+#include <thread>
+#include <vector>
+
+using namespace serial_bus_generator;
+
+class SpscRingTest : public ::testing::Test {
+protected:
+    SpscRing<uint64_t> ring{8};
+};
+
+TEST_F(SpscRingTest, CapacityRoundsUp) {
+    SpscRing<uint64_t> odd(100);
+    EXPECT_EQ(odd.capacity(), 128u);
+    EXPECT_THROW(SpscRing<uint64_t>(0), std::invalid_argument);
+}
+
+TEST_F(SpscRingTest, FifoAndFull) {
+    for (uint64_t i = 0; i < 8; ++i) {
+        EXPECT_TRUE(ring.tryPush(i));
+    }
+    EXPECT_FALSE(ring.tryPush(99)) << "Push into a full ring must fail";
+    EXPECT_EQ(ring.size(), 8u);
+
+    uint64_t value = 0;
+    for (uint64_t i = 0; i < 8; ++i) {
+        ASSERT_TRUE(ring.tryPop(value));
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_FALSE(ring.tryPop(value));
+    EXPECT_TRUE(ring.empty());
+}
+
+TEST_F(SpscRingTest, BulkWrapAround) {
+    uint64_t out[8];
+    uint64_t next = 0;
+    uint64_t expected = 0;
+    for (int round = 0; round < 10; ++round) {
+        uint64_t in[5];
+        for (auto& v : in) {
+            v = next++;
+        }
+        ASSERT_EQ(ring.tryPush(in, 5), 5u);
+        size_t n = ring.tryPop(out, 8);
+        ASSERT_EQ(n, 5u);
+        for (size_t i = 0; i < n; ++i) {
+            EXPECT_EQ(out[i], expected++);
+        }
+    }
+
+    uint64_t many[12] = {};
+    EXPECT_EQ(ring.tryPush(many, 12), 8u) << "Bulk push stops when full";
+}
+
+TEST_F(SpscRingTest, ConcurrentProducerConsumer) {
+    constexpr uint64_t COUNT = 1000000;
+    SpscRing<Frame> frames(1024);
+
+    std::thread producer([&] {
+        Frame frame;
+        for (uint64_t i = 0; i < COUNT; ++i) {
+            frame.timestamp_ns = i;
+            while (!frames.tryPush(frame)) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    std::vector<Frame> batch(256);
+    uint64_t expected = 0;
+    while (expected < COUNT) {
+        size_t n = frames.tryPop(batch.data(), batch.size());
+        for (size_t i = 0; i < n; ++i) {
+            ASSERT_EQ(batch[i].timestamp_ns, expected++);
+        }
+        if (n == 0) {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+}
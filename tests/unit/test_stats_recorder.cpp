@@ -0,0 +1,188 @@
+#include <gtest/gtest.h>
+#include "serial_bus_generator/metrics/stats_recorder.hpp"
+#include "serial_bus_generator/protocols/arinc429/arinc429_generator.hpp"
+#include "serial_bus_generator/protocols/canj1939/canj1939_generator.hpp"
+#include <atomic>
+#include <numeric>
+#include <thread>
+
+using namespace serial_bus_generator;
+using namespace std::chrono_literals;
+
+namespace {
+
+Frame j1939Frame(uint32_t pgn_field, uint8_t source = 0x00) {
+    Frame frame;
+    frame.type = MessageType::CANJ1939;
+    frame.id = (6u << 26) | (pgn_field << 8) | source;
+    frame.dlc = 8;
+    return frame;
+}
+
+const SignalStats* findSignal(const GeneratorStats& stats, MessageType type, uint32_t key) {
+    for (const SignalStats& signal : stats.signals) {
+        if (signal.type == type && signal.key == key) {
+            return &signal;
+        }
+    }
+    return nullptr;
+}
+
+uint64_t signalTotal(const GeneratorStats& stats) {
+    return std::accumulate(stats.signals.begin(), stats.signals.end(), uint64_t{0},
+                           [](uint64_t sum, const SignalStats& s) { return sum + s.frames; });
+}
+
+} // namespace
+
+TEST(StatsRecorderTest, CountsFramesPerLabelAndPgn) {
+    StatsRecorder recorder;
+    std::vector<Frame> frames;
+    for (int i = 0; i < 3; ++i) {
+        frames.push_back(ARINC429Message::encodeFrame(ARINC429Label::LATITUDE, 47.0f,
+                                                      ARINC429SSM::NORMAL_OPERATION, 0));
+    }
+    frames.push_back(ARINC429Message::encodeFrame(ARINC429Label::ALTITUDE, 35000.0f,
+                                                  ARINC429SSM::NORMAL_OPERATION, 0));
+    frames.push_back(CANJ1939Message::encodeFrame(CANJ1939PGN::ENGINE_SPEED, 1800.0f,
+                                                  CANJ1939Priority::PRIORITY_3, 0));
+    // PDU1: the same PGN addressed to two nodes counts once
+    frames.push_back(j1939Frame(0xEC00 | 0x21));
+    frames.push_back(j1939Frame(0xEC00 | 0xFF));
+    recorder.addFrames(frames.data(), frames.size());
+
+    GeneratorStats stats;
+    recorder.snapshot(stats);
+    EXPECT_EQ(stats.frames, frames.size());
+    EXPECT_EQ(signalTotal(stats), frames.size());
+    ASSERT_EQ(stats.signals.size(), 4u);
+
+    const SignalStats* latitude = findSignal(stats, MessageType::ARINC429,
+                                             static_cast<uint32_t>(ARINC429Label::LATITUDE));
+    ASSERT_NE(latitude, nullptr);
+    EXPECT_EQ(latitude->frames, 3u);
+    const SignalStats* tp_cm = findSignal(stats, MessageType::CANJ1939,
+                                          static_cast<uint32_t>(CANJ1939PGN::TP_CM));
+    ASSERT_NE(tp_cm, nullptr);
+    EXPECT_EQ(tp_cm->frames, 2u);
+
+    // Ordered by protocol, then key
+    EXPECT_EQ(stats.signals.front().type, MessageType::ARINC429);
+    EXPECT_EQ(stats.signals.back().type, MessageType::CANJ1939);
+}
+
+TEST(StatsRecorderTest, UnknownLabelsKeepTheirField) {
+    StatsRecorder recorder;
+    Frame frame;
+    frame.id = 0x7F;  // Label field outside the label database
+    frame.dlc = 4;
+    recorder.addFrames(&frame, 1);
+
+    GeneratorStats stats;
+    recorder.snapshot(stats);
+    ASSERT_EQ(stats.signals.size(), 1u);
+    EXPECT_EQ(stats.signals[0].key, 0x7Fu);
+}
+
+TEST(StatsRecorderTest, KeysBeyondTheTableCountTowardsTheTotal) {
+    StatsRecorder recorder;
+    std::vector<Frame> frames;
+    for (uint32_t i = 0; i < StatsRecorder::MAX_J1939_KEYS + 8; ++i) {
+        frames.push_back(j1939Frame(0xFF00 | i));  // PDU2, so every identifier is its own PGN
+    }
+    recorder.addFrames(frames.data(), frames.size());
+
+    GeneratorStats stats;
+    recorder.snapshot(stats);
+    EXPECT_EQ(stats.frames, frames.size());
+    EXPECT_EQ(stats.signals.size(), StatsRecorder::MAX_J1939_KEYS);
+    EXPECT_EQ(signalTotal(stats), StatsRecorder::MAX_J1939_KEYS);
+}
+
+TEST(StatsRecorderTest, TracksLateness) {
+    StatsRecorder recorder;
+    recorder.recordLateness(3us);
+    recorder.recordLateness(10us);
+    recorder.recordLateness(-2us);  // Early counts as on time
+    recorder.recordLateness(4us);
+
+    GeneratorStats stats;
+    recorder.snapshot(stats);
+    EXPECT_EQ(stats.last_lateness, 4us);
+    EXPECT_EQ(stats.max_lateness, 10us);
+    EXPECT_EQ(stats.total_lateness, 17us);
+}
+
+TEST(StatsRecorderTest, SnapshotsWhileRecording) {
+    StatsRecorder recorder;
+    const Frame frame = ARINC429Message::encodeFrame(ARINC429Label::ALTITUDE, 1000.0f,
+                                                     ARINC429SSM::NORMAL_OPERATION, 0);
+    constexpr uint64_t TICKS = 200000;
+    std::atomic<bool> done{false};
+    std::thread writer([&] {
+        for (uint64_t i = 0; i < TICKS; ++i) {
+            recorder.addFrames(&frame, 1);
+            recorder.addTick();
+        }
+        done = true;
+    });
+
+    uint64_t previous = 0;
+    GeneratorStats stats;
+    while (!done) {
+        recorder.snapshot(stats);
+        EXPECT_GE(stats.frames, previous);
+        previous = stats.frames;
+    }
+    writer.join();
+    recorder.snapshot(stats);
+    EXPECT_EQ(stats.frames, TICKS);
+    EXPECT_EQ(stats.ticks, TICKS);
+    EXPECT_EQ(signalTotal(stats), TICKS);
+}
+
+TEST(GeneratorStatsTest, VirtualRunMatchesDrainedFrames) {
+    ARINC429Generator generator;
+    generator.setSeed(1);
+    generator.setChannel(7);
+    generator.setClockMode(ClockMode::VIRTUAL);
+    generator.setVirtualDuration(1s);
+    generator.start();
+
+    std::vector<Frame> frames(4096);
+    uint64_t drained = 0;
+    while (generator.getState() == GeneratorState::RUNNING || generator.getQueuedFrames() > 0) {
+        drained += generator.drainFrames(frames.data(), frames.size());
+    }
+    generator.stop();
+
+    const GeneratorStats stats = generator.getStats();
+    EXPECT_EQ(stats.channel, 7u);
+    EXPECT_EQ(stats.frames, drained);
+    EXPECT_EQ(stats.ticks, generator.getTickCount());
+    EXPECT_EQ(stats.dropped_frames, 0u);
+    EXPECT_EQ(stats.encode_errors, 0u);
+    EXPECT_EQ(stats.queue_depth, 0u);
+    EXPECT_EQ(stats.queue_capacity, DataGenerator::DEFAULT_FRAME_BUFFER);
+    EXPECT_EQ(stats.max_lateness.count(), 0);  // Virtual ticks are never late
+    EXPECT_EQ(signalTotal(stats), drained);
+    EXPECT_NE(findSignal(stats, MessageType::ARINC429, static_cast<uint32_t>(ARINC429Label::LATITUDE)), nullptr);
+    EXPECT_TRUE(generator.getLastError().empty());
+}
+
+TEST(GeneratorStatsTest, RealtimeRunRecordsLatenessAndPgns) {
+    CANJ1939Generator generator;
+    generator.setRate(200);
+    generator.start();
+    std::this_thread::sleep_for(100ms);
+    const GeneratorStats running = generator.getStats();  // Read while the generator ticks
+    generator.stop();
+
+    EXPECT_GT(running.ticks, 0u);
+    const GeneratorStats stats = generator.getStats();
+    EXPECT_GE(stats.ticks, running.ticks);
+    EXPECT_GE(stats.max_lateness, stats.last_lateness);
+    EXPECT_GE(stats.total_lateness, stats.max_lateness);
+    EXPECT_EQ(signalTotal(stats), stats.frames);
+    EXPECT_NE(findSignal(stats, MessageType::CANJ1939, static_cast<uint32_t>(CANJ1939PGN::ENGINE_SPEED)), nullptr);
+}
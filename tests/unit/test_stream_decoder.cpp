@@ -0,0 +1,171 @@
+#include <gtest/gtest.h>
+#include "serial_bus_generator/decode/stream_decoder.hpp"
+#include "serial_bus_generator/protocols/arinc429/arinc429_generator.hpp"
+#include "serial_bus_generator/protocols/arinc429/arinc429_message.hpp"
+#include "serial_bus_generator/protocols/canj1939/canj1939_generator.hpp"
+#include "serial_bus_generator/protocols/canj1939/canj1939_message.hpp"
+#include <bitset>
+#include <chrono>
+#include <cmath>
+#include <random>
+
+using namespace serial_bus_generator;
+using namespace std::chrono_literals;
+
+namespace {
+
+class StreamDecoderTest : public ::testing::TestWithParam<ARINC429BatchCodec::Kernel> {
+protected:
+    void SetUp() override {
+        if (!ARINC429BatchCodec::isSupported(GetParam())) {
+            GTEST_SKIP() << "Kernel not supported on this CPU";
+        }
+    }
+
+    // Output of both generators over 30 seconds of simulated flight
+    static std::vector<Frame> generatedFrames() {
+        ARINC429Generator arinc;
+        CANJ1939Generator j1939;
+        arinc.setRate(100);
+        j1939.setRate(100);
+        FrameBatch batch;
+        for (int tick = 0; tick < 3000; ++tick) {
+            arinc.generateFrames(10ms, batch);
+            j1939.generateFrames(10ms, batch);
+        }
+        return std::vector<Frame>(batch.begin(), batch.end());
+    }
+};
+
+} // namespace
+
+TEST_P(StreamDecoderTest, MatchesMessageDecoding) {
+    const auto frames = generatedFrames();
+    ASSERT_GT(frames.size(), 2 * StreamDecoder::CHUNK) << "Should span several chunks";
+
+    StreamDecoder decoder(nullptr, GetParam());
+    std::vector<DecodedSample> samples(frames.size());
+    EXPECT_EQ(decoder.decode(frames.data(), frames.size(), samples.data()), 0u);
+
+    for (size_t i = 0; i < frames.size(); ++i) {
+        const Frame& frame = frames[i];
+        EXPECT_EQ(samples[i].timestamp_ns, frame.timestamp_ns);
+        EXPECT_EQ(samples[i].type, frame.type);
+        EXPECT_EQ(samples[i].status, DECODE_OK);
+        if (frame.type == MessageType::ARINC429) {
+            ARINC429Message msg(frame);
+            EXPECT_EQ(samples[i].key, static_cast<uint32_t>(msg.getLabel()));
+            EXPECT_EQ(samples[i].value, msg.getDecodedValue()) << "Frame " << i;
+        } else {
+            CANJ1939Message msg(frame);
+            EXPECT_EQ(samples[i].key, static_cast<uint32_t>(msg.getPGN()));
+            EXPECT_EQ(samples[i].value, msg.getDecodedValue()) << "Frame " << i;
+        }
+    }
+
+    const DecodeStats& stats = decoder.getStats();
+    EXPECT_EQ(stats.frames, frames.size());
+    EXPECT_EQ(stats.arinc429_words + stats.j1939_frames, frames.size());
+    EXPECT_GT(stats.arinc429_words, 0u);
+    EXPECT_GT(stats.j1939_frames, 0u);
+    EXPECT_EQ(stats.invalid, 0u);
+}
+
+TEST_P(StreamDecoderTest, FlagsInvalidFrames) {
+    std::vector<Frame> frames;
+    frames.push_back(ARINC429Message::encodeFrame(ARINC429Label::ALTITUDE, 1000.0f, ARINC429SSM::NORMAL_OPERATION, 1));
+
+    Frame bad_parity = frames[0];
+    bad_parity.id ^= 0x80000000;
+    frames.push_back(bad_parity);
+
+    Frame unknown_label = frames[0];
+    unknown_label.id = (unknown_label.id & ~0xFFu) | 0x01;
+    if (std::bitset<32>(unknown_label.id).count() % 2 == 0) {
+        unknown_label.id ^= 0x80000000;  // Keep odd parity
+    }
+    frames.push_back(unknown_label);
+
+    frames.push_back(ARINC429Message::encodeFrame(ARINC429Label::ALTITUDE, 1000.0f, ARINC429SSM::FUNCTIONAL_TEST, 2));
+
+    Frame unknown_pgn = CANJ1939Message::encodeFrame(CANJ1939PGN::ENGINE_SPEED, 800.0f,
+                                                     CANJ1939Priority::PRIORITY_3, 3);
+    unknown_pgn.id = (unknown_pgn.id & ~(0x3FFFFu << 8)) | (0xFF12u << 8);
+    frames.push_back(unknown_pgn);
+
+    Frame short_frame = CANJ1939Message::encodeFrame(CANJ1939PGN::ENGINE_SPEED, 800.0f,
+                                                     CANJ1939Priority::PRIORITY_3, 4);
+    short_frame.dlc = 2;
+    frames.push_back(short_frame);
+
+    StreamDecoder decoder(nullptr, GetParam());
+    std::vector<DecodedSample> samples(frames.size());
+    EXPECT_EQ(decoder.decode(frames.data(), frames.size(), samples.data()), 4u);
+
+    EXPECT_EQ(samples[0].status, DECODE_OK);
+    EXPECT_EQ(samples[1].status, DECODE_BAD_PARITY);
+    EXPECT_EQ(samples[1].value, samples[0].value) << "Parity errors still decode";
+    EXPECT_EQ(samples[2].status, DECODE_UNKNOWN_LABEL);
+    EXPECT_TRUE(std::isnan(samples[2].value));
+    EXPECT_EQ(samples[2].key, 0x01u);
+    EXPECT_EQ(samples[3].status, DECODE_SSM_NOT_NORMAL) << "SSM is reported but not invalid";
+    EXPECT_EQ(samples[4].status, DECODE_UNKNOWN_PGN);
+    EXPECT_EQ(samples[4].key, 0xFF12u);
+    EXPECT_TRUE(std::isnan(samples[4].value));
+    EXPECT_EQ(samples[5].status, DECODE_BAD_LENGTH);
+
+    const DecodeStats& stats = decoder.getStats();
+    EXPECT_EQ(stats.parity_errors, 1u);
+    EXPECT_EQ(stats.unknown_labels, 1u);
+    EXPECT_EQ(stats.ssm_not_normal, 1u);
+    EXPECT_EQ(stats.unknown_pgns, 1u);
+    EXPECT_EQ(stats.bad_lengths, 1u);
+    EXPECT_EQ(stats.invalid, 4u);
+
+    decoder.resetStats();
+    EXPECT_EQ(decoder.getStats().frames, 0u);
+}
+
+TEST_P(StreamDecoderTest, DecodesRawWords) {
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> dist(-100.0f, 30000.0f);
+    const ARINC429Label labels[] = {ARINC429Label::ALTITUDE, ARINC429Label::LATITUDE,
+                                    ARINC429Label::GPS_SATELLITE_STATUS, ARINC429Label::VERTICAL_SPEED};
+    std::vector<uint32_t> words;
+    for (int i = 0; i < 5000; ++i) {
+        words.push_back(ARINC429Message::encodeWord(labels[i % 4], dist(rng), ARINC429SSM::NORMAL_OPERATION));
+    }
+
+    StreamDecoder decoder(nullptr, GetParam());
+    std::vector<float> values(words.size());
+    std::vector<uint8_t> status(words.size());
+    EXPECT_EQ(decoder.decodeWords(words.data(), words.size(), values.data(), status.data()), 0u);
+    for (size_t i = 0; i < words.size(); ++i) {
+        EXPECT_EQ(status[i], DECODE_OK);
+        Frame frame;
+        frame.id = words[i];
+        frame.dlc = 4;
+        EXPECT_EQ(values[i], ARINC429Message(frame).getDecodedValue());
+    }
+    EXPECT_EQ(decoder.getStats().arinc429_words, words.size());
+}
+
+TEST_P(StreamDecoderTest, SinkHandsChunksToConsumer) {
+    const auto frames = generatedFrames();
+    size_t delivered = 0;
+    size_t largest = 0;
+    StreamDecoder decoder([&](const DecodedSample*, size_t count) {
+        delivered += count;
+        largest = std::max(largest, count);
+    }, GetParam());
+
+    decoder.write(frames.data(), frames.size());
+    EXPECT_EQ(delivered, frames.size());
+    EXPECT_LE(largest, StreamDecoder::CHUNK);
+    EXPECT_EQ(decoder.getStats().frames, frames.size());
+}
+
+INSTANTIATE_TEST_SUITE_P(Kernels, StreamDecoderTest,
+    ::testing::Values(ARINC429BatchCodec::Kernel::SCALAR,
+                      ARINC429BatchCodec::Kernel::SSE41,
+                      ARINC429BatchCodec::Kernel::AVX2));
@@ -0,0 +1,144 @@
+#include <gtest/gtest.h>
+#include "serial_bus_generator/sinks/text_sink.hpp"
+#include "serial_bus_generator/protocols/arinc429/arinc429_generator.hpp"
+#include "serial_bus_generator/protocols/canj1939/canj1939_generator.hpp"
+#include <cstdio>
+#include <iomanip>
+#include <random>
+#include <sstream>
+
+using namespace serial_bus_generator;
+using namespace std::chrono_literals;
+
+namespace {
+
+// The stream-based rendering toString() used to produce
+std::string streamText(const ARINC429Message& msg) {
+    std::stringstream ss;
+    const char* ssm[] = {"Normal", "No Data", "Test", "Failure"};
+    ss << "ARINC429 Message: Label=" << static_cast<int>(static_cast<uint8_t>(msg.getLabel()))
+       << " Value=" << std::fixed << std::setprecision(3) << msg.getDecodedValue()
+       << " SSM=" << ssm[static_cast<int>(msg.getSSM())];
+    return ss.str();
+}
+
+std::string streamText(const CANJ1939Message& msg) {
+    std::stringstream ss;
+    ss << "J1939 Message: PGN=0x" << std::hex << std::uppercase
+       << static_cast<uint32_t>(msg.getPGN())
+       << " Priority=" << static_cast<int>(msg.getPriority())
+       << " Value=" << std::fixed << std::setprecision(2) << msg.getDecodedValue();
+    return ss.str();
+}
+
+class CountingSink : public IFrameSink {
+public:
+    void write(const Frame*, size_t count) override { frames += count; }
+    void flush() override { ++flushes; }
+    size_t frames{0};
+    int flushes{0};
+};
+
+} // namespace
+
+TEST(TextBufferTest, RendersNumbers) {
+    TextBuffer text(4);  // Forces growth
+    text.append("v=");
+    text.appendInt(-42);
+    text.append(' ');
+    text.appendHex(0xfeee);
+    text.append(' ');
+    text.appendFixed(3.14159, 3);
+    text.append(' ');
+    text.appendFixed(1e300, 1);
+    EXPECT_EQ(text.str().substr(0, 20), "v=-42 FEEE 3.142 100");
+    EXPECT_EQ(text.size(), 17u + 301u + 2u);  // 1e300 has 301 integer digits
+
+    text.clear();
+    EXPECT_TRUE(text.empty());
+}
+
+TEST(TextBufferTest, MatchesStreamFormatting) {
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> degrees(-90.0f, 90.0f);
+    std::uniform_real_distribution<float> rpm(0.0f, 8000.0f);
+    for (int i = 0; i < 1000; ++i) {
+        ARINC429Message arinc(ARINC429Label::LATITUDE, degrees(rng),
+                              static_cast<ARINC429SSM>(i % 4));
+        EXPECT_EQ(arinc.toString(), streamText(arinc));
+
+        CANJ1939Message j1939(CANJ1939PGN::ENGINE_SPEED, rpm(rng),
+                              static_cast<CANJ1939Priority>(i % 8));
+        EXPECT_EQ(j1939.toString(), streamText(j1939));
+    }
+}
+
+TEST(TextSinkTest, WritesOneLinePerFrame) {
+    std::FILE* file = std::tmpfile();
+    ASSERT_NE(file, nullptr);
+
+    ARINC429Message arinc(ARINC429Label::ALTITUDE, 35000.0f, ARINC429SSM::NORMAL_OPERATION);
+    CANJ1939Message j1939(CANJ1939PGN::ENGINE_TEMPERATURE, 90.0f, CANJ1939Priority::PRIORITY_3);
+    const Frame frames[] = {arinc.toFrame(), j1939.toFrame()};
+    {
+        TextSink sink(file);
+        sink.write(frames, 2);
+    }  // Flushed on destruction
+
+    std::rewind(file);
+    char buffer[256] = {};
+    size_t length = std::fread(buffer, 1, sizeof(buffer) - 1, file);
+    std::fclose(file);
+
+    EXPECT_EQ(std::string(buffer, length),
+              "[ARINC429] " + arinc.toString() + "\n[CANJ1939] " + j1939.toString() + "\n");
+}
+
+TEST(TextSinkTest, ShowsTruncatedJ1939FramesRaw) {
+    std::FILE* file = std::tmpfile();
+    ASSERT_NE(file, nullptr);
+
+    Frame frame = CANJ1939Message(CANJ1939PGN::ENGINE_SPEED, 750.0f, CANJ1939Priority::PRIORITY_3).toFrame();
+    frame.dlc = 4;
+    {
+        TextSink sink(file);
+        sink.write(&frame, 1);
+    }
+
+    std::rewind(file);
+    char buffer[256] = {};
+    size_t length = std::fread(buffer, 1, sizeof(buffer) - 1, file);
+    std::fclose(file);
+
+    EXPECT_EQ(std::string(buffer, length), "[CANJ1939] Malformed frame: ID=0xCF004FE DLC=4\n");
+}
+
+TEST(TextSinkTest, GeneratorFeedsAttachedSinks) {
+    CANJ1939Generator generator;
+    auto sink = std::make_shared<CountingSink>();
+    generator.addSink(sink);
+
+    generator.setClockMode(ClockMode::VIRTUAL);
+    generator.setVirtualDuration(1s);
+    generator.start();
+    while (generator.getState() == GeneratorState::RUNNING) {
+        std::this_thread::sleep_for(1ms);
+    }
+    generator.stop();
+
+    // Every frame also reaches the ring; ENGINE_SPEED alone is 100 per second
+    EXPECT_EQ(sink->frames, generator.getQueuedFrames());
+    EXPECT_GE(sink->frames, 100u);
+    EXPECT_EQ(sink->flushes, 1);
+    EXPECT_THROW(generator.addSink(nullptr), std::invalid_argument);
+}
+
+TEST(TextSinkTest, SinksCannotChangeWhileRunning) {
+    CANJ1939Generator generator;
+    generator.setRate(100);
+    generator.start();  // Real time, so it runs until stopped
+    EXPECT_THROW(generator.addSink(std::make_shared<CountingSink>()), std::logic_error);
+    EXPECT_THROW(generator.clearSinks(), std::logic_error);
+    generator.stop();
+    EXPECT_NO_THROW(generator.addSink(std::make_shared<CountingSink>()));
+}
@@ -0,0 +1,122 @@
+#include <gtest/gtest.h>
+#include "serial_bus_generator/trace/tracer.hpp"
+#include "serial_bus_generator/protocols/arinc429/arinc429_generator.hpp"
+#include <sstream>
+#include <thread>
+
+using namespace serial_bus_generator;
+using namespace std::chrono_literals;
+
+namespace {
+
+size_t countOf(const std::string& text, const std::string& needle) {
+    size_t count = 0;
+    for (size_t at = text.find(needle); at != std::string::npos; at = text.find(needle, at + 1)) {
+        ++count;
+    }
+    return count;
+}
+
+std::string dump() {
+    std::ostringstream out;
+    Tracer::writeChromeJson(out);
+    return out.str();
+}
+
+class TracerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        Tracer::clear();
+        Tracer::setEnabled(true);
+    }
+
+    void TearDown() override {
+        Tracer::setEnabled(false);
+        Tracer::clear();
+    }
+};
+
+} // namespace
+
+TEST_F(TracerTest, WritesChromeTraceEvents) {
+    {
+        TraceScope scope("encode", 4);
+        std::this_thread::sleep_for(1ms);
+    }
+    Tracer::recordInstant("phase", 4, "CRUISE", Tracer::NO_VALUE);
+    Tracer::recordInstant("wakeup", Tracer::NO_CHANNEL, nullptr, 1500);
+    EXPECT_EQ(Tracer::getEventCount(), 3u);
+
+    const std::string text = dump();
+    EXPECT_EQ(text.rfind("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[", 0), 0u);
+    EXPECT_NE(text.find("\"name\":\"encode\",\"cat\":\"sbg\",\"ph\":\"X\""), std::string::npos);
+    EXPECT_NE(text.find("\"args\":{\"channel\":4}}"), std::string::npos);
+    EXPECT_NE(text.find("\"ph\":\"i\",\"s\":\"t\""), std::string::npos);
+    EXPECT_NE(text.find("\"args\":{\"channel\":4,\"detail\":\"CRUISE\"}}"), std::string::npos);
+    EXPECT_NE(text.find("\"args\":{\"value\":1500}}"), std::string::npos);
+    EXPECT_EQ(countOf(text, "\"ph\":\"M\""), 1u);  // One thread
+
+    // The scope lasted at least the sleep: "dur":1000.000 or more microseconds
+    const size_t at = text.find("\"dur\":");
+    ASSERT_NE(at, std::string::npos);
+    EXPECT_GE(std::stod(text.substr(at + 6)), 1000.0);
+}
+
+TEST_F(TracerTest, RecordsNothingWhileDisabled) {
+    Tracer::setEnabled(false);
+    {
+        TraceScope scope("encode", 0);
+    }
+    EXPECT_EQ(Tracer::getEventCount(), 0u);
+    EXPECT_EQ(dump(), "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n]}\n");
+}
+
+TEST_F(TracerTest, ThreadsRecordIntoTheirOwnRings) {
+    Tracer::setEventsPerThread(8);
+    std::thread first([] {
+        for (int i = 0; i < 20; ++i) {
+            Tracer::recordInstant("first", 1, nullptr, i);
+        }
+    });
+    std::thread second([] {
+        Tracer::recordInstant("second", 2, nullptr, Tracer::NO_VALUE);
+    });
+    first.join();
+    second.join();
+    Tracer::setEventsPerThread(Tracer::DEFAULT_EVENTS_PER_THREAD);
+
+    // The oldest events of a full ring are overwritten
+    EXPECT_EQ(Tracer::getEventCount(), 9u);
+    EXPECT_EQ(Tracer::getOverwrittenEvents(), 12u);
+    const std::string text = dump();
+    EXPECT_EQ(countOf(text, "\"name\":\"first\""), 8u);
+    EXPECT_EQ(text.find("\"value\":11}"), std::string::npos);
+    EXPECT_NE(text.find("\"value\":12}"), std::string::npos);
+    EXPECT_EQ(countOf(text, "\"name\":\"second\""), 1u);
+    EXPECT_EQ(countOf(text, "\"ph\":\"M\""), 2u);
+}
+
+TEST_F(TracerTest, TracesTheGenerationPipeline) {
+    ARINC429Generator generator;
+    generator.setRate(200);
+    generator.start();
+    std::this_thread::sleep_for(50ms);
+    generator.stop();
+    Tracer::setEnabled(false);
+
+    const std::string text = dump();
+    if (Tracer::COMPILED_IN) {
+        EXPECT_GT(countOf(text, "\"name\":\"tick\""), 0u);
+        EXPECT_GT(countOf(text, "\"name\":\"wait\""), 0u);
+        EXPECT_GT(countOf(text, "\"name\":\"flight state\""), 0u);
+        EXPECT_GT(countOf(text, "\"name\":\"encode\""), 0u);
+        EXPECT_GT(countOf(text, "\"name\":\"publish\""), 0u);
+    } else {
+        EXPECT_EQ(Tracer::getEventCount(), 0u);  // Instrumentation compiled out
+    }
+}
+
+TEST(TracerFileTest, RejectsUnwritablePaths) {
+    EXPECT_THROW(Tracer::writeChromeJson("/nonexistent/dir/trace.json"), std::runtime_error);
+    EXPECT_THROW(Tracer::setEventsPerThread(0), std::invalid_argument);
+}
@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+#include "serial_bus_generator/core/transmit_schedule.hpp"
+#include "serial_bus_generator/core/timing_wheel.hpp"
+#include <map>
+#include <chrono>
+
+using namespace serial_bus_generator;
+using namespace std::chrono_literals;
+
+class TransmitScheduleTest : public ::testing::Test {
+protected:
+    std::map<uint32_t, int> run(std::chrono::milliseconds total, std::chrono::milliseconds step) {
+        std::map<uint32_t, int> counts;
+        for (auto t = 0ms; t < total; t += step) {
+            for (uint32_t key : schedule.advance(t == 0ms ? 0ms : step)) {
+                counts[key]++;
+            }
+        }
+        return counts;
+    }
+
+    TransmitSchedule schedule;
+};
+
+TEST_F(TransmitScheduleTest, IndependentRates) {
+    schedule.addEntry(310, 200ms);        // 5 Hz
+    schedule.addEntry(270, 1000ms, 20ms); // 1 Hz
+    schedule.addEntry(203, 10ms, 3ms);    // 100 Hz
+
+    auto counts = run(10s, 1ms);
+    EXPECT_EQ(counts[310], 50);
+    EXPECT_EQ(counts[270], 10);
+    EXPECT_EQ(counts[203], 1000);
+}
+
+TEST_F(TransmitScheduleTest, PhaseOffset) {
+    schedule.addEntry(1, 100ms, 30ms);
+
+    EXPECT_TRUE(schedule.advance(29ms).empty());
+    ASSERT_EQ(schedule.advance(1ms).size(), 1u);
+    EXPECT_TRUE(schedule.advance(99ms).empty());
+    EXPECT_EQ(schedule.advance(1ms).size(), 1u);
+}
+
+TEST_F(TransmitScheduleTest, CoalescesWithinOneStep) {
+    schedule.addEntry(1, 10ms);
+
+    // Ten deadlines fall inside one second-long step but the signal is sent once
+    EXPECT_EQ(schedule.advance(1000ms).size(), 1u);
+    EXPECT_EQ(schedule.advance(10ms).size(), 1u);
+}
+
+TEST_F(TransmitScheduleTest, ManySignals) {
+    for (uint32_t key = 0; key < 500; ++key) {
+        schedule.addEntry(key, std::chrono::milliseconds(10 + key), std::chrono::milliseconds(key % 7));
+    }
+
+    auto counts = run(60s, 5ms);
+    for (uint32_t key = 0; key < 500; ++key) {
+        const auto period = 10 + key;
+        // Phases are below the 5ms step so the expected count is exact
+        const int expected = static_cast<int>((60000 - 5 - (key % 7)) / period + 1);
+        EXPECT_NEAR(counts[key], expected, 1) << "key " << key;
+    }
+}
+
+TEST_F(TransmitScheduleTest, ResetRestartsTimeline) {
+    schedule.addEntry(1, 100ms);
+    EXPECT_EQ(schedule.advance(0ms).size(), 1u);
+    EXPECT_TRUE(schedule.advance(50ms).empty());
+
+    schedule.reset();
+    EXPECT_EQ(schedule.now(), 0ms);
+    EXPECT_EQ(schedule.advance(0ms).size(), 1u);
+}
+
+TEST_F(TransmitScheduleTest, DisabledEntriesKeepTheirPhase) {
+    schedule.addEntry(1, 100ms, 30ms);
+    schedule.setEnabled(0, false);
+    EXPECT_FALSE(schedule.isEnabled(0));
+    EXPECT_TRUE(schedule.advance(30ms).empty());
+    EXPECT_TRUE(schedule.advance(100ms).empty());
+
+    schedule.setEnabled(0, true);
+    EXPECT_TRUE(schedule.advance(99ms).empty());
+    EXPECT_EQ(schedule.advance(1ms).size(), 1u);  // Back on the 30ms + n*100ms grid
+    EXPECT_THROW(schedule.setEnabled(1, true), std::invalid_argument);
+}
+
+TEST(TimingWheelTest, CascadesDistantTimers) {
+    TimingWheel wheel;
+    const uint64_t expiries[] = {5, 64, 100, 4095, 4096, 300000, (uint64_t{1} << 24) + 17};
+    for (uint32_t id = 0; id < 7; ++id) {
+        wheel.schedule(id, expiries[id]);
+    }
+
+    std::vector<uint64_t> fired;
+    wheel.advanceTo((uint64_t{1} << 24) + 100, [&](uint32_t id, uint64_t expiry) {
+        EXPECT_EQ(expiry, expiries[id]);
+        EXPECT_EQ(wheel.now(), expiry + 1);
+        fired.push_back(expiry);
+    });
+
+    EXPECT_EQ(fired, std::vector<uint64_t>(std::begin(expiries), std::end(expiries)));
+    EXPECT_EQ(wheel.pending(), 0u);
+}
+
+TEST(TimingWheelTest, RejectsDoubleArm) {
+    TimingWheel wheel;
+    wheel.schedule(0, 10);
+    EXPECT_THROW(wheel.schedule(0, 20), std::logic_error);
+}
\ No newline at end of file